@@ -209,6 +209,33 @@ class TestEthereumTransactionSigner {
         assertEquals(Numeric.toHexString(output.s.toByteArray()), "0x2c56a0b70ff2e52bf374a3dcd404bc42317d5ca15d319f5e33665352eb48f06f")
     }
 
+    @Test
+    fun testEthereumSignDirect() {
+        // Larger than the initial direct buffers, so both of them have to grow
+        val payload = ByteArray(200 * 1024) { it.toByte() }
+        val signingInput = Ethereum.SigningInput.newBuilder()
+        signingInput.apply {
+            privateKey = ByteString.copyFrom(PrivateKey("0x4646464646464646464646464646464646464646464646464646464646464646".toHexByteArray()).data())
+            toAddress = "0x3535353535353535353535353535353535353535"
+            chainId = ByteString.copyFrom("0x1".toHexByteArray())
+            nonce = ByteString.copyFrom("0x9".toHexByteArray())
+            gasPrice = ByteString.copyFrom("0x04a817c800".toHexByteArray())
+            gasLimit = ByteString.copyFrom("0x5208".toHexByteArray())
+            transaction = Ethereum.Transaction.newBuilder().apply {
+                contractGeneric = Ethereum.Transaction.ContractGeneric.newBuilder().apply {
+                    amount = ByteString.copyFrom("0x00".toHexByteArray())
+                    data = ByteString.copyFrom(payload)
+                }.build()
+            }.build()
+        }
+
+        val expected = AnySigner.sign(signingInput.build(), ETHEREUM, SigningOutput.parser())
+        val output = AnySigner.signDirect(signingInput.build(), ETHEREUM, SigningOutput.parser())
+
+        assertEquals(expected, output)
+        assertEquals(expected, AnySigner.signDirect(signingInput.build(), ETHEREUM, SigningOutput.parser()))
+    }
+
     @Test
     fun testSignJSON() {
         val json = """
@@ -29,14 +29,28 @@ option(TW_ENABLE_PVS_STUDIO "Enable static analysis with PVS-Studio." OFF)
 #
 # Runtime analyzers
 #
-# Currently supporting: Clang ASAN.
+# Currently supporting: Clang ASAN, Clang TSAN.
 option(TW_CLANG_ASAN "Enable ASAN dynamic address sanitizer" OFF)
+option(TW_CLANG_TSAN "Enable TSAN dynamic thread sanitizer" OFF)
 
 #
 # Specific platforms support
 #
 # Currently supporting: Wasm.
 option(TW_COMPILE_WASM "Target Wasm" OFF)
+option(TW_WASM_SIMD "Compile Wasm with SIMD128 instructions, letting hashing and crypto loops be vectorized" OFF)
+option(TW_WASM_THREADS "Compile Wasm with pthreads, running the batch APIs on a pool of web workers" OFF)
+set(TW_WASM_THREAD_POOL_SIZE 4 CACHE STRING "Number of web workers started with the Wasm module when TW_WASM_THREADS is ON")
+
+# Every object linked into the module must agree on these, so they apply to all targets.
+if (TW_COMPILE_WASM AND TW_WASM_SIMD)
+    add_compile_options(-msimd128)
+endif ()
+if (TW_COMPILE_WASM AND TW_WASM_THREADS)
+    add_compile_options(-pthread)
+    add_link_options(-pthread)
+    add_compile_definitions(TW_WASM_THREAD_POOL_SIZE=${TW_WASM_THREAD_POOL_SIZE})
+endif ()
 
 #
 # Coverage
@@ -53,6 +53,13 @@ bool TWAnyAddressIsValidBech32(TWString* _Nonnull string, enum TWCoinType coin,
 TW_EXPORT_STATIC_METHOD
 bool TWAnyAddressIsValidSS58(TWString* _Nonnull string, enum TWCoinType coin, uint32_t ss58Prefix);
 
+/// Finds the coins the string is a valid address for, e.g. to tell which blockchain a pasted address belongs to.
+///
+/// \param string address to classify.
+/// \return Non-null data, the coin types in increasing order, each as a 4-byte little-endian value; empty if the address is not valid for any coin.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWAnyAddressDetectCoins(TWString* _Nonnull string);
+
 /// Creates an address from a string representation and a coin type. Must be deleted with TWAnyAddressDelete after use.
 ///
 /// \param string address to create.
@@ -6,6 +6,7 @@
 #include "TWBase.h"
 #include "TWCoinType.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWString.h"
 
 TW_EXTERN_C_BEGIN
@@ -20,6 +21,30 @@ struct TWAnySigner;
 /// \return The serialized data of a `SigningOutput` proto object. (e.g. TW.Bitcoin.Proto.SigningOutput).
 extern TWData *_Nonnull TWAnySignerSign(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Signs many transactions of the same coin type in parallel.
+///
+/// Inputs are signed on a shared pool of worker threads, see \TWAnySignerSetBatchConcurrency.
+/// \param inputs The serialized data of the signing inputs (e.g. TW.Bitcoin.Proto.SigningInput).
+/// \param coin The given coin type to sign the transactions for.
+/// \note Returned vector must be deleted with \TWDataVectorDelete
+/// \return The serialized `SigningOutput` proto objects, in the order of the inputs.
+/// Each output carries its own error, an empty output means the input could not be signed at all.
+extern struct TWDataVector *_Nonnull TWAnySignerSignBatch(const struct TWDataVector *_Nonnull inputs, enum TWCoinType coin);
+
+/// Signs many transactions of possibly different coin types in parallel.
+///
+/// \param inputs The serialized data of the signing inputs.
+/// \param coins The coin type of every input, must hold as many items as `inputs`.
+/// \note Returned vector must be deleted with \TWDataVectorDelete
+/// \return The serialized `SigningOutput` proto objects, in the order of the inputs.
+/// Each output carries its own error, an empty output means the input could not be signed at all.
+extern struct TWDataVector *_Nonnull TWAnySignerSignBatchCoins(const struct TWDataVector *_Nonnull inputs, const enum TWCoinType *_Nonnull coins);
+
+/// Sets the number of worker threads used by the batch signing functions.
+///
+/// \param threads The number of worker threads, 0 means the number of hardware threads (the default).
+extern void TWAnySignerSetBatchConcurrency(size_t threads);
+
 /// Signs a transaction specified by the JSON representation of signing input, coin type and a private key, returning the JSON representation of the signing output.
 ///
 /// \param json JSON representation of a signing input
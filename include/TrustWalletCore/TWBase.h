@@ -2,6 +2,18 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+// Thread safety
+//
+// The library keeps no mutable global state: coin entries, the coin registry and the curve tables are
+// immutable once initialized, and random bytes come from a per-thread ChaCha20 DRBG, seeded from the
+// operating system and reseeded every 1024 generate calls and after fork().
+// Therefore:
+// - static methods and free functions (e.g. TWAnySignerSign, TWAnyAddressIsValid, TWMnemonicIsValid)
+//   may be called from any number of threads at once;
+// - an object may be read from several threads at once, as long as no thread modifies or deletes it;
+// - methods that modify an object (setters, Add*, Remove*, Update*, Delete) need exclusive access
+//   to that object. Distinct objects may be used from different threads without synchronization.
+
 #if !defined(TW_EXTERN_C_BEGIN)
 #if defined(__cplusplus)
 #define TW_EXTERN_C_BEGIN extern "C" {
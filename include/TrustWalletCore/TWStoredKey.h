@@ -17,6 +17,8 @@
 TW_EXTERN_C_BEGIN
 
 /// Represents a key stored as an encrypted file.
+/// Adding, removing or updating accounts modifies the key: such calls must not run concurrently
+/// with any other call on the same object.
 TW_EXPORT_CLASS
 struct TWStoredKey;
 
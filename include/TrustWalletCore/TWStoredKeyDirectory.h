@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWStoredKey.h"
+#include "TWString.h"
+
+TW_EXTERN_C_BEGIN
+
+/// A directory of key files, indexed by key identifier and account address.
+///
+/// Only the identifier, name and account addresses of every key are kept in memory, and an index of them is
+/// kept in the directory, so opening it again only parses the key files that changed since. Keys are loaded
+/// from their files on demand. Files whose name starts with a dot are ignored.
+/// A directory may be used from several threads at once.
+TW_EXPORT_CLASS
+struct TWStoredKeyDirectory;
+
+/// Opens a directory of key files, creating it if needed.
+///
+/// \param path Non-null path of the directory
+/// \note Returned object needs to be deleted with \TWStoredKeyDirectoryDelete
+/// \return Nullptr if the directory can't be created or read, the directory otherwise
+TW_EXPORT_STATIC_METHOD
+struct TWStoredKeyDirectory* _Nullable TWStoredKeyDirectoryCreate(TWString* _Nonnull path);
+
+/// Deletes a directory object; the files are kept.
+///
+/// \param directory Non-null pointer to a directory
+TW_EXPORT_METHOD
+void TWStoredKeyDirectoryDelete(struct TWStoredKeyDirectory* _Nonnull directory);
+
+/// Re-indexes the key files that were added, changed or removed since the last scan, e.g. by another process.
+///
+/// \param directory Non-null pointer to a directory
+/// \return true if any file was added, changed or removed.
+TW_EXPORT_METHOD
+bool TWStoredKeyDirectoryRefresh(struct TWStoredKeyDirectory* _Nonnull directory);
+
+/// Number of keys in the directory.
+///
+/// \param directory Non-null pointer to a directory
+/// \return the number of keys
+TW_EXPORT_PROPERTY
+size_t TWStoredKeyDirectoryKeyCount(struct TWStoredKeyDirectory* _Nonnull directory);
+
+/// Identifier of the key at the given index, keys being sorted by identifier.
+///
+/// \param directory Non-null pointer to a directory
+/// \param index index of the key
+/// \note Returned object needs to be deleted with \TWStringDelete
+/// \return Null pointer if the index is out of range, the key identifier otherwise.
+TW_EXPORT_METHOD
+TWString* _Nullable TWStoredKeyDirectoryIdentifier(struct TWStoredKeyDirectory* _Nonnull directory, size_t index);
+
+/// Name of a key, read from the index.
+///
+/// \param directory Non-null pointer to a directory
+/// \param identifier Non-null key identifier
+/// \note Returned object needs to be deleted with \TWStringDelete
+/// \return Null pointer if there is no such key, the key name otherwise.
+TW_EXPORT_METHOD
+TWString* _Nullable TWStoredKeyDirectoryName(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier);
+
+/// Finds the key that has an account for the given coin and address.
+///
+/// \param directory Non-null pointer to a directory
+/// \param coin coin type of the account
+/// \param address Non-null address of the account
+/// \note Returned object needs to be deleted with \TWStringDelete
+/// \return Null pointer if no key has such an account, the key identifier otherwise.
+TW_EXPORT_METHOD
+TWString* _Nullable TWStoredKeyDirectoryFindKey(struct TWStoredKeyDirectory* _Nonnull directory, enum TWCoinType coin, TWString* _Nonnull address);
+
+/// Loads a key from its file.
+///
+/// \param directory Non-null pointer to a directory
+/// \param identifier Non-null key identifier
+/// \note Returned object needs to be deleted with \TWStoredKeyDelete
+/// \return Null pointer if there is no such key or it can't be loaded, the stored key otherwise.
+TW_EXPORT_METHOD
+struct TWStoredKey* _Nullable TWStoredKeyDirectoryLoad(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier);
+
+/// Stores a key in the directory, replacing the file of the key with the same identifier, if any.
+///
+/// \param directory Non-null pointer to a directory
+/// \param key Non-null pointer to a stored key
+/// \return false if the key has no identifier or it can't be stored, true otherwise.
+TW_EXPORT_METHOD
+bool TWStoredKeyDirectoryStore(struct TWStoredKeyDirectory* _Nonnull directory, struct TWStoredKey* _Nonnull key);
+
+/// Deletes the file of a key.
+///
+/// \param directory Non-null pointer to a directory
+/// \param identifier Non-null key identifier
+/// \return false if there is no such key or its file can't be deleted, true otherwise.
+TW_EXPORT_METHOD
+bool TWStoredKeyDirectoryRemove(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier);
+
+TW_EXTERN_C_END
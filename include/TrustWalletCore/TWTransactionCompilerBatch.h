@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+#include "TWDataVector.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Many transactions of one coin, kept between the pre-image hashing and the compiling phases of an external signing flow.
+///
+/// The signing inputs are prepared once, so compiling does not repeat the work done while obtaining the pre-image hashes
+/// (e.g. UTXO selection). Both phases process all the transactions in parallel.
+/// Every method may update the prepared inputs, so a batch must not be used from several threads at once.
+TW_EXPORT_CLASS
+struct TWTransactionCompilerBatch;
+
+/// Creates a batch of transactions to be signed externally.
+///
+/// \param coinType coin type of all the transactions.
+/// \param txInputs The serialized data of the signing inputs.
+/// \note Must be deleted with \TWTransactionCompilerBatchDelete
+/// \return A new batch.
+TW_EXPORT_STATIC_METHOD
+struct TWTransactionCompilerBatch* _Nonnull TWTransactionCompilerBatchCreate(enum TWCoinType coinType, const struct TWDataVector* _Nonnull txInputs);
+
+/// Deletes a batch.
+///
+/// \param batch A non-null batch.
+TW_EXPORT_METHOD
+void TWTransactionCompilerBatchDelete(struct TWTransactionCompilerBatch* _Nonnull batch);
+
+/// Returns the number of transactions in the batch.
+///
+/// \param batch A non-null batch.
+/// \return the number of transactions.
+TW_EXPORT_PROPERTY
+size_t TWTransactionCompilerBatchSize(struct TWTransactionCompilerBatch* _Nonnull batch);
+
+/// Obtains pre-signing hashes of all the transactions.
+///
+/// \param batch A non-null batch.
+/// \note Returned vector must be deleted with \TWDataVectorDelete
+/// \return serialized `PreSigningOutput` proto objects, in the order of the inputs.
+/// An empty item means the pre-signing hashes of its input could not be obtained at all.
+TW_EXPORT_METHOD
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchPreImageHashes(struct TWTransactionCompilerBatch* _Nonnull batch);
+
+/// Sets the external signatures and public keys of one transaction.
+///
+/// The signatures must match the hashes returned by \TWTransactionCompilerBatchPreImageHashes for this transaction, in the same order.
+/// \param batch A non-null batch.
+/// \param index index of the transaction, in the order of the inputs.
+/// \param signatures signatures to compile the transaction with.
+/// \param publicKeys public keys for signers to match private keys.
+/// \return false if the index is out of range.
+TW_EXPORT_METHOD
+bool TWTransactionCompilerBatchSetSignatures(struct TWTransactionCompilerBatch* _Nonnull batch, size_t index,
+                                             const struct TWDataVector* _Nonnull signatures, const struct TWDataVector* _Nonnull publicKeys);
+
+/// Compiles all the transactions with the signatures set by \TWTransactionCompilerBatchSetSignatures.
+///
+/// \param batch A non-null batch.
+/// \note Returned vector must be deleted with \TWDataVectorDelete
+/// \return serialized `SigningOutput` proto objects, in the order of the inputs.
+/// An empty item means the transaction could not be compiled at all.
+TW_EXPORT_METHOD
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchCompile(struct TWTransactionCompilerBatch* _Nonnull batch);
+
+TW_EXTERN_C_END
@@ -41,3 +41,29 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativePlan(JNIEnv *env, jclas
     TWDataDelete(inputData);
     return resultData;
 }
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin) {
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, input, "input");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, output, "output");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, pending, "pending");
+    TWData *inputData = TWDataCreateWithJDirectBuffer(env, input, inputSize);
+    if (inputData == NULL) {
+        return 0;
+    }
+    TWData *outputData = TWAnySignerSign(inputData, coin);
+    TWDataDelete(inputData);
+    return TWDataCopyToJDirectBuffer(outputData, env, output, pending);
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativePlanDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin) {
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, input, "input");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, output, "output");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, pending, "pending");
+    TWData *inputData = TWDataCreateWithJDirectBuffer(env, input, inputSize);
+    if (inputData == NULL) {
+        return 0;
+    }
+    TWData *outputData = TWAnySignerPlan(inputData, coin);
+    TWDataDelete(inputData);
+    return TWDataCopyToJDirectBuffer(outputData, env, output, pending);
+}
@@ -22,6 +22,12 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_signJSON(JNIEnv *env, jclass
 JNIEXPORT
 jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativePlan(JNIEnv *env, jclass thisClass, jbyteArray input, jint coin);
 
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin);
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_AnySigner_nativePlanDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin);
+
 TW_EXTERN_C_END
 
 #endif // JNI_TW_ANYSIGNER_H
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <jni.h>
+
+#include "DirectBuffers.h"
+#include "TWJNI.h"
+
+jint JNICALL Java_wallet_core_java_DirectBuffers_nativeTakeOutput(JNIEnv *env, jclass thisClass, jlong handle, jobject output) {
+    TWData *data = (TWData *) handle;
+    if (output == NULL) {
+        TWDataDelete(data);
+    }
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, output, "output");
+    return TWDataCopyToJDirectBuffer(data, env, output, NULL);
+}
+
+void JNICALL Java_wallet_core_java_DirectBuffers_nativeDeleteOutput(JNIEnv *env, jclass thisClass, jlong handle) {
+    TWDataDelete((TWData *) handle);
+}
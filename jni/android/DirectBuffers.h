@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#ifndef JNI_TW_DIRECTBUFFERS_H
+#define JNI_TW_DIRECTBUFFERS_H
+
+#include <jni.h>
+#include <TrustWalletCore/TWBase.h>
+
+TW_EXTERN_C_BEGIN
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_DirectBuffers_nativeTakeOutput(JNIEnv *env, jclass thisClass, jlong handle, jobject output);
+
+JNIEXPORT
+void JNICALL Java_wallet_core_java_DirectBuffers_nativeDeleteOutput(JNIEnv *env, jclass thisClass, jlong handle);
+
+TW_EXTERN_C_END
+
+#endif // JNI_TW_DIRECTBUFFERS_H
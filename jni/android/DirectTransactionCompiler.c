@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <jni.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <TrustWalletCore/TWDataVector.h>
+#include <TrustWalletCore/TWTransactionCompiler.h>
+
+#include "DirectTransactionCompiler.h"
+#include "TWJNI.h"
+
+static struct TWDataVector *dataVectorInstance(JNIEnv *env, jobject dataVector) {
+    jclass dataVectorClass = (*env)->GetObjectClass(env, dataVector);
+    jfieldID handleFieldID = (*env)->GetFieldID(env, dataVectorClass, "nativeHandle", "J");
+    return (struct TWDataVector *) (*env)->GetLongField(env, dataVector, handleFieldID);
+}
+
+jint JNICALL Java_wallet_core_java_DirectTransactionCompiler_nativePreImageHashes(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin) {
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, input, "input");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, output, "output");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, pending, "pending");
+    TWData *inputData = TWDataCreateWithJDirectBuffer(env, input, inputSize);
+    if (inputData == NULL) {
+        return 0;
+    }
+    TWData *outputData = TWTransactionCompilerPreImageHashes(coin, inputData);
+    TWDataDelete(inputData);
+    return TWDataCopyToJDirectBuffer(outputData, env, output, pending);
+}
+
+jint JNICALL Java_wallet_core_java_DirectTransactionCompiler_nativeCompileWithSignatures(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin, jobject signatures, jobject publicKeys) {
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, input, "input");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, output, "output");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, pending, "pending");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, signatures, "signatures");
+    JNI_CHECK_NULL_AND_RETURN_ZERO(env, publicKeys, "publicKeys");
+    TWData *inputData = TWDataCreateWithJDirectBuffer(env, input, inputSize);
+    if (inputData == NULL) {
+        return 0;
+    }
+    TWData *outputData = TWTransactionCompilerCompileWithSignatures(coin, inputData, dataVectorInstance(env, signatures), dataVectorInstance(env, publicKeys));
+    TWDataDelete(inputData);
+    return TWDataCopyToJDirectBuffer(outputData, env, output, pending);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#ifndef JNI_TW_DIRECTTRANSACTIONCOMPILER_H
+#define JNI_TW_DIRECTTRANSACTIONCOMPILER_H
+
+#include <jni.h>
+#include <TrustWalletCore/TWBase.h>
+
+TW_EXTERN_C_BEGIN
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_DirectTransactionCompiler_nativePreImageHashes(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin);
+
+JNIEXPORT
+jint JNICALL Java_wallet_core_java_DirectTransactionCompiler_nativeCompileWithSignatures(JNIEnv *env, jclass thisClass, jobject input, jint inputSize, jobject output, jlongArray pending, jint coin, jobject signatures, jobject publicKeys);
+
+TW_EXTERN_C_END
+
+#endif // JNI_TW_DIRECTTRANSACTIONCOMPILER_H
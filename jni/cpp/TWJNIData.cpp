@@ -3,10 +3,18 @@
 // Copyright © 2017 Trust Wallet.
 
 #include <assert.h>
+#include <string.h>
 #include <vector>
 
 #include "TWJNIData.h"
 
+static void throwIllegalArgument(JNIEnv *env, const char *message) {
+    jclass exceptionClass = env->FindClass("java/lang/IllegalArgumentException");
+    if (exceptionClass != nullptr) {
+        env->ThrowNew(exceptionClass, message);
+    }
+}
+
 jbyteArray TWDataJByteArray(TWData *_Nonnull data, JNIEnv *env) {
     auto dataSize = static_cast<jsize>(TWDataSize(data));
     jbyteArray array = env->NewByteArray(dataSize);
@@ -16,9 +24,40 @@ jbyteArray TWDataJByteArray(TWData *_Nonnull data, JNIEnv *env) {
 }
 
 TWData *_Nonnull TWDataCreateWithJByteArray(JNIEnv *env, jbyteArray _Nonnull array) {
+    // Copy the array straight into the TWData; GetByteArrayElements would usually copy it to a temporary first.
     jsize size = env->GetArrayLength(array);
-    jbyte *bytes = env->GetByteArrayElements(array, nullptr);
-    const auto *twdata = TWDataCreateWithBytes((uint8_t *) bytes, size);
-    env->ReleaseByteArrayElements(array, bytes, JNI_ABORT);
+    auto *twdata = TWDataCreateWithSize(size);
+    env->GetByteArrayRegion(array, 0, size, (jbyte *) TWDataBytes(twdata));
     return twdata;
 }
+
+TWData *_Nullable TWDataCreateWithJDirectBuffer(JNIEnv *env, jobject _Nonnull buffer, jint size) {
+    const auto *bytes = static_cast<const uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (bytes == nullptr || size < 0 || size > env->GetDirectBufferCapacity(buffer)) {
+        throwIllegalArgument(env, "buffer must be direct and hold the given size");
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(bytes, size);
+}
+
+jint TWDataCopyToJDirectBuffer(TWData *_Nonnull data, JNIEnv *env, jobject _Nonnull buffer, jlongArray _Nullable pending) {
+    auto *bytes = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (bytes == nullptr) {
+        TWDataDelete(data);
+        throwIllegalArgument(env, "buffer must be direct");
+        return 0;
+    }
+    auto dataSize = static_cast<jint>(TWDataSize(data));
+    if (dataSize > env->GetDirectBufferCapacity(buffer)) {
+        if (pending == nullptr) {
+            TWDataDelete(data);
+        } else {
+            auto handle = reinterpret_cast<jlong>(data);
+            env->SetLongArrayRegion(pending, 0, 1, &handle);
+        }
+        return -dataSize;
+    }
+    memcpy(bytes, TWDataBytes(data), dataSize);
+    TWDataDelete(data);
+    return dataSize;
+}
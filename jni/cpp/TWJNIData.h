@@ -15,4 +15,14 @@ jbyteArray TWDataJByteArray(TWData *data, JNIEnv *env);
 /// Converts a Java byte array to a TWData, caller must delete it after use.
 TWData * TWDataCreateWithJByteArray(JNIEnv *env, jbyteArray array);
 
+/// Copies the first `size` bytes of a direct `java.nio.ByteBuffer` to a TWData, caller must delete it after use.
+/// Throws an IllegalArgumentException and returns NULL if the buffer is not direct or is too small.
+TWData * TWDataCreateWithJDirectBuffer(JNIEnv *env, jobject buffer, jint size);
+
+/// Copies a TWData (will be deleted within this call) to the start of a direct `java.nio.ByteBuffer`, and returns its size.
+/// If it does not fit, nothing is copied and its negated size is returned. The data is then kept, with its handle stored
+/// in the first element of `pending`, to be copied to a larger buffer without producing it again; it is deleted if `pending` is NULL.
+/// Throws an IllegalArgumentException and returns 0 if the buffer is not direct.
+jint TWDataCopyToJDirectBuffer(TWData *data, JNIEnv *env, jobject buffer, jlongArray pending);
+
 TW_EXTERN_C_END
@@ -7,6 +7,8 @@ package wallet.core.java;
 import com.google.protobuf.MessageLite;
 import com.google.protobuf.Parser;
 
+import java.nio.ByteBuffer;
+
 import wallet.core.jni.CoinType;
 
 public class AnySigner {
@@ -31,4 +33,18 @@ public class AnySigner {
         return output;
     }
     public static native byte[] nativePlan(byte[] data, int coin);
+
+    /** Same as {@link #sign}, passing the input and output through per-thread direct buffers instead of byte arrays. */
+    public static <T extends MessageLite> T signDirect(MessageLite input, CoinType coin, Parser<T> parser) throws Exception {
+        return DirectBuffers.call(input, parser, (in, inSize, out, pending) -> nativeSignDirect(in, inSize, out, pending, coin.value()));
+    }
+    /** Returns the output size, or its negated size if it does not fit in `output`, keeping it for {@link DirectBuffers}. Both buffers must be direct. */
+    static native int nativeSignDirect(ByteBuffer input, int inputSize, ByteBuffer output, long[] pending, int coin);
+
+    /** Same as {@link #plan}, passing the input and output through per-thread direct buffers instead of byte arrays. */
+    public static <T extends MessageLite> T planDirect(MessageLite input, CoinType coin, Parser<T> parser) throws Exception {
+        return DirectBuffers.call(input, parser, (in, inSize, out, pending) -> nativePlanDirect(in, inSize, out, pending, coin.value()));
+    }
+    /** Returns the output size, or its negated size if it does not fit in `output`, keeping it for {@link DirectBuffers}. Both buffers must be direct. */
+    static native int nativePlanDirect(ByteBuffer input, int inputSize, ByteBuffer output, long[] pending, int coin);
 }
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+package wallet.core.java;
+
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.MessageLite;
+import com.google.protobuf.Parser;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Per-thread direct buffers used to pass protobuf messages to the native library without going through byte arrays.
+ * Messages are serialized straight into the input buffer, and parsed straight from the output buffer.
+ */
+final class DirectBuffers {
+    private static final int INITIAL_CAPACITY = 64 * 1024;
+    private static final ThreadLocal<DirectBuffers> buffers = new ThreadLocal<DirectBuffers>() {
+        @Override
+        protected DirectBuffers initialValue() {
+            return new DirectBuffers();
+        }
+    };
+
+    private ByteBuffer input = ByteBuffer.allocateDirect(INITIAL_CAPACITY);
+    private ByteBuffer output = ByteBuffer.allocateDirect(INITIAL_CAPACITY);
+    private final long[] pending = new long[1];
+
+    /**
+     * A native call reading `inputSize` bytes of `input` and returning the size written to `output`.
+     * If the result does not fit, it returns the negated size, and stores in `pending[0]` a handle to the result,
+     * to be passed to `nativeTakeOutput`.
+     */
+    interface NativeCall {
+        int call(ByteBuffer input, int inputSize, ByteBuffer output, long[] pending);
+    }
+
+    private DirectBuffers() {}
+
+    /**
+     * Serializes a message to the calling thread's input buffer, runs the native call, and parses its output.
+     * The buffers grow as needed; if the output does not fit, it is copied to a large enough buffer without running the call again.
+     */
+    static <T extends MessageLite> T call(MessageLite message, Parser<T> parser, NativeCall nativeCall) throws Exception {
+        return buffers.get().run(message, parser, nativeCall);
+    }
+
+    private <T extends MessageLite> T run(MessageLite message, Parser<T> parser, NativeCall nativeCall) throws Exception {
+        int inputSize = message.getSerializedSize();
+        if (inputSize > input.capacity()) {
+            input = ByteBuffer.allocateDirect(grow(input.capacity(), inputSize));
+        }
+        input.clear();
+        CodedOutputStream stream = CodedOutputStream.newInstance(input);
+        message.writeTo(stream);
+        stream.flush();
+
+        int outputSize = nativeCall.call(input, inputSize, output, pending);
+        if (outputSize < 0) {
+            long handle = pending[0];
+            try {
+                output = ByteBuffer.allocateDirect(grow(output.capacity(), -outputSize));
+            } catch (OutOfMemoryError error) {
+                nativeDeleteOutput(handle);
+                throw error;
+            }
+            outputSize = nativeTakeOutput(handle, output);
+        }
+        output.clear();
+        output.limit(outputSize);
+        return parser.parseFrom(output);
+    }
+
+    /** Copies a result kept by a native call to the start of `output`, which must be large enough, and deletes it. */
+    private static native int nativeTakeOutput(long handle, ByteBuffer output);
+
+    /** Deletes a result kept by a native call. */
+    private static native void nativeDeleteOutput(long handle);
+
+    private static int grow(int capacity, int size) {
+        while (capacity < size) {
+            capacity = capacity > Integer.MAX_VALUE / 2 ? Integer.MAX_VALUE : capacity * 2;
+        }
+        return capacity;
+    }
+}
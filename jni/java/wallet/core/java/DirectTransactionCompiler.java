@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+package wallet.core.java;
+
+import com.google.protobuf.MessageLite;
+import com.google.protobuf.Parser;
+
+import java.nio.ByteBuffer;
+
+import wallet.core.jni.CoinType;
+import wallet.core.jni.DataVector;
+
+/**
+ * Same as {@link wallet.core.jni.TransactionCompiler}, passing the input and output through per-thread direct buffers
+ * instead of byte arrays.
+ */
+public class DirectTransactionCompiler {
+    public static <T extends MessageLite> T preImageHashes(CoinType coin, MessageLite input, Parser<T> parser) throws Exception {
+        return DirectBuffers.call(input, parser, (in, inSize, out, pending) -> nativePreImageHashes(in, inSize, out, pending, coin.value()));
+    }
+    /** Returns the output size, or its negated size if it does not fit in `output`, keeping it for {@link DirectBuffers}. Both buffers must be direct. */
+    static native int nativePreImageHashes(ByteBuffer input, int inputSize, ByteBuffer output, long[] pending, int coin);
+
+    public static <T extends MessageLite> T compileWithSignatures(CoinType coin, MessageLite input, DataVector signatures, DataVector publicKeys, Parser<T> parser) throws Exception {
+        return DirectBuffers.call(input, parser, (in, inSize, out, pending) -> nativeCompileWithSignatures(in, inSize, out, pending, coin.value(), signatures, publicKeys));
+    }
+    /** Returns the output size, or its negated size if it does not fit in `output`, keeping it for {@link DirectBuffers}. Both buffers must be direct. */
+    static native int nativeCompileWithSignatures(ByteBuffer input, int inputSize, ByteBuffer output, long[] pending, int coin, DataVector signatures, DataVector publicKeys);
+}
@@ -10,7 +10,7 @@ use tw_proto::Polkadot::Proto::{
     },
     Balance, RewardDestination as TWRewardDestination, Staking,
 };
-use tw_scale::{impl_enum_scale, Compact, RawOwned, ToScale};
+use tw_scale::{impl_enum_scale, Compact, RawOwnedVec, ToScale};
 use tw_ss58_address::SS58Address;
 use tw_substrate::*;
 
@@ -234,6 +234,6 @@ impl GenericStaking {
 impl_enum_scale!(
     #[derive(Clone, Debug)]
     pub enum GenericUtility {
-        BatchAll { calls: Vec<RawOwned> } = 0x02,
+        BatchAll { calls: RawOwnedVec } = 0x02,
     }
 );
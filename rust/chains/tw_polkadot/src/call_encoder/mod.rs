@@ -10,7 +10,7 @@ use tw_proto::Polkadot::Proto::{
     },
     Balance, CallIndices, Staking,
 };
-use tw_scale::{RawOwned, ToScale};
+use tw_scale::{RawOwned, RawOwnedVec};
 use tw_substrate::*;
 
 pub mod generic;
@@ -40,8 +40,9 @@ pub fn required_call_index(call_index: &Option<CallIndices>) -> EncodeResult<Cal
 }
 
 pub trait TWPolkadotCallEncoder {
-    fn encode_call(&self, msg: &SigningVariant<'_>) -> EncodeResult<RawOwned>;
-    fn encode_batch(&self, calls: Vec<RawOwned>) -> EncodeResult<RawOwned>;
+    /// Appends the encoded non-batch call to `out`.
+    fn encode_call_into(&self, msg: &SigningVariant<'_>, out: &mut Vec<u8>) -> EncodeResult<()>;
+    fn encode_batch(&self, calls: RawOwnedVec) -> EncodeResult<RawOwned>;
 }
 
 pub struct CallEncoder {
@@ -65,31 +66,26 @@ impl CallEncoder {
     }
 
     fn encode_batch_transfer(&self, bt: &BatchTransfer) -> EncodeResult<RawOwned> {
-        let transfers = bt
-            .transfers
-            .iter()
-            .map(|t| {
-                let call = SigningVariant::balance_call(Proto::Balance {
-                    message_oneof: BalanceVariant::transfer(t.clone()),
-                });
-                self.encode_call(&call)
-            })
-            .collect::<EncodeResult<Vec<RawOwned>>>()?;
+        // All the transfers are encoded into one buffer.
+        let mut transfers = RawOwnedVec::default();
+        for t in bt.transfers.iter() {
+            let call = SigningVariant::balance_call(Proto::Balance {
+                message_oneof: BalanceVariant::transfer(t.clone()),
+            });
+            transfers.push_with(|out| self.encoder.encode_call_into(&call, out))?;
+        }
 
         self.encode_batch(transfers, &bt.call_indices)
     }
 
     fn encode_batch_asset_transfer(&self, bat: &BatchAssetTransfer) -> EncodeResult<RawOwned> {
-        let transfers = bat
-            .transfers
-            .iter()
-            .map(|t| {
-                let call = SigningVariant::balance_call(Proto::Balance {
-                    message_oneof: BalanceVariant::asset_transfer(t.clone()),
-                });
-                self.encode_call(&call)
-            })
-            .collect::<EncodeResult<Vec<RawOwned>>>()?;
+        let mut transfers = RawOwnedVec::default();
+        for t in bat.transfers.iter() {
+            let call = SigningVariant::balance_call(Proto::Balance {
+                message_oneof: BalanceVariant::asset_transfer(t.clone()),
+            });
+            transfers.push_with(|out| self.encoder.encode_call_into(&call, out))?;
+        }
 
         self.encode_batch(transfers, &bat.call_indices)
     }
@@ -128,7 +124,7 @@ impl CallEncoder {
         }))?;
 
         // Encode both calls as batched
-        self.encode_batch(vec![first, second], &ban.call_indices)
+        self.encode_batch(vec![first, second].into(), &ban.call_indices)
     }
 
     fn encode_staking_bond_extra_and_nominate(
@@ -152,7 +148,7 @@ impl CallEncoder {
         }))?;
 
         // Encode both calls as batched
-        self.encode_batch(vec![first, second], &bean.call_indices)
+        self.encode_batch(vec![first, second].into(), &bean.call_indices)
     }
 
     fn encode_staking_chill_and_unbond(&self, cau: &ChillAndUnbond) -> EncodeResult<RawOwned> {
@@ -170,7 +166,7 @@ impl CallEncoder {
         }))?;
 
         // Encode both calls as batched
-        self.encode_batch(vec![first, second], &cau.call_indices)
+        self.encode_batch(vec![first, second].into(), &cau.call_indices)
     }
 
     fn encode_staking_batch_call(&self, s: &Staking) -> EncodeResult<Option<RawOwned>> {
@@ -207,16 +203,13 @@ impl CallEncoder {
             _ => (),
         }
         // non-batch calls.
-        self.encoder.encode_call(msg)
+        let mut call = Vec::new();
+        self.encoder.encode_call_into(msg, &mut call)?;
+        Ok(RawOwned(call))
     }
 
-    fn encode_batch(
-        &self,
-        calls: Vec<RawOwned>,
-        ci: &Option<CallIndices>,
-    ) -> EncodeResult<RawOwned> {
+    fn encode_batch(&self, calls: RawOwnedVec, ci: &Option<CallIndices>) -> EncodeResult<RawOwned> {
         let ci = validate_call_index(ci)?;
-        let call = ci.wrap(self.encoder.encode_batch(calls)?);
-        Ok(RawOwned(call.to_scale()))
+        Ok(ci.wrap_raw(self.encoder.encode_batch(calls)?))
     }
 }
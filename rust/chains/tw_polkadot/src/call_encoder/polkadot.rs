@@ -1,4 +1,4 @@
-use tw_scale::{impl_enum_scale, RawOwned};
+use tw_scale::{impl_enum_scale, RawOwned, RawOwnedVec, ToScale};
 
 use tw_coin_entry::error::prelude::*;
 use tw_proto::Polkadot::Proto::mod_SigningInput::OneOfmessage_oneof as SigningVariant;
@@ -23,7 +23,7 @@ impl PolkadotCallEncoder {
 }
 
 impl TWPolkadotCallEncoder for PolkadotCallEncoder {
-    fn encode_call(&self, msg: &SigningVariant<'_>) -> EncodeResult<RawOwned> {
+    fn encode_call_into(&self, msg: &SigningVariant<'_>, out: &mut Vec<u8>) -> EncodeResult<()> {
         let call = match msg {
             SigningVariant::balance_call(b) => {
                 GenericBalances::encode_call(&self.0, b)?.map(PolkadotCall::Balances)
@@ -37,10 +37,12 @@ impl TWPolkadotCallEncoder for PolkadotCallEncoder {
                     .context("Unsupported call variant.");
             },
         };
-        Ok(RawOwned(call.to_scale()))
+        out.reserve(call.size_hint());
+        call.to_scale_into(out);
+        Ok(())
     }
 
-    fn encode_batch(&self, calls: Vec<RawOwned>) -> EncodeResult<RawOwned> {
+    fn encode_batch(&self, calls: RawOwnedVec) -> EncodeResult<RawOwned> {
         let call = PolkadotCall::Utility(GenericUtility::BatchAll { calls });
         Ok(RawOwned(call.to_scale()))
     }
@@ -64,7 +66,7 @@ impl KusamaCallEncoder {
 }
 
 impl TWPolkadotCallEncoder for KusamaCallEncoder {
-    fn encode_call(&self, msg: &SigningVariant<'_>) -> EncodeResult<RawOwned> {
+    fn encode_call_into(&self, msg: &SigningVariant<'_>, out: &mut Vec<u8>) -> EncodeResult<()> {
         let call = match msg {
             SigningVariant::balance_call(b) => {
                 GenericBalances::encode_call(&self.0, b)?.map(KusamaCall::Balances)
@@ -78,10 +80,12 @@ impl TWPolkadotCallEncoder for KusamaCallEncoder {
                     .context("Unsupported call variant.");
             },
         };
-        Ok(RawOwned(call.to_scale()))
+        out.reserve(call.size_hint());
+        call.to_scale_into(out);
+        Ok(())
     }
 
-    fn encode_batch(&self, calls: Vec<RawOwned>) -> EncodeResult<RawOwned> {
+    fn encode_batch(&self, calls: RawOwnedVec) -> EncodeResult<RawOwned> {
         let call = KusamaCall::Utility(GenericUtility::BatchAll { calls });
         Ok(RawOwned(call.to_scale()))
     }
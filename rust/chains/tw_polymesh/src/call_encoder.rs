@@ -20,7 +20,7 @@ use tw_proto::Polymesh::Proto::{
     mod_Utility::{BatchKind, OneOfmessage_oneof as UtilityVariant},
     Balance, Identity, Staking, Utility,
 };
-use tw_scale::{impl_enum_scale, Compact, RawOwned, ToScale};
+use tw_scale::{impl_enum_scale, Compact, RawOwned, RawOwnedVec, ToScale};
 use tw_ss58_address::SS58Address;
 use tw_substrate::address::SubstrateAddress;
 use tw_substrate::*;
@@ -287,9 +287,9 @@ impl PolymeshStaking {
 impl_enum_scale!(
     #[derive(Clone, Debug)]
     pub enum PolymeshUtility {
-        Batch { calls: Vec<RawOwned> } = 0x00,
-        BatchAll { calls: Vec<RawOwned> } = 0x02,
-        ForceBatch { calls: Vec<RawOwned> } = 0x04,
+        Batch { calls: RawOwnedVec } = 0x00,
+        BatchAll { calls: RawOwnedVec } = 0x02,
+        ForceBatch { calls: RawOwnedVec } = 0x04,
     }
 );
 
@@ -304,11 +304,11 @@ impl PolymeshUtility {
         match &u.message_oneof {
             UtilityVariant::batch(b) => {
                 let ci = validate_call_index(&b.call_indices)?;
-                let calls = b
-                    .calls
-                    .iter()
-                    .map(|call| encoder.encode_runtime_call(call))
-                    .collect::<EncodeResult<Vec<RawOwned>>>()?;
+                // All the calls are encoded into one buffer.
+                let mut calls = RawOwnedVec::default();
+                for call in b.calls.iter() {
+                    calls.push_with(|out| encoder.encode_runtime_call_into(call, out))?;
+                }
                 encoder.batch_depth -= 1;
                 let batch = match b.kind {
                     BatchKind::StopOnError => Self::Batch { calls },
@@ -356,6 +356,17 @@ impl CallEncoder {
     }
 
     pub fn encode_runtime_call(&mut self, call: &Proto::RuntimeCall) -> EncodeResult<RawOwned> {
+        let mut encoded = Vec::new();
+        self.encode_runtime_call_into(call, &mut encoded)?;
+        Ok(RawOwned(encoded))
+    }
+
+    /// Appends the encoded runtime call to `out`.
+    pub fn encode_runtime_call_into(
+        &mut self,
+        call: &Proto::RuntimeCall,
+        out: &mut Vec<u8>,
+    ) -> EncodeResult<()> {
         let call = match &call.pallet_oneof {
             RuntimeCallVariant::balance_call(msg) => {
                 PolymeshBalances::encode_call(msg)?.map(PolymeshCall::Balances)
@@ -375,6 +386,8 @@ impl CallEncoder {
                     .context("Runtime call variant is None");
             },
         };
-        Ok(RawOwned(call.to_scale()))
+        out.reserve(call.size_hint());
+        call.to_scale_into(out);
+        Ok(())
     }
 }
@@ -64,20 +64,14 @@ impl SolanaAddress {
         seeds: &[&[u8]],
         program_id: SolanaAddress,
     ) -> Option<SolanaAddress> {
-        let mut bump_seed = [u8::MAX];
-        for _ in 0..u8::MAX {
-            let mut seeds_with_bump = seeds.to_vec();
-            seeds_with_bump.push(&bump_seed);
-            match Self::create_program_address(&seeds_with_bump, program_id) {
-                Ok(Some(address)) => return Some(address),
-                // Try to re-compute the program address with a different seed.
-                Ok(None) => (),
-                Err(_) => return None,
-            }
-            // Try to re-compute the program address with a different seed.
-            bump_seed[0] -= 1;
+        // One more seed is the bump seed.
+        if !Self::are_valid_seeds(seeds, 1) {
+            return None;
         }
-        None
+        // Try to re-compute the program address with a different seed, from `u8::MAX` down to 1.
+        (1..=u8::MAX)
+            .rev()
+            .find_map(|bump_seed| Self::off_curve_address(seeds, &[bump_seed], program_id))
     }
 
     /// Create a valid [program derived address][pda] without searching for a bump seed.
@@ -100,30 +94,37 @@ impl SolanaAddress {
         seeds: &[&[u8]],
         program_id: SolanaAddress,
     ) -> AddressResult<Option<SolanaAddress>> {
-        if seeds.len() > MAX_SEEDS {
-            return Err(AddressError::Internal);
-        }
-        if seeds.iter().any(|seed| seed.len() > MAX_SEED_LEN) {
+        if !Self::are_valid_seeds(seeds, 0) {
             return Err(AddressError::Internal);
         }
+        Ok(Self::off_curve_address(seeds, &[], program_id))
+    }
 
-        let mut data_to_hash = Vec::new();
+    fn are_valid_seeds(seeds: &[&[u8]], extra_seeds: usize) -> bool {
+        seeds.len() + extra_seeds <= MAX_SEEDS
+            && seeds.iter().all(|seed| seed.len() <= MAX_SEED_LEN)
+    }
 
-        // concatenate seeds
+    /// Hashes the seeds followed by `program_id`, without concatenating them into one buffer first.
+    fn off_curve_address(
+        seeds: &[&[u8]],
+        bump_seed: &[u8],
+        program_id: SolanaAddress,
+    ) -> Option<SolanaAddress> {
+        let mut hasher = sha2::Sha256Hasher::default();
         for seed in seeds {
-            data_to_hash.extend_from_slice(seed);
+            hasher.update(seed);
         }
-        // Append `program_id`.
-        data_to_hash.extend_from_slice(program_id.bytes.as_slice());
-        data_to_hash.extend_from_slice(PDA_MARKER);
-
-        let hash = H256::try_from(sha2::sha256(&data_to_hash).as_slice())
-            .expect("sha256 must return 32 bytes");
+        hasher
+            .update(bump_seed)
+            .update(program_id.bytes.as_slice())
+            .update(PDA_MARKER);
+        let hash = hasher.finalize();
 
         // The given hash (aka new public key) must not be on the ed25519 elliptic curve.
         match ed25519::sha512::PublicKey::try_from(hash.as_slice()) {
-            Ok(_) => Ok(None),
-            Err(_) => Ok(Some(SolanaAddress::with_public_key_bytes(hash))),
+            Ok(_) => None,
+            Err(_) => Some(SolanaAddress::with_public_key_bytes(hash)),
         }
     }
 }
@@ -850,7 +850,7 @@ where
     u8::try_from(num).tw_err(SigningErrorType::Error_tx_too_big)
 }
 
-fn match_program_id(program_id: Proto::TokenProgramId) -> SolanaAddress {
+pub(crate) fn match_program_id(program_id: Proto::TokenProgramId) -> SolanaAddress {
     match program_id {
         Proto::TokenProgramId::TokenProgram => *TOKEN_PROGRAM_ID_ADDRESS,
         Proto::TokenProgramId::Token2022Program => *TOKEN_2022_PROGRAM_ID_ADDRESS,
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+use crate::address::SolanaAddress;
+use crate::blockhash::Blockhash;
+use crate::modules::insert_instruction::InsertInstruction;
+use crate::modules::message_builder::{match_program_id, MessageBuilder};
+use crate::modules::tx_signer::TxSigner;
+use crate::modules::PubkeySignatureMap;
+use crate::program::stake_program::StakeProgram;
+use crate::transaction::versioned::{VersionedMessage, VersionedTransaction};
+use std::ops::Range;
+use std::str::FromStr;
+use tw_coin_entry::error::prelude::*;
+use tw_keypair::ed25519;
+use tw_proto::Solana::Proto;
+use Proto::mod_SigningInput::OneOftransaction_type as ProtoTransactionType;
+
+/// `TransferChecked` instruction tag, followed by the amount (u64 LE) and decimals.
+const TRANSFER_CHECKED_TAG: u8 = 12;
+const TRANSFER_CHECKED_AMOUNT: Range<usize> = 1..9;
+const TRANSFER_CHECKED_DATA_LEN: usize = 10;
+
+/// A token transfer message compiled once by [`MessageBuilder`] and re-used for many recipients,
+/// e.g. for airdrops paid from the same sender token account.
+///
+/// Account keys of a message are ordered by their first use in the instructions, so a message
+/// for another recipient only differs in the recipient accounts, the transfer amount and the blockhash.
+/// These are patched into a copy of the compiled message, which is the same message that
+/// [`MessageBuilder`] would build for the corresponding [`Proto::SigningInput`].
+///
+/// Recipients are given by their main addresses, and receive tokens to their associated token accounts.
+pub struct TokenTransferTemplate {
+    message: VersionedMessage,
+    signing_keys: Vec<ed25519::sha512::KeyPair>,
+    token_mint_address: SolanaAddress,
+    token_program_id: SolanaAddress,
+    /// Index of the recipient token account in the message account keys.
+    recipient_token_index: usize,
+    /// Index of the recipient main account if the template creates the recipient token account.
+    recipient_main_index: Option<usize>,
+    /// Index of the `TransferChecked` instruction.
+    transfer_ix_index: usize,
+}
+
+impl TokenTransferTemplate {
+    /// Compiles a template from a `token_transfer_transaction` or `create_and_transfer_token_transaction` input.
+    pub fn new(input: Proto::SigningInput<'_>) -> SigningResult<Self> {
+        if input.raw_message.is_some() {
+            return SigningError::err(SigningErrorType::Error_invalid_params)
+                .context("A raw message cannot be used as a template");
+        }
+
+        let (token_mint_address, token_program_id, recipient_main, recipient_token) =
+            match input.transaction_type {
+                ProtoTransactionType::token_transfer_transaction(ref transfer) => (
+                    parse_address(&transfer.token_mint_address, "Invalid token mint address")?,
+                    match_program_id(transfer.token_program_id),
+                    None,
+                    parse_address(
+                        &transfer.recipient_token_address,
+                        "Invalid recipient token address",
+                    )?,
+                ),
+                ProtoTransactionType::create_and_transfer_token_transaction(ref transfer) => (
+                    parse_address(&transfer.token_mint_address, "Invalid token mint address")?,
+                    match_program_id(transfer.token_program_id),
+                    Some(parse_address(
+                        &transfer.recipient_main_address,
+                        "Invalid recipient main address",
+                    )?),
+                    parse_address(
+                        &transfer.recipient_token_address,
+                        "Invalid recipient token address",
+                    )?,
+                ),
+                _ => {
+                    return SigningError::err(SigningErrorType::Error_invalid_params)
+                        .context("Only token transfers can be used as a template")
+                },
+            };
+
+        let builder = MessageBuilder::new(input);
+        let signing_keys = builder.signing_keys()?;
+        let message = builder.build()?;
+
+        let recipient_token_index = account_index(&message, recipient_token)?;
+        let recipient_main_index = recipient_main
+            .map(|main| account_index(&message, main))
+            .transpose()?;
+
+        let transfer_ix_index = message
+            .instructions()
+            .iter()
+            .position(|ix| {
+                ix.data.len() == TRANSFER_CHECKED_DATA_LEN
+                    && ix.data[0] == TRANSFER_CHECKED_TAG
+                    && message.account_keys().get(ix.program_id_index as usize)
+                        == Some(&token_program_id)
+                    && ix.accounts.get(2).map(|idx| *idx as usize) == Some(recipient_token_index)
+            })
+            .or_tw_err(SigningErrorType::Error_internal)
+            .context("No token transfer instruction found")?;
+
+        // The recipient accounts can be replaced only if no other account of the message is the same.
+        // Otherwise, the key would be referenced more often, or would be a signer (e.g. the fee payer).
+        let expected_token_refs = if recipient_main_index.is_some() { 2 } else { 1 };
+        if !is_exclusive(&message, recipient_token_index, expected_token_refs)
+            || recipient_main_index.is_some_and(|index| !is_exclusive(&message, index, 1))
+        {
+            return SigningError::err(SigningErrorType::Error_invalid_params)
+                .context("The recipient is also used as another account of the transaction");
+        }
+
+        Ok(TokenTransferTemplate {
+            message,
+            signing_keys,
+            token_mint_address,
+            token_program_id,
+            recipient_token_index,
+            recipient_main_index,
+            transfer_ix_index,
+        })
+    }
+
+    /// Returns the unsigned message transferring `amount` tokens to the `recipient` associated token account.
+    pub fn message(
+        &self,
+        recent_blockhash: Blockhash,
+        recipient: SolanaAddress,
+        amount: u64,
+    ) -> SigningResult<VersionedMessage> {
+        let recipient_token = StakeProgram::get_associated_token_address(
+            recipient,
+            self.token_program_id,
+            self.token_mint_address,
+        )
+        .into_tw()
+        .context("Cannot derive the recipient token address")?;
+
+        let mut patches = vec![(self.recipient_token_index, recipient_token)];
+        if let Some(index) = self.recipient_main_index {
+            patches.push((index, recipient));
+        }
+
+        let keys = self.message.account_keys();
+        let is_taken = |(_, address): &(usize, SolanaAddress)| {
+            keys.iter().enumerate().any(|(i, key)| {
+                key == address && patches.iter().all(|(patch_index, _)| *patch_index != i)
+            })
+        };
+        if patches.iter().any(is_taken) || recipient_token == recipient {
+            return SigningError::err(SigningErrorType::Error_invalid_params)
+                .context("The recipient is also used as another account of the transaction");
+        }
+
+        let mut message = self.message.clone();
+        message.set_recent_blockhash(recent_blockhash.to_bytes());
+        for (index, address) in patches {
+            message.account_keys_mut()[index] = address;
+        }
+        message.instructions_mut()[self.transfer_ix_index].data[TRANSFER_CHECKED_AMOUNT]
+            .copy_from_slice(&amount.to_le_bytes());
+        Ok(message)
+    }
+
+    /// Returns the message of [`TokenTransferTemplate::message`] signed by the keys of the template input.
+    pub fn sign(
+        &self,
+        recent_blockhash: Blockhash,
+        recipient: SolanaAddress,
+        amount: u64,
+    ) -> SigningResult<VersionedTransaction> {
+        let message = self.message(recent_blockhash, recipient, amount)?;
+        TxSigner::sign_versioned(message, &self.signing_keys, &PubkeySignatureMap::default())
+    }
+}
+
+fn parse_address(address: &str, error_context: &'static str) -> SigningResult<SolanaAddress> {
+    SolanaAddress::from_str(address)
+        .into_tw()
+        .context(error_context)
+}
+
+fn account_index(message: &VersionedMessage, address: SolanaAddress) -> SigningResult<usize> {
+    message
+        .get_account_index(address)
+        .or_tw_err(SigningErrorType::Error_internal)
+        .context("The recipient is not an account of the compiled message")
+}
+
+/// Checks that the account at `index` is neither a signer nor referenced more than `expected_refs` times.
+fn is_exclusive(message: &VersionedMessage, index: usize, expected_refs: usize) -> bool {
+    let refs: usize = message
+        .instructions()
+        .iter()
+        .map(|ix| {
+            let program_ref = usize::from(ix.program_id_index as usize == index);
+            let account_refs = ix.accounts.iter().filter(|i| **i as usize == index).count();
+            program_ref + account_refs
+        })
+        .sum();
+    index >= message.num_required_signatures() && refs == expected_refs
+}
@@ -12,6 +12,7 @@ pub mod insert_instruction;
 pub mod instruction_builder;
 pub mod message_builder;
 pub mod message_decompiler;
+pub mod message_template;
 pub mod offchain_message_signer;
 pub mod proto_builder;
 pub mod transaction_decoder;
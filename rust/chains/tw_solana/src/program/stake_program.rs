@@ -5,12 +5,27 @@
 use crate::address::SolanaAddress;
 use crate::blockhash::Blockhash;
 use crate::defined_addresses::*;
+use lazy_static::lazy_static;
+use std::collections::HashMap;
+use std::sync::Mutex;
 use tw_coin_entry::error::prelude::*;
 use tw_hash::sha2::sha256;
 use tw_hash::H256;
 
 pub const MAX_SEED_LEN: usize = 32;
 
+/// Maximum number of derived associated token addresses kept in [`ATA_CACHE`].
+const ATA_CACHE_CAPACITY: usize = 4096;
+
+/// (main address, token program ID, token mint address).
+type AtaCacheKey = (SolanaAddress, SolanaAddress, SolanaAddress);
+
+lazy_static! {
+    /// Associated token addresses are deterministic, so the entries never go stale.
+    /// Deriving one takes a SHA-256 and a point decompression per bump seed tried.
+    static ref ATA_CACHE: Mutex<HashMap<AtaCacheKey, SolanaAddress>> = Mutex::default();
+}
+
 pub struct StakeProgram;
 
 impl StakeProgram {
@@ -40,7 +55,16 @@ impl StakeProgram {
         token_program_id: SolanaAddress,
         token_mint_address: SolanaAddress,
     ) -> AddressResult<SolanaAddress> {
-        SolanaAddress::find_program_address(
+        let key = (main_address, token_program_id, token_mint_address);
+        if let Some(address) = ATA_CACHE
+            .lock()
+            .ok()
+            .and_then(|cache| cache.get(&key).copied())
+        {
+            return Ok(address);
+        }
+
+        let address = SolanaAddress::find_program_address(
             &[
                 main_address.bytes().as_slice(),
                 token_program_id.bytes().as_slice(),
@@ -48,6 +72,15 @@ impl StakeProgram {
             ],
             *ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS,
         )
-        .ok_or(AddressError::InvalidInput)
+        .ok_or(AddressError::InvalidInput)?;
+
+        // The cache is only an optimization, a poisoned lock is not an error.
+        if let Ok(mut cache) = ATA_CACHE.lock() {
+            if cache.len() >= ATA_CACHE_CAPACITY {
+                cache.clear();
+            }
+            cache.insert(key, address);
+        }
+        Ok(address)
     }
 }
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+use std::borrow::Cow;
+use std::str::FromStr;
+use std::time::Instant;
+use tw_coin_entry::error::prelude::*;
+use tw_encoding::base58;
+use tw_hash::H256;
+use tw_proto::Solana::Proto;
+use tw_solana::address::SolanaAddress;
+use tw_solana::blockhash::Blockhash;
+use tw_solana::defined_addresses::{ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS, TOKEN_PROGRAM_ID_ADDRESS};
+use tw_solana::modules::message_builder::MessageBuilder;
+use tw_solana::modules::message_template::TokenTransferTemplate;
+use tw_solana::program::stake_program::StakeProgram;
+use tw_solana::SOLANA_ALPHABET;
+use Proto::mod_SigningInput::OneOftransaction_type as TransactionType;
+
+const PRIVATE_KEY: &str = "66ApBuKpo2uSzpjGBraHq7HP8UZMUJzp3um8FdEjkC9c";
+const TOKEN_MINT_ADDRESS: &str = "SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt";
+const SENDER_TOKEN_ADDRESS: &str = "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf";
+
+fn b58(s: &str) -> Cow<'static, [u8]> {
+    base58::decode(s, SOLANA_ALPHABET).unwrap().into()
+}
+
+fn address(s: &str) -> SolanaAddress {
+    SolanaAddress::from_str(s).unwrap()
+}
+
+fn blockhash(s: &str) -> Blockhash {
+    Blockhash::from_str(s).unwrap()
+}
+
+fn create_and_transfer_input(
+    recipient_main_address: &'static str,
+    recipient_token_address: &'static str,
+    amount: u64,
+    recent_blockhash: &'static str,
+) -> Proto::SigningInput<'static> {
+    let create_transfer_token = Proto::CreateAndTransferToken {
+        recipient_main_address: recipient_main_address.into(),
+        token_mint_address: TOKEN_MINT_ADDRESS.into(),
+        recipient_token_address: recipient_token_address.into(),
+        sender_token_address: SENDER_TOKEN_ADDRESS.into(),
+        amount,
+        decimals: 6,
+        ..Proto::CreateAndTransferToken::default()
+    };
+    Proto::SigningInput {
+        private_key: b58(PRIVATE_KEY),
+        recent_blockhash: recent_blockhash.into(),
+        transaction_type: TransactionType::create_and_transfer_token_transaction(
+            create_transfer_token,
+        ),
+        ..Proto::SigningInput::default()
+    }
+}
+
+fn token_transfer_input(
+    recipient_token_address: &'static str,
+    amount: u64,
+    recent_blockhash: &'static str,
+) -> Proto::SigningInput<'static> {
+    let token_transfer = Proto::TokenTransfer {
+        token_mint_address: TOKEN_MINT_ADDRESS.into(),
+        sender_token_address: SENDER_TOKEN_ADDRESS.into(),
+        recipient_token_address: recipient_token_address.into(),
+        amount,
+        decimals: 6,
+        memo: "airdrop".into(),
+        ..Proto::TokenTransfer::default()
+    };
+    Proto::SigningInput {
+        private_key: b58(PRIVATE_KEY),
+        recent_blockhash: recent_blockhash.into(),
+        transaction_type: TransactionType::token_transfer_transaction(token_transfer),
+        ..Proto::SigningInput::default()
+    }
+}
+
+#[test]
+fn test_create_and_transfer_template_sign() {
+    // The template is compiled for another recipient, amount and blockhash.
+    let template = TokenTransferTemplate::new(create_and_transfer_input(
+        "B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V",
+        "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP",
+        1000,
+        "AfzzEC8NVXoxKoHdjXLDVzqwqvvZmgPuqyJqjuHiPY1D",
+    ))
+    .unwrap();
+
+    let signed_tx = template
+        .sign(
+            blockhash("DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja"),
+            address("71e8mDsh3PR6gN64zL1HjwuxyKpgRXrPDUJT7XXojsVd"),
+            // 0.0029
+            2900,
+        )
+        .unwrap();
+    let encoded = base58::encode(&bincode::serialize(&signed_tx).unwrap(), SOLANA_ALPHABET);
+
+    // https://explorer.solana.com/tx/449VaYo48LrkMJF6XVKt9sJwVQN6Seqrmh9erDCLtiuj6BgFG3wpF5TwjNkxgJ7qzNa6NTj3TFsU3h9hKszfkA7w
+    assert_eq!(encoded, "3Y2MVz2VVi7aEyC9q1awwdk1ModDBPHRSacKmTYnSgkmbbJeZ62Fub1bVPSHaTy4LUcQpzCQYhHAKtTKXUDYijEeLsMAUqPBEMAq1w8zCdqDpdXy6M4PuwNtYVV1WgqeiEsiMWpPp4BGWKfcziwFbmYueUGituacJq4wTnt92fho8mFi49XW64gEG4iNGScDtJkY7Geq8PKiLh1E9JMJoceiHxKbmxzCmmLTxEHdhySYHcDUSXnXWogZskeZNBMtR9dNjEMkCzEjrxRpBtJPtUNshciY45mDPNmw4j3xyLCBTRikyfFLc5g11r3UgyVD4YokoPRvrEXsgt6W3yjBshropBm6mY2eJYvfY2eZz4Yq8kLcUatCHVKtjcb1mP9Ww57KisJ9bRhipC8sodFaMYhZARMEa4a1u9eH4MyNUATRGNXarwQSBY46PWS3nKP6QBK7Dw7Ppp9MmYkdPcXKaLScbyLF3jKu6dHWMkHw3WdXSsM1wwXjXnWF9LxdwaEVcDmySWybj6aKD9QCWTU5kdncqJU56f7SYNRTN289WdUFGNDmSh56tj2v1");
+}
+
+#[test]
+fn test_token_transfer_template_same_as_builder() {
+    let template = TokenTransferTemplate::new(token_transfer_input(
+        "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP",
+        1000,
+        "AfzzEC8NVXoxKoHdjXLDVzqwqvvZmgPuqyJqjuHiPY1D",
+    ))
+    .unwrap();
+
+    let recipients = [
+        (
+            "HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp",
+            "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD",
+        ),
+        (
+            "71e8mDsh3PR6gN64zL1HjwuxyKpgRXrPDUJT7XXojsVd",
+            "EF6L8yJT1SoRoDCkAZfSVmaweqMzfhxZiptKi7Tgj5XY",
+        ),
+    ];
+    for (amount, (main_address, token_address)) in (1..).zip(recipients) {
+        let recent_blockhash = "DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja";
+        let expected = MessageBuilder::new(token_transfer_input(
+            token_address,
+            amount,
+            recent_blockhash,
+        ))
+        .build()
+        .unwrap();
+
+        let actual = template
+            .message(blockhash(recent_blockhash), address(main_address), amount)
+            .unwrap();
+        assert_eq!(actual, expected);
+    }
+}
+
+#[test]
+fn test_token_transfer_template_recipient_is_sender() {
+    let template = TokenTransferTemplate::new(token_transfer_input(
+        "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP",
+        1000,
+        "AfzzEC8NVXoxKoHdjXLDVzqwqvvZmgPuqyJqjuHiPY1D",
+    ))
+    .unwrap();
+
+    // The associated token account of the recipient is the sender token account.
+    let err = template
+        .message(
+            blockhash("DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja"),
+            address("Eg5jqooyG6ySaXKbQUu4Lpvu2SqUPZrNkM4zXs9iUDLJ"),
+            1,
+        )
+        .unwrap_err();
+    assert_eq!(err.error_type(), &SigningErrorType::Error_invalid_params);
+}
+
+#[test]
+fn test_template_unsupported_transaction() {
+    let input = Proto::SigningInput {
+        private_key: b58(PRIVATE_KEY),
+        recent_blockhash: "DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja".into(),
+        transaction_type: TransactionType::transfer_transaction(Proto::Transfer {
+            recipient: "71e8mDsh3PR6gN64zL1HjwuxyKpgRXrPDUJT7XXojsVd".into(),
+            value: 1,
+            ..Proto::Transfer::default()
+        }),
+        ..Proto::SigningInput::default()
+    };
+    let err = TokenTransferTemplate::new(input).err().unwrap();
+    assert_eq!(err.error_type(), &SigningErrorType::Error_invalid_params);
+}
+
+// Run with `cargo test -p tw_solana --test message_template -- --ignored --nocapture benchmark`.
+#[test]
+#[ignore]
+fn benchmark_token_transfer_template() {
+    const COUNT: u64 = 1000;
+    let recent_blockhash = "DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja";
+    let token_program_id = *TOKEN_PROGRAM_ID_ADDRESS;
+    let token_mint_address = address(TOKEN_MINT_ADDRESS);
+
+    let recipients: Vec<_> = (1..=COUNT)
+        .map(|i| {
+            let mut bytes = [0; 32];
+            bytes[..8].copy_from_slice(&i.to_le_bytes());
+            SolanaAddress::with_public_key_bytes(H256::from(bytes))
+        })
+        .collect();
+
+    // Associated token addresses, derived for every recipient, then looked up in the cache.
+    let start = Instant::now();
+    let token_addresses: Vec<_> = recipients
+        .iter()
+        .map(|recipient| {
+            SolanaAddress::find_program_address(
+                &[
+                    recipient.bytes().as_slice(),
+                    token_program_id.bytes().as_slice(),
+                    token_mint_address.bytes().as_slice(),
+                ],
+                *ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS,
+            )
+            .unwrap()
+        })
+        .collect();
+    let derived = start.elapsed();
+
+    let cached_address = |recipient: &SolanaAddress| {
+        StakeProgram::get_associated_token_address(*recipient, token_program_id, token_mint_address)
+            .unwrap()
+    };
+    recipients.iter().for_each(|recipient| {
+        cached_address(recipient);
+    });
+    let start = Instant::now();
+    for (recipient, token_address) in recipients.iter().zip(&token_addresses) {
+        assert_eq!(cached_address(recipient), *token_address);
+    }
+    let cached = start.elapsed();
+
+    // A message built from the signing input of every recipient.
+    let start = Instant::now();
+    for (amount, token_address) in (1..).zip(&token_addresses) {
+        let mut input = token_transfer_input(
+            "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP",
+            amount,
+            recent_blockhash,
+        );
+        if let TransactionType::token_transfer_transaction(ref mut transfer) =
+            input.transaction_type
+        {
+            transfer.recipient_token_address = token_address.to_string().into();
+        }
+        MessageBuilder::new(input).build().unwrap();
+    }
+    let built = start.elapsed();
+
+    // The same messages patched into a copy of a template compiled once.
+    let template = TokenTransferTemplate::new(token_transfer_input(
+        "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP",
+        1000,
+        "AfzzEC8NVXoxKoHdjXLDVzqwqvvZmgPuqyJqjuHiPY1D",
+    ))
+    .unwrap();
+    let recent_blockhash = blockhash(recent_blockhash);
+    let start = Instant::now();
+    for (amount, recipient) in (1..).zip(&recipients) {
+        template
+            .message(recent_blockhash, *recipient, amount)
+            .unwrap();
+    }
+    let patched = start.elapsed();
+
+    println!(
+        "{COUNT} token addresses: {derived:?} derived, {cached:?} cached; \
+         {COUNT} messages: {built:?} built, {patched:?} from the template"
+    );
+}
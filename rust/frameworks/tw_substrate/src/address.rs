@@ -105,6 +105,10 @@ impl ToScale for MultiAddress {
         }
         self.account.to_scale_into(out);
     }
+
+    fn size_hint(&self) -> usize {
+        usize::from(self.multi) + self.account.size_hint()
+    }
 }
 
 impl From<SS58Address> for MultiAddress {
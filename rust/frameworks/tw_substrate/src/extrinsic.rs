@@ -5,7 +5,7 @@ use tw_keypair::{
     traits::SigningKeyTrait,
     KeyPairError,
 };
-use tw_scale::{impl_enum_scale, impl_struct_scale, RawOwned, ToScale};
+use tw_scale::{impl_enum_scale, impl_struct_scale, Compact, RawOwned, ToScale};
 
 use crate::address::*;
 use crate::extensions::*;
@@ -74,6 +74,20 @@ impl CallIndex {
             call_index: self,
         }
     }
+
+    /// Overrides the call index of an already encoded call in place.
+    /// Same as `self.wrap(call).to_scale()`, without re-encoding the call.
+    pub fn wrap_raw(self, mut call: RawOwned) -> RawOwned {
+        if let Some(call_index) = self.0 {
+            if call.0.len() < 2 {
+                debug_assert!(false, "Encoded call must start with call indices");
+                return RawOwned::default();
+            }
+            call.0[0] = call_index.0;
+            call.0[1] = call_index.1;
+        }
+        call
+    }
 }
 
 /// Wrapper type that combines a SCALE-encodable value with optional call indices.
@@ -96,23 +110,26 @@ impl<T: ToScale> WithCallIndex<T> {
 
 impl<T: ToScale> ToScale for WithCallIndex<T> {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
+        let start = out.len();
+        self.value.to_scale_into(out);
         if let Some(call_index) = &self.call_index.0 {
-            let mut value = self.value.to_scale();
-            if value.len() < 2 {
+            if out.len() - start < 2 {
                 debug_assert!(
                     false,
                     "`WithCallIndex` inner value must include call indices in Scale representation"
                 );
+                out.truncate(start);
                 return;
             }
             // Override the first two bytes with the custom call index.
-            value[0] = call_index.0;
-            value[1] = call_index.1;
-            out.extend(&value);
-        } else {
-            self.value.to_scale_into(out);
+            out[start] = call_index.0;
+            out[start + 1] = call_index.1;
         }
     }
+
+    fn size_hint(&self) -> usize {
+        self.value.size_hint()
+    }
 }
 
 /// Builder pattern implementation for creating Substrate transactions.
@@ -155,7 +172,12 @@ impl TransactionBuilder {
     /// Returns the encoded bytes or a hash of the payload if it exceeds MAX_PAYLOAD_SIZE.
     pub fn encode_payload(&self) -> Result<Vec<u8>, KeyPairError> {
         // SCALE encode the payload that needs to be signed: (call, extensions.data, extensions.signed).
-        let mut payload = self.call.to_scale();
+        let mut payload = Vec::with_capacity(
+            self.call.size_hint()
+                + self.extensions.data.size_hint()
+                + self.extensions.signed.size_hint(),
+        );
+        self.call.to_scale_into(&mut payload);
         self.extensions.data.to_scale_into(&mut payload);
         self.extensions.signed.to_scale_into(&mut payload);
 
@@ -237,24 +259,43 @@ impl ExtrinsicV4 {
     }
 }
 
+impl ExtrinsicV4 {
+    /// Returns the size of the extrinsic without the `Compact<u32>` length prefix.
+    fn body_size_hint(&self) -> usize {
+        1 + self.signature.as_ref().map_or(0, ToScale::size_hint) + self.call.size_hint()
+    }
+}
+
 impl ToScale for ExtrinsicV4 {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
-        // We use a temp buffer here for the `Compact<u32>` length prefix.
-        let mut buf = Vec::with_capacity(512);
+        // The extrinsic is prefixed with its `Compact<u32>` length. It is written from the size hint,
+        // and only rewritten in the unlikely case that the hint is not exact.
+        let expected_len = self.body_size_hint();
+        out.reserve(Compact(expected_len).size_hint() + expected_len);
+        let prefix_start = out.len();
+        Compact(expected_len).to_scale_into(out);
+        let body_start = out.len();
 
         // 1 byte version id and signature if signed.
         match &self.signature {
             Some(sig) => {
-                buf.push(EXTRINSIC_VERSION | SIGNED_EXTRINSIC_BIT);
-                sig.to_scale_into(&mut buf);
+                out.push(EXTRINSIC_VERSION | SIGNED_EXTRINSIC_BIT);
+                sig.to_scale_into(out);
             },
             None => {
-                buf.push(EXTRINSIC_VERSION & UNSIGNED_EXTRINSIC_MASK);
+                out.push(EXTRINSIC_VERSION & UNSIGNED_EXTRINSIC_MASK);
             },
         }
-        self.call.to_scale_into(&mut buf);
+        self.call.to_scale_into(out);
+
+        let len = out.len() - body_start;
+        if len != expected_len {
+            out.splice(prefix_start..body_start, Compact(len).to_scale());
+        }
+    }
 
-        // SCALE encode the tmp buffer to `out`.
-        buf.to_scale_into(out);
+    fn size_hint(&self) -> usize {
+        let body_len = self.body_size_hint();
+        Compact(body_len).size_hint() + body_len
     }
 }
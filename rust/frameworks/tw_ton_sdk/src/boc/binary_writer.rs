@@ -42,25 +42,6 @@ impl BinaryWriter {
         Ok(self)
     }
 
-    /// TODO the function doesn't count `bit_len / 8` count of bytes.
-    /// Original code: https://github.com/ston-fi/tonlib-rs/blob/b96a5252df583261ed755656292930af46c2039a/src/cell.rs#L507-L526
-    pub(crate) fn write_bits(&mut self, data: &[u8], bit_len: usize) -> CellResult<()> {
-        let data_len = data.len();
-        let rest_bits = bit_len % 8;
-        let full_bytes = rest_bits == 0;
-
-        if full_bytes {
-            self.write_bytes(data)?;
-        } else {
-            self.write_bytes(&data[..data_len - 1])?;
-            let last_byte = data[data_len - 1];
-            let l = last_byte | (1 << (8 - rest_bits - 1));
-            self.write(8, l)?;
-        }
-
-        Ok(())
-    }
-
     pub fn bytes_if_aligned(&mut self) -> CellResult<&[u8]> {
         self.writer
             .writer()
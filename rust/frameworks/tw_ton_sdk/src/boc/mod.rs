@@ -4,12 +4,15 @@
 
 //! Original source code: https://github.com/ston-fi/tonlib-rs/blob/b96a5252df583261ed755656292930af46c2039a/src/cell/bag_of_cells.rs
 
-use crate::boc::raw::RawBagOfCells;
+use crate::boc::raw::{RawBagOfCells, RawCell};
 use crate::cell::{Cell, CellArc};
 use crate::error::{CellError, CellErrorType, CellResult};
-use std::sync::Arc;
+use std::collections::HashMap;
+use std::num::NonZeroUsize;
+use std::thread;
 use tw_coin_entry::error::prelude::*;
 use tw_encoding::base64::{self, STANDARD};
+use tw_hash::H256;
 use tw_memory::Data;
 
 pub mod binary_reader;
@@ -19,6 +22,10 @@ pub mod raw;
 
 use boc_to_raw_boc::convert_to_raw_boc;
 
+/// Levels with fewer cells are built on the calling thread:
+/// spawning workers would cost more than hashing the cells.
+const PARALLEL_LEVEL_MIN_CELLS: usize = 256;
+
 #[derive(PartialEq, Eq, Debug, Clone, Hash)]
 pub struct BagOfCells {
     pub roots: Vec<CellArc>,
@@ -44,30 +51,64 @@ impl BagOfCells {
     pub fn parse(serial: &[u8]) -> CellResult<BagOfCells> {
         let raw = RawBagOfCells::parse(serial)?;
         let num_cells = raw.cells.len();
-        let mut cells: Vec<CellArc> = Vec::with_capacity(num_cells);
 
-        for (cell_index, raw_cell) in raw.cells.into_iter().enumerate().rev() {
-            let mut references = Vec::with_capacity(raw_cell.references.len());
+        // Group cells by height. A cell only refers to cells of the previous levels,
+        // so cells of one level are built (and hashed) independently of each other.
+        let mut heights = vec![0_usize; num_cells];
+        let mut levels: Vec<Vec<usize>> = Vec::new();
+        for (cell_index, raw_cell) in raw.cells.iter().enumerate().rev() {
+            let mut height = 0_usize;
             for ref_index in &raw_cell.references {
                 if *ref_index <= cell_index {
                     return CellError::err(CellErrorType::BagOfCellsDeserializationError)
                         .context("References to previous cells are not supported");
                 }
-                let cell_ref_idx = (num_cells - 1)
-                    .checked_sub(*ref_index)
+                let ref_height = heights
+                    .get(*ref_index)
                     .or_tw_err(CellErrorType::BagOfCellsDeserializationError)
                     .context("Cell references to an out-of-bound cell")?;
-                references.push(cells[cell_ref_idx].clone());
+                height = height.max(ref_height + 1);
+            }
+            heights[cell_index] = height;
+            if levels.len() <= height {
+                levels.resize_with(height + 1, Vec::new);
+            }
+            levels[height].push(cell_index);
+        }
+
+        let mut raw_cells: Vec<Option<RawCell>> = raw.cells.into_iter().map(Some).collect();
+        let mut cells: Vec<Option<CellArc>> = vec![None; num_cells];
+        // Identical cells (same representation hash) are only allocated once and shared.
+        let mut unique_cells: HashMap<H256, CellArc> = HashMap::with_capacity(num_cells);
+
+        for level in levels {
+            let mut level_input = Vec::with_capacity(level.len());
+            for cell_index in level.iter() {
+                let raw_cell = raw_cells[*cell_index]
+                    .take()
+                    .or_tw_err(CellErrorType::InternalError)
+                    .context("Cell is built twice")?;
+                let references = raw_cell
+                    .references
+                    .iter()
+                    .map(|ref_index| {
+                        cells[*ref_index]
+                            .clone()
+                            .or_tw_err(CellErrorType::InternalError)
+                            .context("Cell is referenced before it is built")
+                    })
+                    .collect::<CellResult<Vec<_>>>()?;
+                level_input.push((raw_cell, references));
             }
 
-            let cell = Cell::new(
-                raw_cell.data,
-                raw_cell.bit_len,
-                references,
-                raw_cell.is_exotic,
-            )
-            .tw_err(CellErrorType::BagOfCellsDeserializationError)?;
-            cells.push(cell.into_arc());
+            let level_cells = build_cells(level_input)?;
+            for (cell_index, cell) in level.into_iter().zip(level_cells) {
+                let cell = unique_cells
+                    .entry(cell.cell_hash())
+                    .or_insert_with(|| cell.into_arc())
+                    .clone();
+                cells[cell_index] = Some(cell);
+            }
         }
 
         if num_cells < raw.roots.len() {
@@ -78,11 +119,12 @@ impl BagOfCells {
             .roots
             .into_iter()
             .map(|r| {
-                let cell_idx = (num_cells - 1)
-                    .checked_sub(r)
+                cells
+                    .get(r)
+                    .cloned()
+                    .flatten()
                     .or_tw_err(CellErrorType::BagOfCellsDeserializationError)
-                    .context("Root index doesn't correspond to a Cell")?;
-                Ok(Arc::clone(&cells[cell_idx]))
+                    .context("Root index doesn't correspond to a Cell")
             })
             .collect::<CellResult<Vec<_>>>()?;
 
@@ -106,3 +148,65 @@ impl BagOfCells {
         Ok(base64::encode(&encoded, STANDARD))
     }
 }
+
+/// Builds cells that don't refer to each other, on several threads if there are many of them.
+/// Cells are returned in the order of `input`.
+fn build_cells(input: Vec<(RawCell, Vec<CellArc>)>) -> CellResult<Vec<Cell>> {
+    let threads = if cfg!(target_arch = "wasm32") {
+        1
+    } else {
+        thread::available_parallelism().map_or(1, NonZeroUsize::get)
+    };
+    if threads == 1 || input.len() < PARALLEL_LEVEL_MIN_CELLS {
+        return input
+            .into_iter()
+            .map(|(raw_cell, references)| build_cell(raw_cell, references))
+            .collect();
+    }
+
+    // Split the input into a contiguous chunk per thread.
+    let chunk_size = input.len().div_ceil(threads);
+    let mut chunks = Vec::with_capacity(threads);
+    let mut rest = input;
+    while rest.len() > chunk_size {
+        let tail = rest.split_off(chunk_size);
+        chunks.push(rest);
+        rest = tail;
+    }
+    chunks.push(rest);
+
+    thread::scope(|scope| -> CellResult<Vec<Cell>> {
+        let workers: Vec<_> = chunks
+            .into_iter()
+            .map(|chunk| {
+                scope.spawn(move || {
+                    chunk
+                        .into_iter()
+                        .map(|(raw_cell, references)| build_cell(raw_cell, references))
+                        .collect::<CellResult<Vec<_>>>()
+                })
+            })
+            .collect();
+
+        let mut cells = Vec::new();
+        for worker in workers {
+            let chunk_cells = worker
+                .join()
+                .ok()
+                .or_tw_err(CellErrorType::InternalError)
+                .context("Cell builder thread panicked")??;
+            cells.extend(chunk_cells);
+        }
+        Ok(cells)
+    })
+}
+
+fn build_cell(raw_cell: RawCell, references: Vec<CellArc>) -> CellResult<Cell> {
+    Cell::new(
+        raw_cell.data,
+        raw_cell.bit_len,
+        references,
+        raw_cell.is_exotic,
+    )
+    .tw_err(CellErrorType::BagOfCellsDeserializationError)
+}
@@ -4,14 +4,13 @@
 
 //! Original source code: https://github.com/ston-fi/tonlib-rs/blob/b96a5252df583261ed755656292930af46c2039a/src/cell.rs
 
-use crate::boc::binary_writer::BinaryWriter;
 use crate::cell::cell_parser::CellParser;
 use std::fmt;
 use std::sync::Arc;
 use tw_coin_entry::error::prelude::*;
 use tw_encoding::base64::{self, URL_NO_PAD};
 use tw_encoding::hex::ToHex;
-use tw_hash::sha2::sha256;
+use tw_hash::sha2::Sha256Hasher;
 use tw_hash::H256;
 use tw_memory::Data;
 
@@ -164,33 +163,48 @@ impl fmt::Debug for Cell {
     }
 }
 
-fn get_repr_for_data(
+/// Hashes the representation of the cell at the given `level`.
+/// The representation is fed to the hasher piece by piece, so it is never assembled in memory.
+fn get_repr_hash(
     (original_data, original_data_bit_len): (&[u8], usize),
     (data, data_bit_len): (&[u8], usize),
     refs: &[CellArc],
     level_mask: LevelMask,
     level: u8,
     cell_type: CellType,
-) -> CellResult<Data> {
-    // Allocate
-    let data_len = data.len();
-    // descriptors + data + (hash + depth) * refs_count
-    let buffer_len = 2 + data_len + (32 + 2) * refs.len();
-
-    let mut writer = BinaryWriter::with_capacity(buffer_len);
+) -> CellResult<H256> {
     let d1 = get_refs_descriptor(cell_type, refs, level_mask.apply(level).mask())?;
     let d2 = get_bits_descriptor(original_data, original_data_bit_len)?;
 
+    let mut hasher = Sha256Hasher::default();
     // Write descriptors
-    writer.write(8, d1)?;
-    writer.write(8, d2)?;
+    hasher.update(&[d1, d2]);
     // Write main data
-    writer.write_bits(data, data_bit_len)?;
+    write_data_bits(&mut hasher, data, data_bit_len)?;
     // Write ref data
-    write_ref_depths(&mut writer, refs, cell_type, level)?;
-    write_ref_hashes(&mut writer, refs, cell_type, level)?;
+    write_ref_depths(&mut hasher, refs, cell_type, level);
+    write_ref_hashes(&mut hasher, refs, cell_type, level);
+
+    Ok(hasher.finalize())
+}
+
+/// Writes `data`, with the completion tag set in the last byte if it is not full.
+/// TODO the function doesn't count `bit_len / 8` count of bytes.
+/// Original code: https://github.com/ston-fi/tonlib-rs/blob/b96a5252df583261ed755656292930af46c2039a/src/cell.rs#L507-L526
+fn write_data_bits(hasher: &mut Sha256Hasher, data: &[u8], bit_len: usize) -> CellResult<()> {
+    let rest_bits = bit_len % 8;
+    if rest_bits == 0 {
+        hasher.update(data);
+        return Ok(());
+    }
 
-    writer.bytes_if_aligned().map(|b| b.to_vec())
+    let (last_byte, full_bytes) = data
+        .split_last()
+        .or_tw_err(CellErrorType::CellParserError)
+        .context("Cell data is shorter than its bit length")?;
+    hasher.update(full_bytes);
+    hasher.update(&[last_byte | (1 << (8 - rest_bits - 1))]);
+    Ok(())
 }
 
 /// This function replicates unknown logic of resolving cell data
@@ -249,7 +263,7 @@ fn calculate_hashes_and_depths(
         };
 
         // Calculate Hash
-        let repr = get_repr_for_data(
+        let hash = get_repr_hash(
             (data, bit_len),
             (current_data, current_bit_len),
             references,
@@ -257,8 +271,6 @@ fn calculate_hashes_and_depths(
             level_i,
             cell_type,
         )?;
-        let hash = sha256(&repr);
-        let hash = H256::try_from(hash.as_slice()).expect("Expected 32 bytes hash");
 
         depths.push(depth);
         hashes.push(hash);
@@ -314,11 +326,11 @@ fn get_bits_descriptor(data: &[u8], bit_len: usize) -> CellResult<u8> {
 }
 
 fn write_ref_depths(
-    writer: &mut BinaryWriter,
+    hasher: &mut Sha256Hasher,
     refs: &[CellArc],
     parent_cell_type: CellType,
     level: u8,
-) -> CellResult<()> {
+) {
     for reference in refs {
         let child_depth = if matches!(
             parent_cell_type,
@@ -329,19 +341,16 @@ fn write_ref_depths(
             reference.get_depth(level)
         };
 
-        writer.write(8, child_depth / 256)?;
-        writer.write(8, child_depth % 256)?;
+        hasher.update(&child_depth.to_be_bytes());
     }
-
-    Ok(())
 }
 
 fn write_ref_hashes(
-    writer: &mut BinaryWriter,
+    hasher: &mut Sha256Hasher,
     refs: &[CellArc],
     parent_cell_type: CellType,
     level: u8,
-) -> CellResult<()> {
+) {
     for reference in refs {
         let child_hash = if matches!(
             parent_cell_type,
@@ -352,8 +361,6 @@ fn write_ref_hashes(
             reference.get_hash(level)
         };
 
-        writer.write_bytes(child_hash.as_slice())?;
+        hasher.update(child_hash.as_slice());
     }
-
-    Ok(())
 }
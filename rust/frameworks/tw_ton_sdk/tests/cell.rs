@@ -2,7 +2,11 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+use std::sync::Arc;
+use tw_encoding::hex::DecodeHex;
 use tw_ton_sdk::boc::BagOfCells;
+use tw_ton_sdk::cell::cell_builder::CellBuilder;
+use tw_ton_sdk::cell::CellArc;
 
 #[test]
 fn test_cell_format() {
@@ -19,3 +23,56 @@ fn test_cell_format() {
 ";
     assert_eq!(actual_fmt, expected);
 }
+
+#[test]
+fn test_parse_shares_identical_cells() {
+    // Root cell references two identical cells `ab`.
+    let boc = BagOfCells::parse(
+        &"b5ee9c7201010301000a00020001020002ab0002ab"
+            .decode_hex()
+            .unwrap(),
+    )
+    .unwrap();
+    let cell = boc.single_root().unwrap();
+
+    let refs = cell.references();
+    assert_eq!(refs.len(), 2);
+    assert!(Arc::ptr_eq(&refs[0], &refs[1]));
+}
+
+#[test]
+fn test_parse_wide_tree() {
+    // 4-ary tree with 1024 distinct leaves, so that its levels are built in parallel.
+    let mut level: Vec<CellArc> = (0..1024_u32)
+        .map(|i| {
+            let mut builder = CellBuilder::new();
+            builder.store_u32(32, i).unwrap();
+            builder.build().unwrap().into_arc()
+        })
+        .collect();
+    while level.len() > 1 {
+        level = level
+            .chunks(4)
+            .map(|refs| {
+                let mut builder = CellBuilder::new();
+                builder.store_byte(0xab).unwrap();
+                builder.store_references(refs).unwrap();
+                builder.build().unwrap().into_arc()
+            })
+            .collect();
+    }
+    let root = level[0].clone();
+
+    let encoded = BagOfCells::from_root(root.as_ref().clone())
+        .serialize(true)
+        .unwrap();
+    let decoded = BagOfCells::parse(&encoded).unwrap();
+    let decoded_root = decoded.single_root().unwrap();
+    assert_eq!(decoded_root.cell_hash(), root.cell_hash());
+    assert_eq!(decoded_root.get_depth(0), 5);
+
+    let reencoded = BagOfCells::from_root(decoded_root.as_ref().clone())
+        .serialize(true)
+        .unwrap();
+    assert_eq!(reencoded, encoded);
+}
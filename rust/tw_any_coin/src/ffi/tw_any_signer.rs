@@ -6,6 +6,8 @@
 
 use crate::any_signer::AnySigner;
 use tw_coin_registry::coin_type::CoinType;
+use tw_memory::ffi::c_byte_array::CByteArray;
+use tw_memory::ffi::c_byte_array_ref::CByteArrayRef;
 use tw_memory::ffi::tw_data::TWData;
 use tw_memory::ffi::RawPtrTrait;
 use tw_misc::try_or_else;
@@ -39,3 +41,47 @@ pub unsafe extern "C" fn tw_any_signer_plan(input: *const TWData, coin: u32) ->
         .map(|output| TWData::from(output).into_ptr())
         .unwrap_or_else(|_| std::ptr::null_mut())
 }
+
+/// Signs a transaction specified by the signing input borrowed from the caller.
+///
+/// Unlike \tw_any_signer_sign, neither the input nor the output is copied across the FFI boundary:
+/// the input is read in place, and the output buffer ownership is transferred to the caller.
+/// \param input *non-null* byte array of a serialized signing input (e.g. TW.Bitcoin.Proto.SigningInput).
+/// \param input_len the length of the `input` array.
+/// \param coin The given coin type to sign the transaction for.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized `SigningOutput`, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_any_signer_sign_bytes(
+    input: *const u8,
+    input_len: usize,
+    coin: u32,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    AnySigner::sign(input.as_slice(), coin)
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
+
+/// Plans a transaction (for UTXO chains only) specified by the signing input borrowed from the caller.
+///
+/// \param input *non-null* byte array of a serialized signing input.
+/// \param input_len the length of the `input` array.
+/// \param coin The given coin type to plan the transaction for.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized `TransactionPlan`, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_any_signer_plan_bytes(
+    input: *const u8,
+    input_len: usize,
+    coin: u32,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    AnySigner::plan(input.as_slice(), coin)
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
@@ -8,6 +8,8 @@ use crate::message_signer::MessageSigner;
 use crate::TWFFICoinType;
 use tw_coin_registry::coin_type::CoinType;
 use tw_macros::tw_ffi;
+use tw_memory::ffi::c_byte_array::CByteArray;
+use tw_memory::ffi::c_byte_array_ref::CByteArrayRef;
 use tw_memory::ffi::{tw_data::TWData, Nonnull};
 use tw_memory::ffi::{NullableMut, RawPtrTrait};
 use tw_misc::{try_or_else, try_or_false};
@@ -65,3 +67,62 @@ pub unsafe extern "C" fn tw_message_signer_pre_image_hashes(
         .map(|output| TWData::from(output).into_ptr())
         .unwrap_or_else(|_| std::ptr::null_mut())
 }
+
+/// Signs an arbitrary message specified by the signing input borrowed from the caller.
+///
+/// \param coin The given coin type to sign the message for.
+/// \param input *non-null* byte array of a serialized signing input (e.g. TW.Ethereum.Proto.MessageSigningInput).
+/// \param input_len the length of the `input` array.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized `SigningOutput`, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_message_signer_sign_bytes(
+    coin: TWFFICoinType,
+    input: *const u8,
+    input_len: usize,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    MessageSigner::sign_message(input.as_slice(), coin)
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
+
+/// Verifies a signature for a message specified by the verifying input borrowed from the caller.
+///
+/// \param coin The given coin type to verify the message for.
+/// \param input *non-null* byte array of a serialized verifying input (e.g. TW.Ethereum.Proto.MessageVerifyingInput).
+/// \param input_len the length of the `input` array.
+/// \return whether the signature is valid.
+#[no_mangle]
+pub unsafe extern "C" fn tw_message_signer_verify_bytes(
+    coin: TWFFICoinType,
+    input: *const u8,
+    input_len: usize,
+) -> bool {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_false!(CoinType::try_from(coin));
+    MessageSigner::verify_message(input.as_slice(), coin).unwrap_or_default()
+}
+
+/// Computes preimage hashes of a message specified by the signing input borrowed from the caller.
+///
+/// \param coin The given coin type to sign the message for.
+/// \param input *non-null* byte array of a serialized signing input (e.g. TW.Ethereum.Proto.MessageSigningInput).
+/// \param input_len the length of the `input` array.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized TW.TxCompiler.PreSigningOutput, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_message_signer_pre_image_hashes_bytes(
+    coin: TWFFICoinType,
+    input: *const u8,
+    input_len: usize,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    MessageSigner::message_preimage_hashes(input.as_slice(), coin)
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
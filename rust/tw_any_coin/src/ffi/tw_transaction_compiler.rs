@@ -6,6 +6,8 @@
 
 use crate::transaction_compiler::TransactionCompiler;
 use tw_coin_registry::coin_type::CoinType;
+use tw_memory::ffi::c_byte_array::CByteArray;
+use tw_memory::ffi::c_byte_array_ref::CByteArrayRef;
 use tw_memory::ffi::tw_data::TWData;
 use tw_memory::ffi::tw_data_vector::TWDataVector;
 use tw_memory::ffi::RawPtrTrait;
@@ -68,3 +70,65 @@ pub unsafe extern "C" fn tw_transaction_compiler_compile(
     .map(|output| TWData::from(output).into_ptr())
     .unwrap_or_else(|_| std::ptr::null_mut())
 }
+
+/// Obtains pre-signing hashes of a transaction specified by the signing input borrowed from the caller.
+///
+/// \param coin coin type.
+/// \param input *non-null* byte array of a serialized signing input.
+/// \param input_len the length of the `input` array.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized `PreSigningOutput`, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_transaction_compiler_pre_image_hashes_bytes(
+    coin: u32,
+    input: *const u8,
+    input_len: usize,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    TransactionCompiler::preimage_hashes(coin, input.as_slice())
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
+
+/// Compiles a complete transaction with one or more external signatures,
+/// reading the signing input, signatures and public keys in place.
+///
+/// Unlike \tw_transaction_compiler_compile, signatures and public keys are passed as arrays of borrowed
+/// byte arrays, so each of them is copied exactly once.
+/// \param coin coin type.
+/// \param input *non-null* byte array of a serialized signing input.
+/// \param input_len the length of the `input` array.
+/// \param signatures array of signatures to compile.
+/// \param signatures_len the number of items in the `signatures` array.
+/// \param public_keys array of public keys for signers to match private keys.
+/// \param public_keys_len the number of items in the `public_keys` array.
+/// \note Output should be released with \free_c_byte_array.
+/// \return C-compatible byte array of a serialized `SigningOutput`, or a null array on error.
+#[no_mangle]
+pub unsafe extern "C" fn tw_transaction_compiler_compile_bytes(
+    coin: u32,
+    input: *const u8,
+    input_len: usize,
+    signatures: *const CByteArrayRef,
+    signatures_len: usize,
+    public_keys: *const CByteArrayRef,
+    public_keys_len: usize,
+) -> CByteArray {
+    let input = CByteArrayRef::new(input, input_len);
+    let coin = try_or_else!(CoinType::try_from(coin), CByteArray::null);
+
+    let signatures = CByteArrayRef::slice_from_raw_parts(signatures, signatures_len)
+        .iter()
+        .map(|signature| signature.to_vec())
+        .collect();
+    let public_keys = CByteArrayRef::slice_from_raw_parts(public_keys, public_keys_len)
+        .iter()
+        .map(|public_key| public_key.to_vec())
+        .collect();
+
+    TransactionCompiler::compile(coin, input.as_slice(), signatures, public_keys)
+        .map(CByteArray::from)
+        .unwrap_or_else(|_| CByteArray::null())
+}
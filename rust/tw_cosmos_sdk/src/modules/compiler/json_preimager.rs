@@ -11,6 +11,9 @@ use tw_coin_entry::error::prelude::*;
 use tw_hash::hasher::{Hasher, StatefulHasher};
 use tw_memory::Data;
 
+/// Enough for a transaction with a few messages, without reallocating.
+const PREIMAGE_CAPACITY: usize = 1024;
+
 pub struct JsonTxPreimage {
     pub encoded_tx: String,
     pub tx_hash: Data,
@@ -28,11 +31,12 @@ where
         unsigned: &UnsignedTransaction<Context>,
         hasher: Hasher,
     ) -> SigningResult<JsonTxPreimage> {
-        let tx_to_sign = JsonSerializer::build_unsigned_tx(unsigned)?;
-        let encoded_tx = serde_json::to_string(&tx_to_sign)
+        let mut encoded_tx = Vec::with_capacity(PREIMAGE_CAPACITY);
+        JsonSerializer::write_unsigned_tx(unsigned, &mut encoded_tx)?;
+        let tx_hash = hasher.hash(&encoded_tx);
+        let encoded_tx = String::from_utf8(encoded_tx)
             .tw_err(SigningErrorType::Error_internal)
-            .context("Error serializing transaction to sign as JSON")?;
-        let tx_hash = hasher.hash(encoded_tx.as_bytes());
+            .context("Transaction to sign is not a valid UTF-8 JSON")?;
 
         Ok(JsonTxPreimage {
             encoded_tx,
@@ -0,0 +1,712 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+//! Canonical JSON, the form of amino JSON transactions to sign: object keys are sorted,
+//! and there is no whitespace.
+//!
+//! Values are written straight into an [`io::Write`] sink by their [`Serialize`] implementation,
+//! without building a [`serde_json::Value`] tree first. The output is the same as of
+//! `serde_json::to_string(&serde_json::to_value(value)?)`.
+
+use serde::ser::{self, Impossible, Serialize};
+use std::borrow::Cow;
+use std::io;
+use std::ops::Range;
+use tw_coin_entry::error::prelude::*;
+
+/// Writes `value` as canonical JSON into `writer`.
+pub fn to_writer<W, T>(writer: W, value: &T) -> serde_json::Result<()>
+where
+    W: io::Write,
+    T: ?Sized + Serialize,
+{
+    value.serialize(&mut CanonicalSerializer { writer })
+}
+
+/// Serializes `value` as canonical JSON.
+pub fn to_vec<T>(value: &T) -> serde_json::Result<Vec<u8>>
+where
+    T: ?Sized + Serialize,
+{
+    let mut writer = Vec::with_capacity(128);
+    to_writer(&mut writer, value)?;
+    Ok(writer)
+}
+
+/// Serializes `value` as a canonical JSON string.
+pub fn to_string<T>(value: &T) -> serde_json::Result<String>
+where
+    T: ?Sized + Serialize,
+{
+    let bytes = to_vec(value)?;
+    String::from_utf8(bytes).map_err(<serde_json::Error as ser::Error>::custom)
+}
+
+/// Writes a canonical JSON object field by field, for objects that can't be serialized at once.
+/// Fields must be written in the sorted order of their keys.
+pub struct FieldsWriter<'a> {
+    writer: &'a mut dyn io::Write,
+    first: bool,
+}
+
+impl<'a> FieldsWriter<'a> {
+    pub fn begin(writer: &'a mut dyn io::Write) -> SigningResult<Self> {
+        write_all(writer, b"{")?;
+        Ok(FieldsWriter {
+            writer,
+            first: true,
+        })
+    }
+
+    pub fn field<T>(&mut self, key: &str, value: &T) -> SigningResult<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.key(key)?;
+        to_writer(&mut *self.writer, value)
+            .tw_err(SigningErrorType::Error_internal)
+            .with_context(|| format!("Error serializing '{key}' as JSON"))
+    }
+
+    /// Writes a field whose value is written by `write_value`, which must write canonical JSON.
+    pub fn field_with<F>(&mut self, key: &str, write_value: F) -> SigningResult<()>
+    where
+        F: FnOnce(&mut dyn io::Write) -> SigningResult<()>,
+    {
+        self.key(key)?;
+        write_value(&mut *self.writer)
+    }
+
+    pub fn end(self) -> SigningResult<()> {
+        write_all(self.writer, b"}")
+    }
+
+    fn key(&mut self, key: &str) -> SigningResult<()> {
+        if !self.first {
+            write_all(&mut *self.writer, b",")?;
+        }
+        self.first = false;
+        serde_json::to_writer(&mut *self.writer, key)
+            .tw_err(SigningErrorType::Error_internal)
+            .context("Error writing JSON")?;
+        write_all(&mut *self.writer, b":")
+    }
+}
+
+/// Writes `bytes` as they are.
+pub fn write_all(writer: &mut dyn io::Write, bytes: &[u8]) -> SigningResult<()> {
+    writer
+        .write_all(bytes)
+        .tw_err(SigningErrorType::Error_internal)
+        .context("Error writing JSON")
+}
+
+struct CanonicalSerializer<W> {
+    writer: W,
+}
+
+impl<W: io::Write> CanonicalSerializer<W> {
+    fn write_raw(&mut self, bytes: &[u8]) -> serde_json::Result<()> {
+        self.writer.write_all(bytes).map_err(serde_json::Error::io)
+    }
+
+    /// Writes a string or a number the way `serde_json` does.
+    fn write_scalar<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        serde_json::to_writer(&mut self.writer, value)
+    }
+
+    fn begin_variant(&mut self, variant: &str) -> serde_json::Result<()> {
+        self.write_raw(b"{")?;
+        self.write_scalar(variant)?;
+        self.write_raw(b":")
+    }
+}
+
+impl<'a, W: io::Write> ser::Serializer for &'a mut CanonicalSerializer<W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    type SerializeSeq = ArraySerializer<'a, W>;
+    type SerializeTuple = ArraySerializer<'a, W>;
+    type SerializeTupleStruct = ArraySerializer<'a, W>;
+    type SerializeTupleVariant = ArraySerializer<'a, W>;
+    type SerializeMap = ObjectSerializer<'a, W>;
+    type SerializeStruct = ObjectSerializer<'a, W>;
+    type SerializeStructVariant = ObjectSerializer<'a, W>;
+
+    fn serialize_bool(self, v: bool) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_i8(self, v: i8) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_i16(self, v: i16) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_i32(self, v: i32) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_i64(self, v: i64) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_i128(self, v: i128) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_u8(self, v: u8) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_u16(self, v: u16) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_u32(self, v: u32) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_u64(self, v: u64) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_u128(self, v: u128) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_f32(self, v: f32) -> serde_json::Result<()> {
+        // `serde_json::Value` keeps it as `f64`.
+        self.write_scalar(&f64::from(v))
+    }
+
+    fn serialize_f64(self, v: f64) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_char(self, v: char) -> serde_json::Result<()> {
+        self.write_scalar(&v)
+    }
+
+    fn serialize_str(self, v: &str) -> serde_json::Result<()> {
+        self.write_scalar(v)
+    }
+
+    fn serialize_bytes(self, v: &[u8]) -> serde_json::Result<()> {
+        // An array of numbers.
+        self.write_scalar(v)
+    }
+
+    fn serialize_none(self) -> serde_json::Result<()> {
+        self.write_raw(b"null")
+    }
+
+    fn serialize_some<T>(self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        value.serialize(self)
+    }
+
+    fn serialize_unit(self) -> serde_json::Result<()> {
+        self.write_raw(b"null")
+    }
+
+    fn serialize_unit_struct(self, _name: &'static str) -> serde_json::Result<()> {
+        self.write_raw(b"null")
+    }
+
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        variant: &'static str,
+    ) -> serde_json::Result<()> {
+        self.write_scalar(variant)
+    }
+
+    fn serialize_newtype_struct<T>(self, _name: &'static str, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        value.serialize(self)
+    }
+
+    fn serialize_newtype_variant<T>(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        variant: &'static str,
+        value: &T,
+    ) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.begin_variant(variant)?;
+        value.serialize(&mut *self)?;
+        self.write_raw(b"}")
+    }
+
+    fn serialize_seq(self, _len: Option<usize>) -> serde_json::Result<Self::SerializeSeq> {
+        self.write_raw(b"[")?;
+        Ok(ArraySerializer::new(self, b"]"))
+    }
+
+    fn serialize_tuple(self, _len: usize) -> serde_json::Result<Self::SerializeTuple> {
+        self.write_raw(b"[")?;
+        Ok(ArraySerializer::new(self, b"]"))
+    }
+
+    fn serialize_tuple_struct(
+        self,
+        _name: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeTupleStruct> {
+        self.write_raw(b"[")?;
+        Ok(ArraySerializer::new(self, b"]"))
+    }
+
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        variant: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeTupleVariant> {
+        self.begin_variant(variant)?;
+        self.write_raw(b"[")?;
+        Ok(ArraySerializer::new(self, b"]}"))
+    }
+
+    fn serialize_map(self, _len: Option<usize>) -> serde_json::Result<Self::SerializeMap> {
+        Ok(ObjectSerializer::new(self, b"}"))
+    }
+
+    fn serialize_struct(
+        self,
+        _name: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeStruct> {
+        Ok(ObjectSerializer::new(self, b"}"))
+    }
+
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        variant: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeStructVariant> {
+        self.begin_variant(variant)?;
+        Ok(ObjectSerializer::new(self, b"}}"))
+    }
+}
+
+/// Writes array elements as they come.
+struct ArraySerializer<'a, W> {
+    ser: &'a mut CanonicalSerializer<W>,
+    first: bool,
+    close: &'static [u8],
+}
+
+impl<'a, W: io::Write> ArraySerializer<'a, W> {
+    fn new(ser: &'a mut CanonicalSerializer<W>, close: &'static [u8]) -> Self {
+        ArraySerializer {
+            ser,
+            first: true,
+            close,
+        }
+    }
+
+    fn element<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        if !self.first {
+            self.ser.write_raw(b",")?;
+        }
+        self.first = false;
+        value.serialize(&mut *self.ser)
+    }
+
+    fn finish(self) -> serde_json::Result<()> {
+        self.ser.write_raw(self.close)
+    }
+}
+
+impl<W: io::Write> ser::SerializeSeq for ArraySerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_element<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.element(value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+impl<W: io::Write> ser::SerializeTuple for ArraySerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_element<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.element(value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+impl<W: io::Write> ser::SerializeTupleStruct for ArraySerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.element(value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+impl<W: io::Write> ser::SerializeTupleVariant for ArraySerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.element(value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+struct ObjectEntry {
+    key: Cow<'static, str>,
+    /// The serialized value in [`ObjectSerializer::values`].
+    value: Range<usize>,
+}
+
+/// Collects object entries with their values serialized into one buffer,
+/// and writes them in the sorted order of their keys at the end.
+struct ObjectSerializer<'a, W> {
+    ser: &'a mut CanonicalSerializer<W>,
+    entries: Vec<ObjectEntry>,
+    values: Vec<u8>,
+    /// The key of a map entry whose value is serialized next.
+    next_key: Option<String>,
+    close: &'static [u8],
+}
+
+impl<'a, W: io::Write> ObjectSerializer<'a, W> {
+    fn new(ser: &'a mut CanonicalSerializer<W>, close: &'static [u8]) -> Self {
+        ObjectSerializer {
+            ser,
+            entries: Vec::new(),
+            values: Vec::new(),
+            next_key: None,
+            close,
+        }
+    }
+
+    fn entry<T>(&mut self, key: Cow<'static, str>, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        let start = self.values.len();
+        value.serialize(&mut CanonicalSerializer {
+            writer: &mut self.values,
+        })?;
+        self.entries.push(ObjectEntry {
+            key,
+            value: start..self.values.len(),
+        });
+        Ok(())
+    }
+
+    fn finish(mut self) -> serde_json::Result<()> {
+        // The sort is stable: of the entries with the same key, the last one set stays the last.
+        self.entries.sort_by(|a, b| a.key.cmp(&b.key));
+
+        self.ser.write_raw(b"{")?;
+        let mut first = true;
+        for (i, entry) in self.entries.iter().enumerate() {
+            // As in a map, setting a key again replaces the previous value.
+            let replaced = self
+                .entries
+                .get(i + 1)
+                .is_some_and(|next| next.key == entry.key);
+            if replaced {
+                continue;
+            }
+
+            if !first {
+                self.ser.write_raw(b",")?;
+            }
+            first = false;
+            self.ser.write_scalar(entry.key.as_ref())?;
+            self.ser.write_raw(b":")?;
+            self.ser.write_raw(&self.values[entry.value.clone()])?;
+        }
+        self.ser.write_raw(self.close)
+    }
+}
+
+impl<W: io::Write> ser::SerializeMap for ObjectSerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_key<T>(&mut self, key: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.next_key = Some(key.serialize(MapKeySerializer)?);
+        Ok(())
+    }
+
+    fn serialize_value<T>(&mut self, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        let key = self.next_key.take().ok_or_else(|| {
+            <serde_json::Error as ser::Error>::custom("map value is serialized before its key")
+        })?;
+        self.entry(Cow::Owned(key), value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+impl<W: io::Write> ser::SerializeStruct for ObjectSerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T>(&mut self, key: &'static str, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.entry(Cow::Borrowed(key), value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+impl<W: io::Write> ser::SerializeStructVariant for ObjectSerializer<'_, W> {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T>(&mut self, key: &'static str, value: &T) -> serde_json::Result<()>
+    where
+        T: ?Sized + Serialize,
+    {
+        self.entry(Cow::Borrowed(key), value)
+    }
+
+    fn end(self) -> serde_json::Result<()> {
+        self.finish()
+    }
+}
+
+/// Turns map keys into strings, as `serde_json` does.
+struct MapKeySerializer;
+
+fn key_must_be_a_string() -> serde_json::Error {
+    <serde_json::Error as ser::Error>::custom("key must be a string")
+}
+
+impl ser::Serializer for MapKeySerializer {
+    type Ok = String;
+    type Error = serde_json::Error;
+
+    type SerializeSeq = Impossible<String, serde_json::Error>;
+    type SerializeTuple = Impossible<String, serde_json::Error>;
+    type SerializeTupleStruct = Impossible<String, serde_json::Error>;
+    type SerializeTupleVariant = Impossible<String, serde_json::Error>;
+    type SerializeMap = Impossible<String, serde_json::Error>;
+    type SerializeStruct = Impossible<String, serde_json::Error>;
+    type SerializeStructVariant = Impossible<String, serde_json::Error>;
+
+    fn serialize_bool(self, v: bool) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_i8(self, v: i8) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_i16(self, v: i16) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_i32(self, v: i32) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_i64(self, v: i64) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_u8(self, v: u8) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_u16(self, v: u16) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_u32(self, v: u32) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_u64(self, v: u64) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_f32(self, _v: f32) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_f64(self, _v: f64) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_char(self, v: char) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_str(self, v: &str) -> serde_json::Result<String> {
+        Ok(v.to_string())
+    }
+
+    fn serialize_bytes(self, _v: &[u8]) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_none(self) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_some<T>(self, _value: &T) -> serde_json::Result<String>
+    where
+        T: ?Sized + Serialize,
+    {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_unit(self) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_unit_struct(self, _name: &'static str) -> serde_json::Result<String> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        variant: &'static str,
+    ) -> serde_json::Result<String> {
+        Ok(variant.to_string())
+    }
+
+    fn serialize_newtype_struct<T>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> serde_json::Result<String>
+    where
+        T: ?Sized + Serialize,
+    {
+        value.serialize(self)
+    }
+
+    fn serialize_newtype_variant<T>(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        _variant: &'static str,
+        _value: &T,
+    ) -> serde_json::Result<String>
+    where
+        T: ?Sized + Serialize,
+    {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_seq(self, _len: Option<usize>) -> serde_json::Result<Self::SerializeSeq> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_tuple(self, _len: usize) -> serde_json::Result<Self::SerializeTuple> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_tuple_struct(
+        self,
+        _name: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeTupleStruct> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        _variant: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeTupleVariant> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_map(self, _len: Option<usize>) -> serde_json::Result<Self::SerializeMap> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_struct(
+        self,
+        _name: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeStruct> {
+        Err(key_must_be_a_string())
+    }
+
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        _variant_index: u32,
+        _variant: &'static str,
+        _len: usize,
+    ) -> serde_json::Result<Self::SerializeStructVariant> {
+        Err(key_must_be_a_string())
+    }
+}
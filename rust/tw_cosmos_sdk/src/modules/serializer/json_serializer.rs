@@ -3,11 +3,13 @@
 // Copyright © 2017 Trust Wallet.
 
 use crate::context::CosmosContext;
+use crate::modules::serializer::canonical_json::{self, FieldsWriter};
 use crate::private_key::SignatureData;
 use crate::public_key::{CosmosPublicKey, JsonPublicKey};
 use crate::transaction::{Coin, Fee, SignedTransaction, UnsignedTransaction};
 use serde::Serialize;
 use serde_json::Value as Json;
+use std::io;
 use std::marker::PhantomData;
 use tw_coin_entry::error::prelude::*;
 use tw_encoding::base64::Base64Encoded;
@@ -23,19 +25,6 @@ pub struct SignedTxJson {
     pub timeout_height: Option<String>,
 }
 
-#[derive(Serialize)]
-pub struct UnsignedTxJson {
-    pub account_number: String,
-    pub chain_id: String,
-    pub fee: FeeJson,
-    pub memo: String,
-    pub msgs: Vec<AnyMsg<Json>>,
-    pub sequence: String,
-    #[serde(skip_serializing_if = "Option::is_none")]
-    #[serde(default)]
-    pub timeout_height: Option<String>,
-}
-
 #[derive(Serialize)]
 pub struct FeeJson {
     pub amount: Vec<Coin>,
@@ -91,32 +80,37 @@ where
         })
     }
 
-    pub fn build_unsigned_tx(
+    /// Writes the transaction to sign as canonical JSON, with sorted keys: `account_number`, `chain_id`, `fee`,
+    /// `memo`, `msgs`, `sequence` and `timeout_height` if not zero.
+    /// Messages are written directly, without building their JSON trees first.
+    pub fn write_unsigned_tx(
         unsigned: &UnsignedTransaction<Context>,
-    ) -> SigningResult<UnsignedTxJson> {
-        let msgs = unsigned
-            .tx_body
-            .messages
-            .iter()
-            .map(|msg| msg.to_json())
-            .collect::<SigningResult<_>>()?;
-
-        let convert = |value: u64| {
-            if value == 0 {
-                None
-            } else {
-                Some(value.to_string())
+        writer: &mut dyn io::Write,
+    ) -> SigningResult<()> {
+        // Fields in the sorted order.
+        let mut tx = FieldsWriter::begin(writer)?;
+        tx.field("account_number", &unsigned.account_number.to_string())?;
+        tx.field("chain_id", &unsigned.chain_id)?;
+        tx.field("fee", &Self::build_fee(&unsigned.fee))?;
+        tx.field("memo", &unsigned.tx_body.memo)?;
+        tx.field_with("msgs", |writer| {
+            canonical_json::write_all(writer, b"[")?;
+            for (i, msg) in unsigned.tx_body.messages.iter().enumerate() {
+                if i > 0 {
+                    canonical_json::write_all(writer, b",")?;
+                }
+                msg.write_json(writer)?;
             }
-        };
-        Ok(UnsignedTxJson {
-            account_number: unsigned.account_number.to_string(),
-            chain_id: unsigned.chain_id.clone(),
-            fee: Self::build_fee(&unsigned.fee),
-            memo: unsigned.tx_body.memo.clone(),
-            msgs,
-            sequence: unsigned.signer.sequence.to_string(),
-            timeout_height: convert(unsigned.tx_body.timeout_height),
-        })
+            canonical_json::write_all(writer, b"]")
+        })?;
+        tx.field("sequence", &unsigned.signer.sequence.to_string())?;
+        if unsigned.tx_body.timeout_height != 0 {
+            tx.field(
+                "timeout_height",
+                &unsigned.tx_body.timeout_height.to_string(),
+            )?;
+        }
+        tx.end()
     }
 
     pub fn serialize_signature(
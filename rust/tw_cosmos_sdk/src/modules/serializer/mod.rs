@@ -2,5 +2,6 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+pub mod canonical_json;
 pub mod json_serializer;
 pub mod protobuf_serializer;
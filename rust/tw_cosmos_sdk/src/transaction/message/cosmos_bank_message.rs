@@ -5,9 +5,12 @@
 use crate::address::CosmosAddress;
 use crate::modules::serializer::protobuf_serializer::build_coin;
 use crate::proto::cosmos;
-use crate::transaction::message::{message_to_json, CosmosMessage, JsonMessage, ProtobufMessage};
+use crate::transaction::message::{
+    message_to_json, message_write_json, CosmosMessage, JsonMessage, ProtobufMessage,
+};
 use crate::transaction::Coin;
 use serde::Serialize;
+use std::io;
 use tw_coin_entry::error::prelude::*;
 use tw_proto::to_any;
 
@@ -23,6 +26,14 @@ pub struct SendMessage<Address: CosmosAddress> {
     pub amount: Vec<Coin>,
 }
 
+impl<Address: CosmosAddress> SendMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_SEND_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for SendMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::bank::v1beta1::MsgSend {
@@ -34,10 +45,10 @@ impl<Address: CosmosAddress> CosmosMessage for SendMessage<Address> {
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_SEND_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
@@ -5,9 +5,12 @@
 use crate::address::CosmosAddress;
 use crate::modules::serializer::protobuf_serializer::build_coin;
 use crate::proto::cosmos;
-use crate::transaction::message::{message_to_json, CosmosMessage, JsonMessage, ProtobufMessage};
+use crate::transaction::message::{
+    message_to_json, message_write_json, CosmosMessage, JsonMessage, ProtobufMessage,
+};
 use crate::transaction::Coin;
 use serde::Serialize;
+use std::io;
 use tw_coin_entry::error::prelude::*;
 use tw_proto::to_any;
 
@@ -27,6 +30,14 @@ pub struct DelegateMessage<Address: CosmosAddress> {
     pub validator_address: Address,
 }
 
+impl<Address: CosmosAddress> DelegateMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_DELEGATE_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for DelegateMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::staking::v1beta1::MsgDelegate {
@@ -38,11 +49,11 @@ impl<Address: CosmosAddress> CosmosMessage for DelegateMessage<Address> {
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_DELEGATE_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
 
@@ -56,6 +67,14 @@ pub struct UndelegateMessage<Address: CosmosAddress> {
     pub validator_address: Address,
 }
 
+impl<Address: CosmosAddress> UndelegateMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_UNDELEGATE_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for UndelegateMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::staking::v1beta1::MsgUndelegate {
@@ -67,11 +86,11 @@ impl<Address: CosmosAddress> CosmosMessage for UndelegateMessage<Address> {
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_UNDELEGATE_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
 
@@ -86,6 +105,14 @@ pub struct BeginRedelegateMessage<Address: CosmosAddress> {
     pub validator_dst_address: Address,
 }
 
+impl<Address: CosmosAddress> BeginRedelegateMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_BEGIN_REDELEGATE_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for BeginRedelegateMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::staking::v1beta1::MsgBeginRedelegate {
@@ -98,11 +125,11 @@ impl<Address: CosmosAddress> CosmosMessage for BeginRedelegateMessage<Address> {
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_BEGIN_REDELEGATE_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
 
@@ -115,6 +142,14 @@ pub struct WithdrawDelegationRewardMessage<Address: CosmosAddress> {
     pub validator_address: Address,
 }
 
+impl<Address: CosmosAddress> WithdrawDelegationRewardMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_WITHDRAW_REWARDS_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for WithdrawDelegationRewardMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::distribution::v1beta1::MsgWithdrawDelegatorReward {
@@ -125,11 +160,11 @@ impl<Address: CosmosAddress> CosmosMessage for WithdrawDelegationRewardMessage<A
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_WITHDRAW_REWARDS_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
 
@@ -142,6 +177,14 @@ pub struct SetWithdrawAddressMessage<Address: CosmosAddress> {
     pub withdraw_address: Address,
 }
 
+impl<Address: CosmosAddress> SetWithdrawAddressMessage<Address> {
+    fn json_type(&self) -> &str {
+        self.custom_type_prefix
+            .as_deref()
+            .unwrap_or(DEFAULT_JSON_SET_WITHDRAW_ADDRESS_TYPE)
+    }
+}
+
 impl<Address: CosmosAddress> CosmosMessage for SetWithdrawAddressMessage<Address> {
     fn to_proto(&self) -> SigningResult<ProtobufMessage> {
         let proto_msg = cosmos::distribution::v1beta1::MsgSetWithdrawAddress {
@@ -152,10 +195,10 @@ impl<Address: CosmosAddress> CosmosMessage for SetWithdrawAddressMessage<Address
     }
 
     fn to_json(&self) -> SigningResult<JsonMessage> {
-        let msg_type = self
-            .custom_type_prefix
-            .as_deref()
-            .unwrap_or(DEFAULT_JSON_SET_WITHDRAW_ADDRESS_TYPE);
-        message_to_json(msg_type, self)
+        message_to_json(self.json_type(), self)
+    }
+
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        message_write_json(self.json_type(), self, writer)
     }
 }
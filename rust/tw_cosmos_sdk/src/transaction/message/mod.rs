@@ -2,9 +2,11 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+use crate::modules::serializer::canonical_json;
 use crate::modules::serializer::json_serializer::AnyMsg;
 use serde::Serialize;
 use serde_json::Value as Json;
+use std::io;
 use tw_coin_entry::error::prelude::*;
 use tw_proto::google;
 
@@ -43,6 +45,15 @@ pub trait CosmosMessage {
         SigningError::err(SigningErrorType::Error_not_supported)
             .context("Message cannot be converted to JSON")
     }
+
+    /// Writes [`CosmosMessage::to_json`] as canonical JSON.
+    /// Override the method if the message can be written without building its JSON tree first.
+    fn write_json(&self, writer: &mut dyn io::Write) -> SigningResult<()> {
+        let json = self.to_json()?;
+        canonical_json::to_writer(writer, &json)
+            .tw_err(SigningErrorType::Error_internal)
+            .context("Error serializing Cosmos message to JSON")
+    }
 }
 
 /// A standard implementation of the [`CosmosMessage::to_json`] method.
@@ -56,3 +67,27 @@ pub fn message_to_json<T: Serialize>(msg_type: &str, msg: &T) -> SigningResult<J
         value,
     })
 }
+
+/// A standard implementation of the [`CosmosMessage::write_json`] method,
+/// writing the same JSON as [`message_to_json`] directly.
+pub fn message_write_json<T: Serialize>(
+    msg_type: &str,
+    msg: &T,
+    writer: &mut dyn io::Write,
+) -> SigningResult<()> {
+    /// [`JsonMessage`] borrowing its parts.
+    #[derive(Serialize)]
+    struct TypedMessage<'a, T> {
+        #[serde(rename = "type")]
+        msg_type: &'a str,
+        value: &'a T,
+    }
+
+    let json = TypedMessage {
+        msg_type,
+        value: msg,
+    };
+    canonical_json::to_writer(writer, &json)
+        .tw_err(SigningErrorType::Error_internal)
+        .context("Error serializing Cosmos message to JSON")
+}
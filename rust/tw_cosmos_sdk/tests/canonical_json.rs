@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+use serde::Serialize;
+use serde_json::json;
+use std::collections::HashMap;
+use tw_cosmos_sdk::modules::serializer::canonical_json;
+
+#[derive(Serialize)]
+enum Action {
+    Stop,
+    Move { to: String, by: u64 },
+    Wait(u32),
+    Pair(i8, bool),
+}
+
+#[derive(Serialize)]
+struct Coin {
+    denom: String,
+    amount: String,
+}
+
+#[derive(Serialize)]
+struct Message {
+    to_address: String,
+    from_address: String,
+    amount: Vec<Coin>,
+    memo: Option<String>,
+    actions: Vec<Action>,
+    labels: HashMap<u32, &'static str>,
+    #[serde(rename = "$type")]
+    msg_type: &'static str,
+}
+
+/// The output must be the same as of the `serde_json::Value` based serialization.
+#[track_caller]
+fn assert_as_value<T: Serialize>(value: &T) {
+    let expected = serde_json::to_string(&serde_json::to_value(value).unwrap()).unwrap();
+    assert_eq!(canonical_json::to_string(value).unwrap(), expected);
+}
+
+#[test]
+fn test_canonical_json_sorts_keys() {
+    let msg = Message {
+        to_address: "cosmos1to".to_string(),
+        from_address: "cosmos1from \"quoted\" \u{1}".to_string(),
+        amount: vec![Coin {
+            denom: "uatom".to_string(),
+            amount: "1000".to_string(),
+        }],
+        memo: None,
+        actions: vec![
+            Action::Stop,
+            Action::Move {
+                to: "north".to_string(),
+                by: 3,
+            },
+            Action::Wait(10),
+            Action::Pair(-1, true),
+        ],
+        labels: HashMap::from([(10, "ten"), (2, "two"), (33, "thirty three")]),
+        msg_type: "test/Message",
+    };
+    assert_as_value(&msg);
+
+    let actual = canonical_json::to_string(&msg).unwrap();
+    assert!(actual.starts_with(
+        r#"{"$type":"test/Message","actions":["Stop",{"Move":{"by":3,"to":"north"}}"#
+    ));
+    assert!(actual.contains(r#""labels":{"10":"ten","2":"two","33":"thirty three"}"#));
+}
+
+#[test]
+fn test_canonical_json_values() {
+    assert_as_value(&json!({
+        "z": [1, -2, 3.5, null, {"b": true, "a": "x"}],
+        "a": {"nested": {"y": 1, "x": 2}},
+        "": "empty key",
+    }));
+    assert_as_value(&"unicode \u{263a}");
+    assert_as_value(&Vec::<u8>::new());
+    assert_as_value(&(1_u8, "two", [3_u16]));
+}
@@ -4,6 +4,8 @@
 
 use crate::hash_wrapper::hasher;
 use crate::impl_static_hasher;
+use crate::H256;
+use digest::Digest;
 use tw_memory::Data;
 
 pub fn sha224(input: &[u8]) -> Vec<u8> {
@@ -27,6 +29,22 @@ pub fn sha256_d(data: &[u8]) -> Data {
     sha256(&sha256(data))
 }
 
+/// Incremental SHA-256, for input that is available in pieces:
+/// the pieces don't have to be concatenated into one buffer first.
+#[derive(Clone, Default)]
+pub struct Sha256Hasher(sha2::Sha256);
+
+impl Sha256Hasher {
+    pub fn update(&mut self, input: &[u8]) -> &mut Self {
+        Digest::update(&mut self.0, input);
+        self
+    }
+
+    pub fn finalize(self) -> H256 {
+        H256::try_from(Digest::finalize(self.0).as_slice()).expect("Expected 32 bytes hash")
+    }
+}
+
 #[derive(Clone, Debug, Eq, PartialEq)]
 pub struct Sha224;
 impl_static_hasher!(Sha224, sha224, 28);
@@ -4,7 +4,7 @@
 
 /// A C-compatible wrapper over a byte array given as the FFI argument.
 #[repr(C)]
-#[derive(Debug)]
+#[derive(Clone, Copy, Debug)]
 pub struct CByteArrayRef {
     data: *const u8,
     size: usize,
@@ -38,4 +38,20 @@ impl CByteArrayRef {
         }
         std::slice::from_raw_parts(self.data, self.size)
     }
+
+    /// Returns a slice of byte arrays given as the FFI argument.
+    /// Returns an empty slice if `refs` is null.
+    ///
+    /// # Safety
+    ///
+    /// `refs` must point to `len` valid `CByteArrayRef` items.
+    pub unsafe fn slice_from_raw_parts<'a>(
+        refs: *const CByteArrayRef,
+        len: usize,
+    ) -> &'a [CByteArrayRef] {
+        if refs.is_null() {
+            return &[];
+        }
+        std::slice::from_raw_parts(refs, len)
+    }
 }
@@ -8,18 +8,29 @@ pub mod macros;
 ///
 pub trait ToScale {
     fn to_scale(&self) -> Vec<u8> {
-        let mut data = Vec::new();
+        let mut data = Vec::with_capacity(self.size_hint());
         self.to_scale_into(&mut data);
         data
     }
 
     fn to_scale_into(&self, out: &mut Vec<u8>);
+
+    /// Returns the number of bytes that `to_scale_into` appends to the output.
+    /// It is only used to reserve the output buffer, so a type that cannot compute it cheaply
+    /// may return less (`0` by default) at the cost of reallocations.
+    fn size_hint(&self) -> usize {
+        0
+    }
 }
 
 impl ToScale for bool {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         out.push(*self as u8);
     }
+
+    fn size_hint(&self) -> usize {
+        1
+    }
 }
 
 macro_rules! fixed_impl {
@@ -28,6 +39,10 @@ macro_rules! fixed_impl {
             fn to_scale_into(&self, out: &mut Vec<u8>) {
                 out.extend_from_slice(&self.to_le_bytes())
             }
+
+            fn size_hint(&self) -> usize {
+                std::mem::size_of::<$t>()
+            }
         })+
     };
 }
@@ -39,67 +54,83 @@ pub struct Compact<T>(pub T);
 
 // SCALE encoding for common Compact numbers.
 
-impl ToScale for Compact<u8> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
-    }
-}
+macro_rules! compact_impl {
+    ($($t:ty),+) => {
+        $(impl ToScale for Compact<$t> {
+            fn to_scale_into(&self, out: &mut Vec<u8>) {
+                compact_u128_into(self.0 as u128, out)
+            }
 
-impl ToScale for Compact<u16> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
-    }
+            fn size_hint(&self) -> usize {
+                compact_u128_len(self.0 as u128)
+            }
+        })+
+    };
 }
 
-impl ToScale for Compact<u32> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
-    }
-}
+compact_impl!(u8, u16, u32, u64, u128, usize);
 
-impl ToScale for Compact<u64> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
-    }
+const COMPACT_1_BYTE_MAX: u32 = 0b0011_1111;
+const COMPACT_2_BYTE_MAX: u32 = 0b0011_1111_1111_1111;
+const COMPACT_4_BYTE_MAX: u32 = 0b0011_1111_1111_1111_1111_1111_1111_1111;
+
+/// Returns the number of bytes of a big-integer mode value, i.e. of a value above `COMPACT_4_BYTE_MAX`.
+fn compact_big_bytes(bits: usize) -> usize {
+    bits.div_ceil(8)
 }
 
-impl ToScale for Compact<u128> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
+fn compact_u128_into(val: u128, out: &mut Vec<u8>) {
+    match u32::try_from(val) {
+        Ok(val) if val <= COMPACT_1_BYTE_MAX => out.push((val as u8) << 2),
+        Ok(val) if val <= COMPACT_2_BYTE_MAX => (((val as u16) << 2) | 0b01).to_scale_into(out),
+        Ok(val) if val <= COMPACT_4_BYTE_MAX => ((val << 2) | 0b10).to_scale_into(out),
+        _ => {
+            let bytes_needed = compact_big_bytes(128 - val.leading_zeros() as usize);
+            out.push(0b11 + ((bytes_needed - 4) << 2) as u8);
+            out.extend_from_slice(&val.to_le_bytes()[..bytes_needed]);
+        },
     }
 }
 
-impl ToScale for Compact<usize> {
-    fn to_scale_into(&self, out: &mut Vec<u8>) {
-        Compact(U256::from(self.0)).to_scale_into(out)
+fn compact_u128_len(val: u128) -> usize {
+    match u32::try_from(val) {
+        Ok(val) if val <= COMPACT_1_BYTE_MAX => 1,
+        Ok(val) if val <= COMPACT_2_BYTE_MAX => 2,
+        Ok(val) if val <= COMPACT_4_BYTE_MAX => 4,
+        _ => 1 + compact_big_bytes(128 - val.leading_zeros() as usize),
     }
 }
 
-const COMPACT_1_BYTE_MAX: u32 = 0b0011_1111;
-const COMPACT_2_BYTE_MAX: u32 = 0b0011_1111_1111_1111;
-const COMPACT_4_BYTE_MAX: u32 = 0b0011_1111_1111_1111_1111_1111_1111_1111;
-
 impl ToScale for Compact<U256> {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
-        match u32::try_from(self.0) {
-            Ok(val) if val <= COMPACT_1_BYTE_MAX => out.push((val as u8) << 2),
-            Ok(val) if val <= COMPACT_2_BYTE_MAX => (((val as u16) << 2) | 0b01).to_scale_into(out),
-            Ok(val) if val <= COMPACT_4_BYTE_MAX => ((val << 2) | 0b10).to_scale_into(out),
-            _ => {
+        match u128::try_from(self.0) {
+            Ok(val) => compact_u128_into(val, out),
+            Err(_) => {
                 let bytes = self.0.to_little_endian_compact();
                 let bytes_needed = bytes.len();
-                out.reserve(bytes_needed);
+                out.reserve(bytes_needed + 1);
                 out.push(0b11 + ((bytes_needed - 4) << 2) as u8);
                 out.extend_from_slice(&bytes[..]);
             },
         }
     }
+
+    fn size_hint(&self) -> usize {
+        match u128::try_from(self.0) {
+            Ok(val) => compact_u128_len(val),
+            Err(_) => 1 + compact_big_bytes(self.0.bits()),
+        }
+    }
 }
 
 impl<const N: usize> ToScale for Hash<N> {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         out.extend_from_slice(self.as_slice());
     }
+
+    fn size_hint(&self) -> usize {
+        N
+    }
 }
 
 impl<T> ToScale for Option<T>
@@ -114,6 +145,10 @@ where
             out.push(0u8);
         }
     }
+
+    fn size_hint(&self) -> usize {
+        1 + self.as_ref().map_or(0, ToScale::size_hint)
+    }
 }
 
 impl<T> ToScale for &[T]
@@ -126,12 +161,20 @@ where
             ts.to_scale_into(out);
         }
     }
+
+    fn size_hint(&self) -> usize {
+        Compact(self.len()).size_hint() + self.iter().map(ToScale::size_hint).sum::<usize>()
+    }
 }
 
 impl ToScale for String {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         self.as_bytes().to_scale_into(out)
     }
+
+    fn size_hint(&self) -> usize {
+        Compact(self.len()).size_hint() + self.len()
+    }
 }
 
 /// RawOwned is used to wrap data that is already encoded in SCALE format.
@@ -148,6 +191,78 @@ impl ToScale for RawOwned {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         out.extend(&self.0);
     }
+
+    fn size_hint(&self) -> usize {
+        self.0.len()
+    }
+}
+
+/// A sequence of values that are already encoded in SCALE format, stored back to back in one buffer.
+/// It is encoded as `Vec<RawOwned>` would be, without allocating a buffer per value.
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct RawOwnedVec {
+    len: usize,
+    data: Vec<u8>,
+}
+
+impl RawOwnedVec {
+    /// Appends a SCALE-encodable value.
+    pub fn push<T: ToScale>(&mut self, value: &T) {
+        value.to_scale_into(&mut self.data);
+        self.len += 1;
+    }
+
+    /// Appends a value encoded by `encode` into the shared buffer.
+    /// Nothing is appended if `encode` fails.
+    pub fn push_with<E, F>(&mut self, encode: F) -> Result<(), E>
+    where
+        F: FnOnce(&mut Vec<u8>) -> Result<(), E>,
+    {
+        let start = self.data.len();
+        match encode(&mut self.data) {
+            Ok(()) => {
+                self.len += 1;
+                Ok(())
+            },
+            Err(e) => {
+                self.data.truncate(start);
+                Err(e)
+            },
+        }
+    }
+
+    /// Returns the number of values.
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+}
+
+impl From<Vec<RawOwned>> for RawOwnedVec {
+    fn from(values: Vec<RawOwned>) -> Self {
+        let mut data = Vec::with_capacity(values.iter().map(|raw| raw.0.len()).sum());
+        for raw in values.iter() {
+            data.extend_from_slice(&raw.0);
+        }
+        Self {
+            len: values.len(),
+            data,
+        }
+    }
+}
+
+impl ToScale for RawOwnedVec {
+    fn to_scale_into(&self, out: &mut Vec<u8>) {
+        Compact(self.len).to_scale_into(out);
+        out.extend_from_slice(&self.data);
+    }
+
+    fn size_hint(&self) -> usize {
+        Compact(self.len).size_hint() + self.data.len()
+    }
 }
 
 // Implement ToScale for BTreeSet collection.
@@ -161,6 +276,10 @@ where
             ts.to_scale_into(out);
         }
     }
+
+    fn size_hint(&self) -> usize {
+        Compact(self.len()).size_hint() + self.iter().map(ToScale::size_hint).sum::<usize>()
+    }
 }
 
 // Implement ToScale for BTreeMap collection.
@@ -176,6 +295,14 @@ where
             v.to_scale_into(out);
         }
     }
+
+    fn size_hint(&self) -> usize {
+        let items: usize = self
+            .iter()
+            .map(|(k, v)| k.size_hint() + v.size_hint())
+            .sum();
+        Compact(self.len()).size_hint() + items
+    }
 }
 
 // Implement ToScale for Vec collection.
@@ -186,6 +313,10 @@ where
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         self.as_slice().to_scale_into(out)
     }
+
+    fn size_hint(&self) -> usize {
+        self.as_slice().size_hint()
+    }
 }
 
 // Implement ToScale for references to types that implement ToScale.
@@ -193,11 +324,15 @@ impl<T: ToScale> ToScale for &T {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         (*self).to_scale_into(out)
     }
+
+    fn size_hint(&self) -> usize {
+        (*self).size_hint()
+    }
 }
 
 #[cfg(test)]
 mod tests {
-    use super::{Compact, ToScale};
+    use super::{Compact, RawOwned, RawOwnedVec, ToScale};
     use tw_number::U256;
 
     #[test]
@@ -414,6 +549,56 @@ mod tests {
             Compact(U256::from(18446744073709551615u64)).to_scale(),
             &[0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff]
         );
+
+        let mut u256_max = vec![0x73];
+        u256_max.extend_from_slice(&[0xff; 32]);
+        assert_eq!(Compact(U256::MAX).to_scale(), u256_max);
+    }
+
+    #[test]
+    fn test_size_hint() {
+        fn assert_exact<T: ToScale>(value: T) {
+            assert_eq!(value.size_hint(), value.to_scale().len());
+        }
+
+        for shift in 0..128 {
+            assert_exact(Compact(1u128 << shift));
+            assert_exact(Compact((1u128 << shift) - 1));
+            assert_exact(Compact(U256::from(1u128 << shift)));
+        }
+        assert_exact(Compact(U256::MAX));
+        assert_exact(Compact(u64::MAX));
+        assert_exact(true);
+        assert_exact(42u16);
+        assert_exact(Some(Compact(1u64)));
+        assert_exact(None::<u8>);
+        assert_exact(vec![4u16; 100]);
+        assert_exact("hello".to_string());
+        assert_exact(RawOwned(vec![1, 2, 3]));
+        assert_exact(vec![RawOwned(vec![1]), RawOwned(vec![2, 3])]);
+    }
+
+    #[test]
+    fn test_raw_owned_vec() {
+        let raw = vec![RawOwned(vec![1]), RawOwned(vec![2, 3])];
+
+        let mut seq = RawOwnedVec::default();
+        seq.push(&1u8);
+        seq.push_with(|out| {
+            out.extend_from_slice(&[2, 3]);
+            Ok::<_, ()>(())
+        })
+        .unwrap();
+        seq.push_with(|out| {
+            out.push(4);
+            Err(())
+        })
+        .unwrap_err();
+
+        assert_eq!(seq.len(), 2);
+        assert_eq!(seq.to_scale(), raw.to_scale());
+        assert_eq!(RawOwnedVec::from(raw.clone()).to_scale(), raw.to_scale());
+        assert_eq!(seq.size_hint(), raw.to_scale().len());
     }
 
     #[test]
@@ -47,6 +47,10 @@ macro_rules! impl_struct_scale {
       fn to_scale_into(&self, out: &mut Vec<u8>) {
         self.0.to_scale_into(out);
       }
+
+      fn size_hint(&self) -> usize {
+        self.0.size_hint()
+      }
     }
   };
   // Normal named fields struct.
@@ -69,6 +73,10 @@ macro_rules! impl_struct_scale {
       fn to_scale_into(&self, out: &mut Vec<u8>) {
         $(self.$struct_field_name.to_scale_into(out);)+
       }
+
+      fn size_hint(&self) -> usize {
+        0 $(+ self.$struct_field_name.size_hint())+
+      }
     }
   }
 }
@@ -144,6 +152,21 @@ macro_rules! impl_enum_scale {
           )*
         }
       }
+
+      fn size_hint(&self) -> usize {
+        match self {
+          $(
+            Self::$variant_name $(($crate::replace_ident!($variant_tuple_ty p0)))? $({
+              $($variant_field_name),+
+            })? => {
+              // variant index.
+              1
+              $(+ $crate::replace_expr!($variant_tuple_ty p0.size_hint()))?
+              $($(+ $variant_field_name.size_hint())+)?
+            }
+          )*
+        }
+      }
     }
   }
 }
@@ -219,4 +242,22 @@ mod tests {
             &[0x0B, 0x01, 0x02, 0x00]
         );
     }
+
+    #[test]
+    fn test_size_hint() {
+        fn assert_exact<T: ToScale>(value: T) {
+            assert_eq!(value.size_hint(), value.to_scale().len());
+        }
+
+        assert_exact(TestStruct {
+            id: 1,
+            id2: 2,
+            data: vec![3; 70],
+        });
+        assert_exact(TestNewType(1));
+        assert_exact(TestEnum::Variant0);
+        assert_exact(TestEnum::Variant1(2));
+        assert_exact(TestEnum::Struct { id: 1, id2: 2 });
+        assert_exact(TestEnum::StructV2 { id: 1, id2: 2 });
+    }
 }
@@ -236,6 +236,10 @@ impl ToScale for SS58Address {
     fn to_scale_into(&self, out: &mut Vec<u8>) {
         out.extend_from_slice(self.key_bytes())
     }
+
+    fn size_hint(&self) -> usize {
+        self.key_bytes().len()
+    }
 }
 
 impl FromStr for SS58Address {
@@ -3,7 +3,8 @@
 // Copyright © 2017 Trust Wallet.
 
 use tw_any_coin::ffi::tw_message_signer::{
-    tw_message_signer_pre_image_hashes, tw_message_signer_sign, tw_message_signer_verify,
+    tw_message_signer_pre_image_hashes, tw_message_signer_sign, tw_message_signer_sign_bytes,
+    tw_message_signer_verify, tw_message_signer_verify_bytes,
 };
 use tw_coin_entry::error::prelude::*;
 use tw_coin_registry::coin_type::CoinType;
@@ -36,6 +37,34 @@ fn test_tw_message_signer_sign() {
     assert_eq!(output.signature, "21a779d499957e7fd39392d49a079679009e60e492d9654a148829be43d2490736ec72bc4a5644047d979c3cf4ebe2c1c514044cf436b063cb89fc6676be71101b");
 }
 
+#[test]
+fn test_tw_message_signer_sign_bytes() {
+    let input = Ethereum::Proto::MessageSigningInput {
+        private_key: "03a9ca895dca1623c7dfd69693f7b4111f5d819d2e145536e0b03c136025a25d"
+            .decode_hex()
+            .unwrap()
+            .into(),
+        message: "Foo".into(),
+        chain_id: None,
+        message_type: Ethereum::Proto::MessageType::MessageType_legacy,
+    };
+
+    let input_data = serialize(&input).unwrap();
+    let output = unsafe {
+        tw_message_signer_sign_bytes(
+            CoinType::Ethereum as u32,
+            input_data.as_ptr(),
+            input_data.len(),
+        )
+        .into_vec()
+    };
+
+    let output: Ethereum::Proto::MessageSigningOutput = deserialize(&output).unwrap();
+    assert_eq!(output.error, SigningErrorType::OK);
+    assert!(output.error_message.is_empty());
+    assert_eq!(output.signature, "21a779d499957e7fd39392d49a079679009e60e492d9654a148829be43d2490736ec72bc4a5644047d979c3cf4ebe2c1c514044cf436b063cb89fc6676be71101b");
+}
+
 #[test]
 fn test_tw_message_signer_verify() {
     let input = Ethereum::Proto::MessageVerifyingInput {
@@ -49,6 +78,25 @@ fn test_tw_message_signer_verify() {
     assert!(verified);
 }
 
+#[test]
+fn test_tw_message_signer_verify_bytes() {
+    let input = Ethereum::Proto::MessageVerifyingInput {
+        message: "Foo".into(),
+        public_key: "0349d0134ef2c798c02879379a1760baa49c4e25e2324cd128f11e559f073bcc6f".decode_hex().unwrap().into(),
+        signature: "21a779d499957e7fd39392d49a079679009e60e492d9654a148829be43d2490736ec72bc4a5644047d979c3cf4ebe2c1c514044cf436b063cb89fc6676be71101b".into(),
+    };
+
+    let input_data = serialize(&input).unwrap();
+    let verified = unsafe {
+        tw_message_signer_verify_bytes(
+            CoinType::Ethereum as u32,
+            input_data.as_ptr(),
+            input_data.len(),
+        )
+    };
+    assert!(verified);
+}
+
 #[test]
 fn test_tw_message_signer_verify_invalid() {
     let input = Ethereum::Proto::MessageVerifyingInput {
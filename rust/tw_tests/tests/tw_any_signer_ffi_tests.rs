@@ -2,8 +2,15 @@
 //
 // Copyright © 2017 Trust Wallet.
 
-use tw_any_coin::ffi::tw_any_signer::tw_any_signer_sign;
+use tw_any_coin::ffi::tw_any_signer::{tw_any_signer_sign, tw_any_signer_sign_bytes};
+use tw_any_coin::ffi::tw_transaction_compiler::{
+    tw_transaction_compiler_compile, tw_transaction_compiler_compile_bytes,
+    tw_transaction_compiler_pre_image_hashes, tw_transaction_compiler_pre_image_hashes_bytes,
+};
+use tw_coin_registry::coin_type::CoinType;
+use tw_memory::ffi::c_byte_array_ref::CByteArrayRef;
 use tw_memory::test_utils::tw_data_helper::TWDataHelper;
+use tw_memory::test_utils::tw_data_vector_helper::TWDataVectorHelper;
 
 #[test]
 fn test_any_signer_sign_unknown_coin() {
@@ -14,3 +21,99 @@ fn test_any_signer_sign_unknown_coin() {
         TWDataHelper::wrap(unsafe { tw_any_signer_sign(input_data.ptr(), unsupported_coin) });
     assert!(output.is_null());
 }
+
+#[test]
+fn test_any_signer_sign_bytes_unknown_coin() {
+    let unsupported_coin = u32::MAX;
+
+    let input = Vec::new();
+    let output = unsafe { tw_any_signer_sign_bytes(input.as_ptr(), input.len(), unsupported_coin) };
+    assert!(output.data().is_null());
+}
+
+#[test]
+fn test_transaction_compiler_pre_image_hashes_bytes_unknown_coin() {
+    let unsupported_coin = u32::MAX;
+
+    let input = Vec::new();
+    let output = unsafe {
+        tw_transaction_compiler_pre_image_hashes_bytes(
+            unsupported_coin,
+            input.as_ptr(),
+            input.len(),
+        )
+    };
+    assert!(output.data().is_null());
+}
+
+#[test]
+fn test_transaction_compiler_pre_image_hashes_bytes_matches_tw_data() {
+    let coin = CoinType::Ethereum as u32;
+
+    let input = Vec::new();
+    let input_data = TWDataHelper::create(input.clone());
+    let expected = TWDataHelper::wrap(unsafe {
+        tw_transaction_compiler_pre_image_hashes(coin, input_data.ptr())
+    })
+    .to_vec()
+    .expect("!tw_transaction_compiler_pre_image_hashes returned nullptr");
+
+    let output = unsafe {
+        tw_transaction_compiler_pre_image_hashes_bytes(coin, input.as_ptr(), input.len())
+    };
+    assert!(!output.data().is_null());
+    assert_eq!(unsafe { output.as_slice() }, expected.as_slice());
+}
+
+#[test]
+fn test_transaction_compiler_compile_bytes_unknown_coin() {
+    let unsupported_coin = u32::MAX;
+
+    let input = Vec::new();
+    let output = unsafe {
+        tw_transaction_compiler_compile_bytes(
+            unsupported_coin,
+            input.as_ptr(),
+            input.len(),
+            std::ptr::null(),
+            0,
+            std::ptr::null(),
+            0,
+        )
+    };
+    assert!(output.data().is_null());
+}
+
+#[test]
+fn test_transaction_compiler_compile_bytes_matches_tw_data() {
+    let coin = CoinType::Ethereum as u32;
+
+    let input = Vec::new();
+    let signature = vec![1; 65];
+    let public_key = vec![2; 65];
+
+    let input_data = TWDataHelper::create(input.clone());
+    let signatures = TWDataVectorHelper::create([signature.clone()]);
+    let public_keys = TWDataVectorHelper::create([public_key.clone()]);
+    let expected = TWDataHelper::wrap(unsafe {
+        tw_transaction_compiler_compile(coin, input_data.ptr(), signatures.ptr(), public_keys.ptr())
+    })
+    .to_vec()
+    .expect("!tw_transaction_compiler_compile returned nullptr");
+
+    let signature_refs = [CByteArrayRef::new(signature.as_ptr(), signature.len())];
+    let public_key_refs = [CByteArrayRef::new(public_key.as_ptr(), public_key.len())];
+    let output = unsafe {
+        tw_transaction_compiler_compile_bytes(
+            coin,
+            input.as_ptr(),
+            input.len(),
+            signature_refs.as_ptr(),
+            signature_refs.len(),
+            public_key_refs.as_ptr(),
+            public_key_refs.len(),
+        )
+    };
+    assert!(!output.data().is_null());
+    assert_eq!(unsafe { output.as_slice() }, expected.as_slice());
+}
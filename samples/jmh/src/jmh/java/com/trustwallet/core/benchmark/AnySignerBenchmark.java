@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+package com.trustwallet.core.benchmark;
+
+import com.google.protobuf.ByteString;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+
+import java.util.concurrent.TimeUnit;
+
+import wallet.core.java.AnySigner;
+import wallet.core.java.DirectTransactionCompiler;
+import wallet.core.jni.CoinType;
+import wallet.core.jni.TransactionCompiler;
+import wallet.core.jni.proto.Ethereum;
+import wallet.core.jni.proto.TransactionCompiler.PreSigningOutput;
+
+/**
+ * Compares the byte array and the direct buffer entry points on Ethereum transactions carrying `payloadSize` bytes of
+ * contract data. Run with the `gc` profiler (the default here) and compare `gc.alloc.rate.norm`, the bytes allocated
+ * per call, together with the time per call.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+public class AnySignerBenchmark {
+    @Param({"1024", "65536", "1048576"})
+    public int payloadSize;
+
+    private Ethereum.SigningInput input;
+
+    @Setup
+    public void setUp() {
+        System.loadLibrary("TrustWalletCore");
+        byte[] payload = new byte[payloadSize];
+        for (int i = 0; i < payloadSize; ++i) {
+            payload[i] = (byte) i;
+        }
+        input = Ethereum.SigningInput.newBuilder()
+                .setChainId(ByteString.copyFrom(new byte[]{1}))
+                .setNonce(ByteString.copyFrom(new byte[]{9}))
+                .setGasPrice(ByteString.copyFrom(new byte[]{0x04, (byte) 0xa8, 0x17, (byte) 0xc8, 0x00}))
+                .setGasLimit(ByteString.copyFrom(new byte[]{0x52, 0x08}))
+                .setToAddress("0x3535353535353535353535353535353535353535")
+                .setPrivateKey(ByteString.copyFrom(new byte[]{
+                        0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46,
+                        0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46, 0x46}))
+                .setTransaction(Ethereum.Transaction.newBuilder()
+                        .setContractGeneric(Ethereum.Transaction.ContractGeneric.newBuilder()
+                                .setAmount(ByteString.copyFrom(new byte[]{0}))
+                                .setData(ByteString.copyFrom(payload))))
+                .build();
+    }
+
+    @Benchmark
+    public Ethereum.SigningOutput sign() throws Exception {
+        return AnySigner.sign(input, CoinType.ETHEREUM, Ethereum.SigningOutput.parser());
+    }
+
+    @Benchmark
+    public Ethereum.SigningOutput signDirect() throws Exception {
+        return AnySigner.signDirect(input, CoinType.ETHEREUM, Ethereum.SigningOutput.parser());
+    }
+
+    @Benchmark
+    public PreSigningOutput preImageHashes() throws Exception {
+        byte[] output = TransactionCompiler.preImageHashes(CoinType.ETHEREUM, input.toByteArray());
+        return PreSigningOutput.parseFrom(output);
+    }
+
+    @Benchmark
+    public PreSigningOutput preImageHashesDirect() throws Exception {
+        return DirectTransactionCompiler.preImageHashes(CoinType.ETHEREUM, input, PreSigningOutput.parser());
+    }
+}
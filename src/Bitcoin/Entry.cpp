@@ -173,6 +173,22 @@ Data Entry::preImageHashes([[maybe_unused]] TWCoinType coin, const Data& txInput
         txInputData, [](auto&& input, auto&& output) { output = Signer::preImageHashes(input); });
 }
 
+Data Entry::prepareCompileInput([[maybe_unused]] TWCoinType coin, const Data& txInputData) const {
+    Proto::SigningInput input;
+    if (!input.ParseFromArray(txInputData.data(), static_cast<int>(txInputData.size())) ||
+        input.has_plan() || input.has_signing_v2()) {
+        return txInputData;
+    }
+
+    // Select UTXOs once, both pre-image hashes and the compiled transaction will use this plan.
+    const auto plan = Signer::plan(input);
+    if (plan.error() != Common::Proto::OK) {
+        return txInputData;
+    }
+    *input.mutable_plan() = plan;
+    return serializeProto(input);
+}
+
 void Entry::compile([[maybe_unused]] TWCoinType coin, const Data& txInputData, const std::vector<Data>& signatures,
                     const std::vector<PublicKey>& publicKeys, Data& dataOut) const {
     auto txCompilerFunctor = [&signatures, &publicKeys](auto&& input, auto&& output) noexcept {
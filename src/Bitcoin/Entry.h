@@ -27,6 +27,7 @@ public:
     void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const final;
 
     Data preImageHashes(TWCoinType coin, const Data& txInputData) const final;
+    Data prepareCompileInput(TWCoinType coin, const Data& txInputData) const final;
     void compile(TWCoinType coin, const Data& txInputData, const std::vector<Data>& signatures,
                  const std::vector<PublicKey>& publicKeys, Data& dataOut) const final;
     // Note: buildTransactionInput is not implemented for Binance chain with UTXOs
@@ -8,7 +8,7 @@
 #include "Transaction.h"
 #include "TransactionBuilder.h"
 #include "TransactionSigner.h"
-#include "rust/bindgen/WalletCoreRSBindgen.h"
+#include "rust/Wrapper.h"
 
 #include "proto/Common.pb.h"
 
@@ -108,11 +108,10 @@ Proto::TransactionPlan Signer::planAsV2(const Proto::SigningInput& input) noexce
     Proto::TransactionPlan plan;
 
     // Forward the `Bitcoin.Proto.SigningInput.signing_v2` request to Rust.
-    auto signingV2Data = data(input.signing_v2().SerializeAsString());
-    Rust::TWDataWrapper signingV2DataPtr(signingV2Data);
-    Rust::TWDataWrapper transactionPlanV2DataPtr = Rust::tw_any_signer_plan(signingV2DataPtr.get(), input.coin_type());
+    const auto signingV2Data = data(input.signing_v2().SerializeAsString());
+    Rust::CByteArrayWrapper transactionPlanV2DataPtr = Rust::tw_any_signer_plan_bytes(signingV2Data.data(), signingV2Data.size(), input.coin_type());
 
-    auto transactionPlanV2Data = transactionPlanV2DataPtr.toDataOrDefault();
+    const auto& transactionPlanV2Data = transactionPlanV2DataPtr.data;
     BitcoinV2::Proto::TransactionPlan transactionPlanV2;
     transactionPlanV2.ParseFromArray(transactionPlanV2Data.data(), static_cast<int>(transactionPlanV2Data.size()));
 
@@ -123,11 +122,10 @@ Proto::TransactionPlan Signer::planAsV2(const Proto::SigningInput& input) noexce
 
 /// Signs a Proto::SigningInput transaction via BitcoinV2 protocol.
 Proto::SigningOutput Signer::signAsV2(const Proto::SigningInput& input) noexcept {
-    auto signingV2Data = data(input.signing_v2().SerializeAsString());
-    Rust::TWDataWrapper signingV2DataPtr(signingV2Data);
-    Rust::TWDataWrapper signingOutputV2DataPtr = Rust::tw_any_signer_sign(signingV2DataPtr.get(), input.coin_type());
+    const auto signingV2Data = data(input.signing_v2().SerializeAsString());
+    Rust::CByteArrayWrapper signingOutputV2DataPtr = Rust::tw_any_signer_sign_bytes(signingV2Data.data(), signingV2Data.size(), input.coin_type());
 
-    auto signingOutputV2Data = signingOutputV2DataPtr.toDataOrDefault();
+    const auto& signingOutputV2Data = signingOutputV2DataPtr.data;
     BitcoinV2::Proto::SigningOutput signingOutputV2;
     signingOutputV2.ParseFromArray(signingOutputV2Data.data(), static_cast<int>(signingOutputV2Data.size()));
 
@@ -139,11 +137,10 @@ Proto::SigningOutput Signer::signAsV2(const Proto::SigningInput& input) noexcept
 
 /// Collects pre-image hashes to be signed via BitcoinV2 protocol.
 Proto::PreSigningOutput Signer::preImageHashesAsV2(const Proto::SigningInput& input) noexcept {
-    auto signingV2Data = data(input.signing_v2().SerializeAsString());
-    Rust::TWDataWrapper signingV2DataPtr(signingV2Data);
-    Rust::TWDataWrapper preOutputV2DataPtr = Rust::tw_transaction_compiler_pre_image_hashes(input.coin_type(), signingV2DataPtr.get());
+    const auto signingV2Data = data(input.signing_v2().SerializeAsString());
+    Rust::CByteArrayWrapper preOutputV2DataPtr = Rust::tw_transaction_compiler_pre_image_hashes_bytes(input.coin_type(), signingV2Data.data(), signingV2Data.size());
 
-    auto preOutputV2Data = preOutputV2DataPtr.toDataOrDefault();
+    const auto& preOutputV2Data = preOutputV2DataPtr.data;
     BitcoinV2::Proto::PreSigningOutput preSigningOutputV2;
     preSigningOutputV2.ParseFromArray(preOutputV2Data.data(), static_cast<int>(preOutputV2Data.size()));
 
@@ -157,19 +154,21 @@ Proto::PreSigningOutput Signer::preImageHashesAsV2(const Proto::SigningInput& in
 Proto::SigningOutput Signer::compileAsV2(const Proto::SigningInput& input,
                                          const std::vector<Data>& signatures,
                                          const std::vector<PublicKey>& publicKeys) noexcept {
-    Rust::TWDataVectorWrapper signaturesVec = signatures;
-    Rust::TWDataVectorWrapper publicKeysVec;
+    const auto signaturesRefs = Rust::byteArrayRefs(signatures);
+    std::vector<Rust::CByteArrayRef> publicKeysRefs;
+    publicKeysRefs.reserve(publicKeys.size());
     for (const auto& pubkey : publicKeys) {
-        publicKeysVec.push(pubkey.bytes);
+        publicKeysRefs.push_back(Rust::byteArrayRef(pubkey.bytes));
     }
 
     // Forward the `Bitcoin.Proto.SigningInput.signing_v2` request to Rust.
-    auto signingV2Data = data(input.signing_v2().SerializeAsString());
-    Rust::TWDataWrapper signingV2DataPtr(signingV2Data);
-    Rust::TWDataWrapper outputV2DataPtr = Rust::tw_transaction_compiler_compile(
-        input.coin_type(), signingV2DataPtr.get(), signaturesVec.get(), publicKeysVec.get());
+    const auto signingV2Data = data(input.signing_v2().SerializeAsString());
+    Rust::CByteArrayWrapper outputV2DataPtr = Rust::tw_transaction_compiler_compile_bytes(
+        input.coin_type(), signingV2Data.data(), signingV2Data.size(),
+        signaturesRefs.data(), signaturesRefs.size(),
+        publicKeysRefs.data(), publicKeysRefs.size());
 
-    auto outputV2Data = outputV2DataPtr.toDataOrDefault();
+    const auto& outputV2Data = outputV2DataPtr.data;
     BitcoinV2::Proto::SigningOutput outputV2;
     outputV2.ParseFromArray(outputV2Data.data(), static_cast<int>(outputV2Data.size()));
 
@@ -11,33 +11,62 @@
 
 namespace TW::Cardano {
 
+namespace {
+
+/// Visits the elements of a CBOR array in place, keeping the first `N` of them; returns the element count.
+template <std::size_t N>
+std::size_t getArrayElements(const Cbor::Reader& array, std::array<Cbor::Reader, N>& first) {
+    if (array.getMajorType() != Cbor::Decode::MT_array) {
+        throw std::invalid_argument("CBOR data type mismatch");
+    }
+    std::size_t count = 0;
+    for (const auto& elem : array.elements()) {
+        if (count < N) {
+            first[count] = elem;
+        }
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
 bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& attrs_out, byte& type_out) {
     // Decode Bas58, decode payload + crc, decode root, attr
     Data base58decoded = Base58::decode(addr);
-    if (base58decoded.empty()) {
+    if (base58decoded.size() < 2) {
+        return false;
+    }
+    // Reject most non-addresses without parsing: the data is an array of at least 2 elements, the first one tagged.
+    // Arrays of more than 23 elements have their count in the next bytes, and are left to the parser.
+    const auto head = base58decoded[0];
+    if ((head & 0xE0) != 0x80 || head < 0x82 || (head < 0x98 && (base58decoded[1] & 0xE0) != 0xC0)) {
         return false;
     }
-    auto elems = Cbor::Decode(base58decoded).getArrayElements();
-    if (elems.size() < 2) {
+    std::array<Cbor::Reader, 2> elems;
+    if (getArrayElements(Cbor::Reader(base58decoded), elems) < 2) {
         return false;
     }
     auto tag = elems[0].getTagValue();
     if (tag != PayloadTag) {
         return false;
     }
-    Data payload = elems[0].getTagElement().getBytes();
+    const auto payloadBytes = elems[0].getTagElement().getBytes();
+    const Data payload(payloadBytes.begin(), payloadBytes.end());
     uint64_t crcPresent = (uint32_t)elems[1].getValue();
     uint32_t crcComputed = TW::Crc::crc32(payload);
     if (crcPresent != crcComputed) {
         return false;
     }
     // parse payload, 3 elements
-    auto payloadElems = Cbor::Decode(payload).getArrayElements();
-    if (payloadElems.size() < 3) {
+    std::array<Cbor::Reader, 3> payloadElems;
+    if (getArrayElements(Cbor::Reader(payload), payloadElems) < 3) {
         return false;
     }
-    root_out = payloadElems[0].getBytes();
-    attrs_out = payloadElems[1].encoded(); // map, but encoded as bytes
+    const auto root = payloadElems[0].getBytes();
+    root_out = Data(root.begin(), root.end());
+    const auto attrs = payloadElems[1].span(); // map, but encoded as bytes
+    attrs_out = Data(attrs.begin(), attrs.end());
     type_out = (byte)payloadElems[2].getValue();
     return true;
 }
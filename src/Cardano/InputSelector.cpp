@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "InputSelector.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace TW::Cardano {
+
+InputSelector::InputSelector(const std::vector<TxInput>& inputs)
+    : inputs(inputs), isSelected(inputs.size(), false) {
+}
+
+void InputSelector::select(std::size_t index) {
+    isSelected[index] = true;
+    selectedIndices.emplace_back(index);
+}
+
+void InputSelector::selectNative(Amount amount) {
+    std::vector<std::size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    // Stable, so that inputs with equal amounts keep their original order.
+    std::stable_sort(order.begin(), order.end(), [this](auto i1, auto i2) {
+        return inputs[i1].amount > inputs[i2].amount;
+    });
+
+    Amount selectedAmount = 0;
+    for (const auto i : order) {
+        if (isSelected[i]) {
+            continue;
+        }
+        select(i);
+        selectedAmount += inputs[i].amount;
+        if (selectedAmount >= amount) {
+            break;
+        }
+    }
+}
+
+void InputSelector::selectToken(const std::string& key, const uint256_t& amount) {
+    uint256_t selectedAmount = 0;
+    for (const auto i : selectedIndices) {
+        selectedAmount += inputs[i].tokenBundle.getAmount(key);
+    }
+    if (selectedAmount >= amount) {
+        return; // already covered
+    }
+
+    // Only the inputs holding the token are candidates; each amount is looked up once, not on every comparison.
+    std::vector<std::pair<uint256_t, std::size_t>> candidates;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (isSelected[i]) {
+            continue;
+        }
+        auto tokenAmount = inputs[i].tokenBundle.getAmount(key);
+        if (tokenAmount > 0) {
+            candidates.emplace_back(std::move(tokenAmount), i);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](auto&& c1, auto&& c2) {
+        return c1.first > c2.first;
+    });
+
+    for (const auto& [tokenAmount, i] : candidates) {
+        select(i);
+        selectedAmount += tokenAmount;
+        if (selectedAmount >= amount) {
+            return;
+        }
+    }
+    // not enough
+}
+
+std::vector<TxInput> InputSelector::selected() const {
+    std::vector<TxInput> result;
+    result.reserve(selectedIndices.size());
+    for (const auto i : selectedIndices) {
+        result.emplace_back(inputs[i]);
+    }
+    return result;
+}
+
+} // namespace TW::Cardano
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Transaction.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TW::Cardano {
+
+/// Selects UTXOs to cover an ADA amount and token amounts, largest first.
+/// Inputs are referred to by their position, so they are never copied while selecting:
+/// candidates are sorted as indices, and a bitmap tells whether an input is already selected.
+class InputSelector {
+public:
+    /// `inputs` must outlive the selector.
+    explicit InputSelector(const std::vector<TxInput>& inputs);
+
+    /// Selects the inputs with the largest ADA amounts until `amount` is covered.
+    /// At least one input is selected, if there is any.
+    void selectNative(Amount amount);
+
+    /// Selects the inputs holding the most of the token `key` until `amount` of it is covered,
+    /// counting the tokens held by the inputs already selected.
+    void selectToken(const std::string& key, const uint256_t& amount);
+
+    /// The selected inputs, in order of selection.
+    std::vector<TxInput> selected() const;
+
+private:
+    void select(std::size_t index);
+
+    const std::vector<TxInput>& inputs;
+    std::vector<bool> isSelected;
+    std::vector<std::size_t> selectedIndices;
+};
+
+} // namespace TW::Cardano
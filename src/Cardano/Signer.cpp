@@ -4,6 +4,7 @@
 
 #include "Signer.h"
 #include "AddressV3.h"
+#include "InputSelector.h"
 
 #include "Cbor.h"
 #include "Hash.h"
@@ -14,6 +15,7 @@
 #include <cassert>
 #include <cmath>
 #include <numeric>
+#include <unordered_set>
 #include <vector>
 
 namespace TW::Cardano {
@@ -21,6 +23,9 @@ namespace TW::Cardano {
 static const Data placeholderPrivateKey = parse_hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
 static const auto PlaceholderFee = 170000;
 static const auto ExtraInputAmount = 500000;
+// Sizes of the parts of a signature witness: the first half of the extended public key, and the signature
+static constexpr std::size_t PublicKeyHalfSize = 32;
+static constexpr std::size_t SignatureSize = 64;
 
 Proto::SigningOutput Signer::sign() {
     // plan if needed
@@ -68,10 +73,11 @@ Common::Proto::SigningError Signer::buildTransactionAux(Transaction& tx, const P
         // Reject invalid CBOR here, so the signing/planning path returns an error
         // instead of letting Cbor::Encode::fromRaw throw out of the noexcept
         // Signer::sign / Signer::plan entry points (which would call std::terminate).
-        if (!Cbor::Decode(data(input.auxiliary_data())).isValid()) {
+        const auto auxiliaryData = data(input.auxiliary_data());
+        if (!Cbor::Reader(auxiliaryData).isValid()) {
             return Common::Proto::Error_invalid_params;
         }
-        tx.auxiliaryDataHash = Hash::blake2b(data(input.auxiliary_data()), 32);
+        tx.auxiliaryDataHash = Hash::blake2b(auxiliaryData, 32);
     }
 
     if (input.has_register_staking_key()) {
@@ -129,32 +135,8 @@ Data deriveStakingPrivateKey(const Data& privateKeyData) {
     return stakingPrivKeyData;
 }
 
-Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Data, Data>>& signatures, const Proto::SigningInput& input, const TransactionPlan& plan, const Data& txId, bool sizeEstimationOnly) {
-    signatures.clear();
-    // Private keys and corresponding addresses
-    std::map<std::string, Data> privateKeys;
-    for (auto i = 0; i < input.private_key_size(); ++i) {
-        const auto privateKeyData = data(input.private_key(i));
-        if (!PrivateKey::isValid(privateKeyData)) {
-            return Common::Proto::Error_invalid_private_key;
-        }
-
-        // Add this private key and associated address
-        const auto privateKey = PrivateKey(privateKeyData, TWCurveED25519ExtendedCardano);
-        const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Cardano);
-        const auto address = AddressV3(publicKey);
-        privateKeys[address.string()] = privateKeyData;
-
-        const auto legacyAddress = AddressV2(publicKey);
-        privateKeys[legacyAddress.string()] = privateKeyData;
-
-        // Also add the derived staking private key (the 2nd half) and associated address; because staking keys also need signature
-        const auto stakingPrivKeyData = deriveStakingPrivateKey(privateKeyData);
-        if (!stakingPrivKeyData.empty()) {
-            privateKeys[address.getStakingAddress()] = stakingPrivKeyData;
-        }
-    }
-
+// Collect the addresses that need a signature: every unique input UTXO address and staking address, preserving order
+Common::Proto::SigningError collectSigningAddresses(std::vector<std::string>& addressesUnique, const Proto::SigningInput& input, const TransactionPlan& plan) {
     // collect every unique input UTXO address, preserving order
     std::vector<std::string> addresses;
     for (auto& u : plan.utxos) {
@@ -179,14 +161,49 @@ Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Dat
     if (input.has_vote_delegation()) {
         addresses.emplace_back(input.vote_delegation().staking_address());
     }
-    // discard duplicates (std::set, std::copy_if, std::unique does not work well here)
-    std::vector<std::string> addressesUnique;
+    // discard duplicates, preserving order
+    addressesUnique.clear();
+    std::unordered_set<std::string> seen;
     for (auto& a: addresses) {
-        if (find(addressesUnique.begin(), addressesUnique.end(), a) == addressesUnique.end()) {
+        if (seen.insert(a).second) {
             addressesUnique.emplace_back(a);
         }
     }
 
+    return Common::Proto::OK;
+}
+
+Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Data, Data>>& signatures, const Proto::SigningInput& input, const TransactionPlan& plan, const Data& txId, bool sizeEstimationOnly) {
+    signatures.clear();
+    // Private keys and corresponding addresses
+    std::map<std::string, Data> privateKeys;
+    for (auto i = 0; i < input.private_key_size(); ++i) {
+        const auto privateKeyData = data(input.private_key(i));
+        if (!PrivateKey::isValid(privateKeyData)) {
+            return Common::Proto::Error_invalid_private_key;
+        }
+
+        // Add this private key and associated address
+        const auto privateKey = PrivateKey(privateKeyData, TWCurveED25519ExtendedCardano);
+        const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Cardano);
+        const auto address = AddressV3(publicKey);
+        privateKeys[address.string()] = privateKeyData;
+
+        const auto legacyAddress = AddressV2(publicKey);
+        privateKeys[legacyAddress.string()] = privateKeyData;
+
+        // Also add the derived staking private key (the 2nd half) and associated address; because staking keys also need signature
+        const auto stakingPrivKeyData = deriveStakingPrivateKey(privateKeyData);
+        if (!stakingPrivKeyData.empty()) {
+            privateKeys[address.getStakingAddress()] = stakingPrivKeyData;
+        }
+    }
+
+    std::vector<std::string> addressesUnique;
+    if (const auto addressError = collectSigningAddresses(addressesUnique, input, plan); addressError != Common::Proto::OK) {
+        return addressError;
+    }
+
     // create signature for each address
     for (auto& a : addressesUnique) {
         const auto privKeyFind = privateKeys.find(a);
@@ -325,56 +342,14 @@ Common::Proto::SigningError Signer::encodeTransaction(Data& encoded, Data& txId,
     return Common::Proto::OK;
 }
 
-// Select a subset of inputs, to cover desired coin amount. Simple algorithm: pick the largest ones.
-std::vector<TxInput> selectInputsSimpleNative(const std::vector<TxInput>& inputs, Amount amount) {
-    auto ii = std::vector<TxInput>(inputs);
-    sort(ii.begin(), ii.end(), [](auto&& t1, auto&& t2) {
-        return t1.amount > t2.amount;
-    });
-    auto selected = std::vector<TxInput>();
-    Amount selectedAmount = 0;
-
-    for (const auto& i : ii) {
-        selected.emplace_back(i);
-        selectedAmount += i.amount;
-        if (selectedAmount >= amount) {
-            break;
-        }
-    }
-    return selected;
-}
-
-// Select a subset of inputs, to cover desired token amount. Simple algorithm: pick the largest ones.
-void selectInputsSimpleToken(const std::vector<TxInput>& inputs, std::string key, const uint256_t& amount, std::vector<TxInput>& selectedInputs) {
-    auto accumulateFunctor = [key]([[maybe_unused]] auto&& sum, auto&& si) { return si.tokenBundle.getAmount(key); };
-    uint256_t selectedAmount = std::accumulate(selectedInputs.begin(), selectedInputs.end(), uint256_t(0), accumulateFunctor);
-    if (selectedAmount >= amount) {
-        return; // already covered
-    }
-    // sort inputs descending
-    auto ii = std::vector<TxInput>(inputs);
-    std::sort(ii.begin(), ii.end(), [key](auto&& t1, auto&& t2) { return t1.tokenBundle.getAmount(key) > t2.tokenBundle.getAmount(key); });
-    for (const auto& i : ii) {
-        if (static_cast<std::size_t>(distance(selectedInputs.begin(), find(selectedInputs.begin(), selectedInputs.end(), i))) < selectedInputs.size()) {
-            // already selected
-            continue;
-        }
-        selectedInputs.emplace_back(i);
-        selectedAmount += i.amount;
-        if (selectedAmount >= amount) {
-            return;
-        }
-    }
-    // not enough
-}
-
 // Select a subset of inputs, to cover desired amount. Simple algorithm: pick the largest ones
 std::vector<TxInput> Signer::selectInputsWithTokens(const std::vector<TxInput>& inputs, Amount amount, const TokenBundle& requestedTokens) {
-    auto selected = selectInputsSimpleNative(inputs, amount);
-    for (auto&& [_, curAmount] : requestedTokens.bundle) {
-        selectInputsSimpleToken(inputs, curAmount.key(), curAmount.amount, selected);
+    auto selector = InputSelector(inputs);
+    selector.selectNative(amount);
+    for (auto&& [key, curAmount] : requestedTokens.bundle) {
+        selector.selectToken(key, curAmount.amount);
     }
-    return selected;
+    return selector.selected();
 }
 
 // Create a simple plan, used for estimation
@@ -435,24 +410,58 @@ uint64_t sumUndeposits(const Proto::SigningInput& input) {
     return sum;
 }
 
+// Size of the signatures encoded by cborizeSignatures, computed without signing: public keys and signatures have a fixed size.
+std::size_t signaturesSize(std::size_t count, bool addByronSignatures) {
+    constexpr std::size_t shelleySize = 1 + (1 + 1 + PublicKeyHalfSize) + (1 + 1 + SignatureSize);
+    constexpr std::size_t byronSize = shelleySize + (1 + 1 + PublicKeyHalfSize) + (1 + 1);
+    const auto withByron = addByronSignatures && count > 0;
+    auto size = Cbor::Encode::headSize(withByron ? 2 : 1);
+    size += 1 + Cbor::Encode::headSize(count) + count * shelleySize;
+    if (withByron) {
+        size += 1 + Cbor::Encode::headSize(count) + count * byronSize;
+    }
+    return size;
+}
+
 // Estimates size of transaction in bytes.
+// The size is computed from the sizes of the parts, without encoding the transaction or creating signatures;
+// it matches the size of the transaction produced by encodeTransaction.
 uint64_t estimateTxSize(const Proto::SigningInput& input, Amount amount, const TokenBundle& requestedTokens, const std::vector<TxInput>& selectedInputs, const std::vector<TxOutput>& extraOutputs) {
-    auto inputs = std::vector<TxInput>();
-    for (auto i = 0; i < input.utxos_size(); ++i) {
-        inputs.emplace_back(TxInput::fromProto(input.utxos(i)));
-    }
     const auto deposits = sumDeposits(input);
     const uint64_t undeposits = sumUndeposits(input);
     const auto _simplePlan = simplePlan(amount, requestedTokens, selectedInputs, input.transfer_message().use_max_amount(), deposits, undeposits, extraOutputs);
 
-    Data encoded;
-    Data txId;
-    const auto encodeError = Signer::encodeTransaction(encoded, txId, input, _simplePlan, true);
-    if (encodeError != Common::Proto::OK) {
+    Transaction txAux;
+    if (Signer::buildTransactionAux(txAux, input, _simplePlan) != Common::Proto::OK) {
+        return 0;
+    }
+    for (auto i = 0; i < input.private_key_size(); ++i) {
+        if (!PrivateKey::isValid(data(input.private_key(i)))) {
+            return 0;
+        }
+    }
+    // one signature per address, with a placeholder key if the key is missing
+    std::vector<std::string> addresses;
+    if (collectSigningAddresses(addresses, input, _simplePlan) != Common::Proto::OK) {
         return 0;
     }
 
-    return encoded.size();
+    bool hasLegacyUtxos = false;
+    for (const auto& utxo : input.utxos()) {
+        if (AddressV2::isValid(utxo.address())) {
+            hasLegacyUtxos = true;
+            break;
+        }
+    }
+
+    std::size_t count = 3;
+    std::size_t size = txAux.encodedSize() + signaturesSize(addresses.size(), hasLegacyUtxos);
+    if (input.has_vote_delegation()) {
+        ++count;
+        size += Cbor::Encode::headSize(21);
+    }
+    size += input.auxiliary_data().empty() ? 1 : input.auxiliary_data().size();
+    return Cbor::Encode::headSize(count) + size;
 }
 
 // Compute fee from tx size, with some over-estimation
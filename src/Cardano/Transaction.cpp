@@ -251,141 +251,221 @@ Proto::TransactionPlan TransactionPlan::toProto() const {
     return plan;
 }
 
-Cbor::Encode cborizeInputs(const std::vector<OutPoint>& inputs) {
-    // clang-format off
-    std::vector<Cbor::Encode> ii;
+void writeInputs(Cbor::Writer& writer, const std::vector<OutPoint>& inputs) {
+    writer.arrayHead(inputs.size());
     for (const auto& i : inputs) {
-        ii.emplace_back(Cbor::Encode::array({
-            Cbor::Encode::bytes(i.txHash),
-            Cbor::Encode::uint(i.outputIndex)
-        }));
+        writer.arrayHead(2).bytes(i.txHash).uint(i.outputIndex);
     }
-    // clang-format on
-    return Cbor::Encode::array(ii);
 }
 
-Cbor::Encode cborizeOutputAmounts(const Amount& amount, const TokenBundle& tokenBundle) {
+void writeOutputAmounts(Cbor::Writer& writer, const Amount& amount, const TokenBundle& tokenBundle) {
     if (tokenBundle.size() == 0) {
         // native amount only
-        return Cbor::Encode::uint(amount);
+        writer.uint(amount);
+        return;
     }
     // native and token amounts
     // tokens: organized in two levels: by policyId and by assetName
-    const auto policyIds = tokenBundle.getPolicyIds();
-    std::map<Cbor::Encode, Cbor::Encode> tokensMap;
-    for (const auto& policy : policyIds) {
-        const auto& subTokens = tokenBundle.getByPolicyId(policy);
-        std::map<Cbor::Encode, Cbor::Encode> subTokensMap;
-        for (const auto& token : subTokens) {
-            subTokensMap.emplace(
-                Cbor::Encode::bytes(token.assetName),
-                Cbor::Encode::uint(uint64_t(token.amount)) // 64 bits
-            );
+    std::map<std::string, std::vector<const TokenAmount*>> policies;
+    for (const auto& [_, token] : tokenBundle.bundle) {
+        policies[token.policyId].emplace_back(&token);
+    }
+    writer.arrayHead(2).uint(amount);
+    writer.beginMap();
+    for (const auto& [policy, subTokens] : policies) {
+        writer.key().bytes(parse_hex(policy)).value();
+        writer.beginMap();
+        for (const auto* token : subTokens) {
+            writer.key().bytes(token->assetName).value().uint(uint64_t(token->amount)); // 64 bits
         }
-        tokensMap.emplace(
-            Cbor::Encode::bytes(parse_hex(policy)),
-            Cbor::Encode::map(subTokensMap));
+        writer.endMap();
     }
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(amount),
-        Cbor::Encode::map(tokensMap)
-    });
-    // clang-format on
+    writer.endMap();
 }
 
-Cbor::Encode cborizeOutput(const TxOutput& output) {
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::bytes(output.address),
-        cborizeOutputAmounts(output.amount, output.tokenBundle)
-    });
-    // clang-format on
+void writeOutput(Cbor::Writer& writer, const TxOutput& output) {
+    writer.arrayHead(2).bytes(output.address);
+    writeOutputAmounts(writer, output.amount, output.tokenBundle);
 }
 
-Cbor::Encode cborizeOutputs(const std::vector<TxOutput>& outputs) {
-    std::vector<Cbor::Encode> oo;
+void writeOutputs(Cbor::Writer& writer, const std::vector<TxOutput>& outputs) {
+    writer.arrayHead(outputs.size());
     for (const auto& o : outputs) {
-        oo.emplace_back(cborizeOutput(o));
+        writeOutput(writer, o);
     }
-    return Cbor::Encode::array(oo);
 }
 
-Cbor::Encode cborizeCertificateKey(const CertificateKey& certKey) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(certKey.type)));
-    c.emplace_back(Cbor::Encode::bytes(certKey.key));
-    return Cbor::Encode::array(c);
+void writeCertificateKey(Cbor::Writer& writer, const CertificateKey& certKey) {
+    writer.arrayHead(2).uint(static_cast<uint8_t>(certKey.type)).bytes(certKey.key);
 }
 
-Cbor::Encode cborizeDRepKey(const DRepKey& drepKey) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(drepKey.type)));
-    if (drepKey.type == DRepKey::KeyType::AddressKeyHash) {
-        c.emplace_back(Cbor::Encode::bytes(drepKey.key));
+void writeDRepKey(Cbor::Writer& writer, const DRepKey& drepKey) {
+    const auto hasKey = drepKey.type == DRepKey::KeyType::AddressKeyHash;
+    writer.arrayHead(hasKey ? 2 : 1).uint(static_cast<uint8_t>(drepKey.type));
+    if (hasKey) {
+        writer.bytes(drepKey.key);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCert(const Certificate& cert) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(cert.type)));
-    c.emplace_back(cborizeCertificateKey(cert.certKey));
+void writeCert(Cbor::Writer& writer, const Certificate& cert) {
+    writer.arrayHead(2 + (cert.poolId.empty() ? 0 : 1) + (cert.drepKey.has_value() ? 1 : 0));
+    writer.uint(static_cast<uint8_t>(cert.type));
+    writeCertificateKey(writer, cert.certKey);
     if (!cert.poolId.empty()) {
-        c.emplace_back(Cbor::Encode::bytes(cert.poolId));
+        writer.bytes(cert.poolId);
     }
     if (cert.drepKey.has_value()) {
-        c.emplace_back(cborizeDRepKey(cert.drepKey.value()));
+        writeDRepKey(writer, cert.drepKey.value());
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCerts(const std::vector<Certificate>& certs) {
-    std::vector<Cbor::Encode> c;
+void writeCerts(Cbor::Writer& writer, const std::vector<Certificate>& certs) {
+    writer.arrayHead(certs.size());
     for (const auto& i : certs) {
-        c.emplace_back(cborizeCert(i));
+        writeCert(writer, i);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeWithdrawals(const std::vector<Withdrawal>& withdrawals) {
-    std::map<Cbor::Encode, Cbor::Encode> mapElems;
+void writeWithdrawals(Cbor::Writer& writer, const std::vector<Withdrawal>& withdrawals) {
+    writer.beginMap();
     for (const auto& w : withdrawals) {
-        mapElems.emplace(Cbor::Encode::bytes(w.stakingKey), Cbor::Encode::uint(w.amount));
+        writer.key().bytes(w.stakingKey).value().uint(w.amount);
     }
-    return Cbor::Encode::map(mapElems);
+    writer.endMap();
 }
 
 Data Transaction::encode() const {
-    const auto ii = cborizeInputs(inputs);
-    const auto oo = cborizeOutputs(outputs);
+    Cbor::Writer writer(encodedSize());
 
     // Encode elements in a map, with fixed numbers as keys
-    std::map<Cbor::Encode, Cbor::Encode> mapElems = {
-        std::make_pair(Cbor::Encode::uint(0), ii),
-        std::make_pair(Cbor::Encode::uint(1), oo),
-        std::make_pair(Cbor::Encode::uint(2), Cbor::Encode::uint(fee)),
-        std::make_pair(Cbor::Encode::uint(3), Cbor::Encode::uint(ttl)),
-    };
+    writer.beginMap();
+    writer.key().uint(0).value();
+    writeInputs(writer, inputs);
+    writer.key().uint(1).value();
+    writeOutputs(writer, outputs);
+    writer.key().uint(2).value().uint(fee);
+    writer.key().uint(3).value().uint(ttl);
 
     if (!certificates.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(4), cborizeCerts(certificates));
+        writer.key().uint(4).value();
+        writeCerts(writer, certificates);
     }
     if (!withdrawals.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(5), cborizeWithdrawals(withdrawals));
+        writer.key().uint(5).value();
+        writeWithdrawals(writer, withdrawals);
     }
     if (!auxiliaryDataHash.empty()) {
         // Key 7 is auxiliary_data_hash in the Cardano transaction_body (Shelley ledger CDDL).
-        mapElems.emplace(Cbor::Encode::uint(7), Cbor::Encode::bytes(auxiliaryDataHash));
+        writer.key().uint(7).value().bytes(auxiliaryDataHash);
     }
-
-    Cbor::Encode encode = Cbor::Encode::map(mapElems);
-    return encode.encoded();
+    writer.endMap();
+    return writer.release();
 
     // Note: following fields are not included:
     // 8 VALIDITY_INTERVAL_START
 }
 
+// Sizes of the encodings produced by the write* functions, computed without encoding.
+// CBOR heads have a deterministic size, so each size is the sum of the sizes of the parts.
+
+std::size_t bytesSize(std::size_t length) {
+    return Cbor::Encode::headSize(length) + length;
+}
+
+std::size_t inputSize(const OutPoint& input) {
+    return Cbor::Encode::headSize(2) + bytesSize(input.txHash.size()) + Cbor::Encode::headSize(input.outputIndex);
+}
+
+std::size_t outputAmountsSize(const Amount& amount, const TokenBundle& tokenBundle) {
+    if (tokenBundle.size() == 0) {
+        return Cbor::Encode::headSize(amount);
+    }
+    // size of the assets map of each policyId
+    std::map<std::string, std::pair<std::size_t, std::size_t>> policies; // policyId -> (asset count, asset entries size)
+    for (const auto& [_, token] : tokenBundle.bundle) {
+        auto& [count, size] = policies[token.policyId];
+        ++count;
+        size += bytesSize(token.assetName.size()) + Cbor::Encode::headSize(uint64_t(token.amount));
+    }
+    auto tokensSize = Cbor::Encode::headSize(policies.size());
+    for (const auto& [policy, assets] : policies) {
+        tokensSize += bytesSize(parse_hex(policy).size()) + Cbor::Encode::headSize(assets.first) + assets.second;
+    }
+    return Cbor::Encode::headSize(2) + Cbor::Encode::headSize(amount) + tokensSize;
+}
+
+std::size_t outputSize(const TxOutput& output) {
+    return Cbor::Encode::headSize(2) + bytesSize(output.address.size()) + outputAmountsSize(output.amount, output.tokenBundle);
+}
+
+std::size_t certSize(const Certificate& cert) {
+    auto count = 2ul;
+    auto size = Cbor::Encode::headSize(static_cast<uint8_t>(cert.type));
+    size += Cbor::Encode::headSize(2) + Cbor::Encode::headSize(static_cast<uint8_t>(cert.certKey.type)) + bytesSize(cert.certKey.key.size());
+    if (!cert.poolId.empty()) {
+        ++count;
+        size += bytesSize(cert.poolId.size());
+    }
+    if (cert.drepKey.has_value()) {
+        ++count;
+        const auto& drepKey = cert.drepKey.value();
+        const auto hasKey = drepKey.type == DRepKey::KeyType::AddressKeyHash;
+        size += Cbor::Encode::headSize(hasKey ? 2 : 1) + Cbor::Encode::headSize(static_cast<uint8_t>(drepKey.type));
+        if (hasKey) {
+            size += bytesSize(drepKey.key.size());
+        }
+    }
+    return Cbor::Encode::headSize(count) + size;
+}
+
+TransactionSize::TransactionSize(const Transaction& tx)
+    : fee(tx.fee) {
+    otherSize = 1 + Cbor::Encode::headSize(tx.ttl);
+    if (!tx.certificates.empty()) {
+        ++otherCount;
+        otherSize += 1 + Cbor::Encode::headSize(tx.certificates.size());
+        for (const auto& c : tx.certificates) {
+            otherSize += certSize(c);
+        }
+    }
+    if (!tx.withdrawals.empty()) {
+        ++otherCount;
+        // map keys are unique
+        std::set<Data> stakingKeys;
+        auto withdrawalsSize = 0ul;
+        for (const auto& w : tx.withdrawals) {
+            if (stakingKeys.emplace(w.stakingKey).second) {
+                withdrawalsSize += bytesSize(w.stakingKey.size()) + Cbor::Encode::headSize(w.amount);
+            }
+        }
+        otherSize += 1 + Cbor::Encode::headSize(stakingKeys.size()) + withdrawalsSize;
+    }
+    if (!tx.auxiliaryDataHash.empty()) {
+        ++otherCount;
+        otherSize += 1 + bytesSize(tx.auxiliaryDataHash.size());
+    }
+    inputCount = tx.inputs.size();
+    for (const auto& i : tx.inputs) {
+        inputsSize += inputSize(i);
+    }
+    outputCount = tx.outputs.size();
+    for (const auto& o : tx.outputs) {
+        outputsSize += outputSize(o);
+    }
+}
+
+std::size_t TransactionSize::size() const {
+    // keys 0..7 are all encoded on one byte; inputs, outputs, fee and ttl are always present
+    return Cbor::Encode::headSize(4 + otherCount) +
+           1 + Cbor::Encode::headSize(inputCount) + inputsSize +
+           1 + Cbor::Encode::headSize(outputCount) + outputsSize +
+           1 + Cbor::Encode::headSize(fee) + otherSize;
+}
+
+std::size_t Transaction::encodedSize() const {
+    return TransactionSize(*this).size();
+}
+
 Data Transaction::getId() const {
     const auto encoded = encode();
     auto hash = Hash::blake2b(encoded, 32);
@@ -394,7 +474,9 @@ Data Transaction::getId() const {
 
 /// https://github.com/Emurgo/cardano-serialization-lib/blob/78184e0a2c207c2f8bba57b0d3c437f4c808c125/rust/src/utils.rs#L1415
 std::optional<uint64_t> minAdaAmountHelper(const TxOutput& output, uint64_t coinsPerUtxoByte) noexcept {
-    const size_t outputSize = cborizeOutput(output).encoded().size();
+    Cbor::Writer writer;
+    writeOutput(writer, output);
+    const size_t outputSize = writer.encoded().size();
     const auto outputSizeExtended = static_cast<uint64_t>(outputSize + 160);
     if (checkMulUnsignedOverflow(outputSizeExtended, coinsPerUtxoByte)) {
         return std::nullopt;
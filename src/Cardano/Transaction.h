@@ -199,8 +199,29 @@ public:
     // Encode into CBOR binary format
     Data encode() const;
 
+    // Size of the CBOR encoding, computed from the sizes of the parts, without encoding
+    std::size_t encodedSize() const;
+
     // Derive Transaction ID from hashed encoded data
     Data getId() const;
 };
 
+/// Size of the CBOR encoding of a transaction, summed from the sizes of its parts without encoding it.
+class TransactionSize {
+public:
+    explicit TransactionSize(const Transaction& tx);
+
+    std::size_t size() const;
+
+private:
+    std::size_t inputCount = 0;
+    std::size_t inputsSize = 0;
+    std::size_t outputCount = 0;
+    std::size_t outputsSize = 0;
+    Amount fee;
+    /// Number and size of the other map entries: ttl, certificates, withdrawals and auxiliary data hash.
+    std::size_t otherCount = 0;
+    std::size_t otherSize = 0;
+};
+
 } // namespace TW::Cardano
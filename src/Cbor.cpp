@@ -4,9 +4,10 @@
 
 #include "Cbor.h"
 #include "HexCoding.h"
-#include "Numeric.h"
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <cassert>
 
@@ -115,6 +116,22 @@ Encode Encode::fromRaw(const TW::Data& rawData) {
     return Encode(rawData);
 }
 
+std::size_t Encode::headSize(uint64_t value) {
+    if (value < 24) {
+        return 1;
+    }
+    if (value <= 0xFF) {
+        return 1 + 1;
+    }
+    if (value <= 0xFFFF) {
+        return 1 + 2;
+    }
+    if (value <= 0xFFFFFFFF) {
+        return 1 + 4;
+    }
+    return 1 + 8;
+}
+
 Encode Encode::appendValue(byte majorType, uint64_t value) {
     byte byteCount = 0;
     byte minorType = 0;
@@ -151,6 +168,158 @@ void Encode::appendIndefinite(byte majorType) {
 }
 
 
+const Data& Writer::encoded() const {
+    if (!openMaps.empty()) {
+        throw invalid_argument("CBOR Unclosed map");
+    }
+    return _data;
+}
+
+Data Writer::release() {
+    if (!openMaps.empty()) {
+        throw invalid_argument("CBOR Unclosed map");
+    }
+    return std::move(_data);
+}
+
+Writer& Writer::appendValue(byte majorType, uint64_t value) {
+    const auto byteCount = Encode::headSize(value);
+    byte minorType = 0;
+    switch (byteCount) {
+    case 1: minorType = (byte)value; break;
+    case 1 + 1: minorType = 24; break;
+    case 1 + 2: minorType = 25; break;
+    case 1 + 4: minorType = 26; break;
+    default: minorType = 27; break;
+    }
+    _data.push_back((byte)((majorType << 5) | (minorType & 0x1F)));
+    // value bytes, big endian
+    for (auto i = byteCount - 1; i > 0; --i) {
+        _data.push_back((byte)((value >> (8 * (i - 1))) & 0xFF));
+    }
+    return *this;
+}
+
+Writer& Writer::uint(uint64_t value) {
+    return appendValue(Decode::MT_uint, value);
+}
+
+Writer& Writer::negInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow
+        return appendValue(Decode::MT_uint, 0);
+    }
+    return appendValue(Decode::MT_negint, value - 1);
+}
+
+Writer& Writer::string(const std::string& str) {
+    appendValue(Decode::MT_string, str.size());
+    _data.insert(_data.end(), str.begin(), str.end());
+    return *this;
+}
+
+Writer& Writer::bytes(const Data& data) {
+    return bytes(data.data(), data.size());
+}
+
+Writer& Writer::bytes(const byte* data, std::size_t size) {
+    appendValue(Decode::MT_bytes, size);
+    _data.insert(_data.end(), data, data + size);
+    return *this;
+}
+
+Writer& Writer::arrayHead(std::size_t count) {
+    return appendValue(Decode::MT_array, count);
+}
+
+Writer& Writer::tag(uint64_t value) {
+    return appendValue(Decode::MT_tag, value);
+}
+
+Writer& Writer::null() {
+    return appendValue(Decode::MT_special, 0x16);
+}
+
+Writer& Writer::version(uint64_t value) {
+    return appendValue(Decode::MT_special, value);
+}
+
+Writer& Writer::raw(const Data& rawData) {
+    // check validity, may throw
+    Decode check(rawData);
+    if (!check.isValid()) {
+        throw invalid_argument("Invalid CBOR data");
+    }
+    TW::append(_data, rawData);
+    return *this;
+}
+
+Writer& Writer::beginMap() {
+    openMaps.push_back(OpenMap{_data.size(), {}});
+    return *this;
+}
+
+Writer& Writer::key() {
+    if (openMaps.empty()) {
+        throw invalid_argument("CBOR Not inside a map");
+    }
+    openMaps.back().entries.push_back(MapEntry{_data.size(), _data.size()});
+    return *this;
+}
+
+Writer& Writer::value() {
+    if (openMaps.empty() || openMaps.back().entries.empty()) {
+        throw invalid_argument("CBOR Map value without key");
+    }
+    openMaps.back().entries.back().keyEnd = _data.size();
+    return *this;
+}
+
+Writer& Writer::endMap() {
+    if (openMaps.empty()) {
+        throw invalid_argument("CBOR Not inside a map");
+    }
+    auto map = std::move(openMaps.back());
+    openMaps.pop_back();
+    const auto end = _data.size();
+    auto& entries = map.entries;
+    if ((entries.empty() && end != map.start) || (!entries.empty() && entries.front().keyStart != map.start)) {
+        throw invalid_argument("CBOR Map content outside of entries");
+    }
+
+    // Entry `i` spans from its key start to the next entry's key start.
+    std::vector<std::size_t> order(entries.size());
+    for (auto i = 0ul; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    const auto keyLess = [this, &entries](std::size_t i1, std::size_t i2) {
+        return std::lexicographical_compare(
+            _data.begin() + entries[i1].keyStart, _data.begin() + entries[i1].keyEnd,
+            _data.begin() + entries[i2].keyStart, _data.begin() + entries[i2].keyEnd);
+    };
+    std::stable_sort(order.begin(), order.end(), keyLess);
+    // Keep the first written of equal keys.
+    order.erase(std::unique(order.begin(), order.end(), [&keyLess](auto i1, auto i2) { return !keyLess(i1, i2) && !keyLess(i2, i1); }), order.end());
+
+    if (order.size() == entries.size() && std::is_sorted(order.begin(), order.end())) {
+        // Already in order, without duplicates: only the head is missing.
+        Writer head;
+        head.appendValue(Decode::MT_map, order.size());
+        _data.insert(_data.begin() + map.start, head._data.begin(), head._data.end());
+        return *this;
+    }
+
+    Writer sorted(Encode::headSize(order.size()) + end - map.start);
+    sorted.appendValue(Decode::MT_map, order.size());
+    for (const auto i : order) {
+        const auto entryEnd = i + 1 < entries.size() ? entries[i + 1].keyStart : end;
+        sorted._data.insert(sorted._data.end(), _data.begin() + entries[i].keyStart, _data.begin() + entryEnd);
+    }
+    _data.resize(map.start);
+    TW::append(_data, sorted._data);
+    return *this;
+}
+
 Decode::Decode(const Data& input)
 : data(std::make_shared<OrigDataRef>(input)) {
     // shared_ptr to original input data created
@@ -158,6 +327,12 @@ Decode::Decode(const Data& input)
     subLen = (uint32_t)input.size();
 }
 
+Decode::Decode(Data&& input)
+: data(std::make_shared<OrigDataRef>(std::move(input))) {
+    subStart = 0;
+    subLen = (uint32_t)data->origData.size();
+}
+
 Decode::Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubStart, uint32_t nSubLen)
 : data(nData) {
     // shared_ptr to original input data added
@@ -171,343 +346,363 @@ Decode Decode::skipClone(uint32_t offset) const {
     return Decode(data, subStart + offset, subLen - offset);
 }
 
-Decode::TypeDesc Decode::getTypeDesc() const {
-    TypeDesc typeDesc;
-    typeDesc.isIndefiniteValue = false;
-    typeDesc.majorType = (MajorType)(getByte(0) >> 5);
-    assert((int)typeDesc.majorType >= 0 && (int)typeDesc.majorType <= 7);
-    auto minorType = (TW::byte)((uint8_t)getByte(0) & 0x1F);
-    if (minorType < 24) {
-        // direct value
-        typeDesc.byteCount = 1;
-        typeDesc.value = minorType;
-        return typeDesc;
-    }
-    if (minorType == 24) {
-        typeDesc.byteCount = 1 + 1;
-        typeDesc.value = getByte(1);
-        return typeDesc;
-    }
-    if (minorType == 25) {
-        typeDesc.byteCount = 1 + 2;
-        typeDesc.value = (uint16_t)(((uint16_t)getByte(1) << 8) + (uint16_t)getByte(2));
-        return typeDesc;
-    }
-    if (minorType == 26) {
-        typeDesc.byteCount = 1 + 4;
-        typeDesc.value = (uint32_t)(((uint32_t)getByte(1) << 24) + ((uint32_t)getByte(2) << 16) + ((uint32_t)getByte(3) << 8) + (uint32_t)getByte(4));
-        return typeDesc;
-    }
-    if (minorType == 27) {
-        typeDesc.byteCount = 1 + 8;
-        typeDesc.value =
-            (uint64_t)(
-                ((uint64_t)getByte(1) << 56) +
-                ((uint64_t)getByte(2) << 48) +
-                ((uint64_t)getByte(3) << 40) +
-                ((uint64_t)getByte(4) << 32) +
-                ((uint64_t)getByte(5) << 24) +
-                ((uint64_t)getByte(6) << 16) +
-                ((uint64_t)getByte(7) << 8) +
-                ((uint64_t)getByte(8)));
-        return typeDesc;
-    }
-    if (minorType >= 28 && minorType <= 30) {
-        throw std::invalid_argument("CBOR unassigned type not supported");
-    }
-    // minorType == 31
-    // stop code
-    typeDesc.byteCount = 1;
-    typeDesc.value = 0;
-    typeDesc.isIndefiniteValue = true;
-    return typeDesc;
-}
-
-uint32_t Decode::getTotalLen() const {
-    TypeDesc typeDesc = getTypeDesc();
-    switch (typeDesc.majorType) {
-        case MT_uint:
-        case MT_negint:
-        case MT_special:
-            // simple types
-            return typeDesc.byteCount;
-        case MT_bytes:
-        case MT_string:
-            {
-                if (typeDesc.value > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) - typeDesc.byteCount) {
-                    throw std::invalid_argument("CBOR bytes/string length overflow");
-                }
-                return typeDesc.byteCount + static_cast<uint32_t>(typeDesc.value);
-            }
-        case MT_array:
-            return getCompoundLength(1);
-        case MT_map:
-            return getCompoundLength(2);
-        default:
-        case MT_tag:
-            {
-                uint32_t dataLen = skipClone(typeDesc.byteCount).getTotalLen();
-                return typeDesc.byteCount + dataLen;
-            }
-    }
+Reader Decode::reader() const {
+    return Reader(std::span<const byte>(data->origData.data() + subStart, subLen));
+}
+
+bool Decode::isValid() const {
+    return reader().isValid();
 }
 
 Decode::MajorType Decode::getMajorType() const {
-    TypeDesc typeDesc = getTypeDesc();
-    return typeDesc.majorType;
+    return reader().getMajorType();
 }
 
 uint64_t Decode::getValue() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != MT_uint && typeDesc.majorType != MT_negint) {
-        throw std::invalid_argument("CBOR data type not a value-type");
-    }
-    return typeDesc.value;
+    return reader().getValue();
 }
 
 std::string Decode::getString() const {
-    Data strData = getBytes();
-    return std::string((const char*)strData.data(), strData.size()); 
+    return std::string(reader().getString());
 }
 
 Data Decode::getBytes() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != MT_bytes && typeDesc.majorType != MT_string) {
-        throw std::invalid_argument("CBOR data type not bytes/string");
-    }
-    if (typeDesc.value > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) - typeDesc.byteCount) {
-        throw std::invalid_argument("CBOR bytes/string length overflow");
-    }
-    uint32_t requiredLen = typeDesc.byteCount + static_cast<uint32_t>(typeDesc.value);
-    if (length() < requiredLen) {
-        throw std::invalid_argument("CBOR bytes/string data too short");
-    }
-    auto len = (uint32_t)typeDesc.value;
-    assert(subStart + typeDesc.byteCount + len <= data->origData.size());
-    return TW::data(data->origData.data() + (subStart + typeDesc.byteCount), len);
-}
-
-bool Decode::isBreak() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType == MT_special && typeDesc.isIndefiniteValue) { return true; }
-    return false;
+    const auto bytes = reader().getBytes();
+    return Data(bytes.begin(), bytes.end());
 }
 
-uint32_t Decode::getCompoundLength(uint32_t countMultiplier) const {
-    uint32_t len = 0;
-    TypeDesc typeDesc = getTypeDesc();
-    uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    len += typeDesc.byteCount;
-    for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(len);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
-            // end of indefinite-length
-            len += 1; // account for break
-            break;
-        }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (elemLen == 0 || checkAddUnsignedOverflow(len, elemLen)) {
-            throw std::invalid_argument("CBOR invalid element length");
-        }
-        if (len + elemLen > length()) {
-            throw std::invalid_argument("CBOR array data too short");
-        }
-        len += elemLen;
-    }
-    return len;
-}
-
-vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != expectedType) {
+vector<Decode> Decode::getCompoundElements(MajorType expectedType) const {
+    const auto compound = reader();
+    if (compound.getMajorType() != expectedType) {
         throw std::invalid_argument("CBOR data type mismatch");
     }
     vector<Decode> elems;
-    uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    uint32_t idx = typeDesc.byteCount;
-    for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(idx);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
-            // end of indefinite-length
-            break;
-        }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (elemLen == 0 || checkAddUnsignedOverflow(idx, elemLen)) {
-            throw std::invalid_argument("CBOR invalid element length");
-        }
-        if (idx + elemLen > length()) {
-            throw std::invalid_argument("CBOR invalid array data");
-        }
-        elems.emplace_back(Decode(data, subStart + idx, elemLen));
-        idx += elemLen;
+    for (const auto& elem : compound.elements()) {
+        const auto elemStart = static_cast<uint32_t>(elem.span().data() - data->origData.data());
+        elems.emplace_back(Decode(data, elemStart, static_cast<uint32_t>(elem.span().size())));
     }
     return elems;
 }
 
 Decode::MapElements Decode::getMapElements() const {
-    auto elems = getCompoundElements(2, MT_map);
+    auto elems = getCompoundElements(MT_map);
     if (elems.size() % 2 != 0) {
         throw std::invalid_argument("CBOR map with odd number of elements");
     }
     MapElements map;
+    map.reserve(elems.size() / 2);
     for (auto i = 0ul; i < elems.size(); i += 2) {
-        map.emplace_back(make_pair(elems[i], elems[i + 1]));
+        map.emplace_back(make_pair(std::move(elems[i]), std::move(elems[i + 1])));
     }
     return map;
 }
 
 uint64_t Decode::getTagValue() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != MT_tag) {
-        throw std::invalid_argument("CBOR data type not tag");
-    }
-    return typeDesc.value;
+    return reader().getTagValue();
 }
 
 Decode Decode::getTagElement() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != MT_tag) {
+    const auto head = reader().head();
+    if (head.majorType != MT_tag) {
         throw std::invalid_argument("CBOR data type not tag");
     }
-    return skipClone(typeDesc.byteCount);
+    return skipClone(head.byteCount);
 }
 
-bool Decode::isValid() const {
-    try {
-        TypeDesc typeDesc = getTypeDesc();
-        switch (typeDesc.majorType) {
-            case MT_uint:
-            case MT_negint:
-            case MT_special:
-                return (typeDesc.byteCount <= subLen);
-
-            case MT_bytes:
-            case MT_string:
-                {
-                    if (typeDesc.value > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) - typeDesc.byteCount) {
-                        return false;
-                    }
-                    uint32_t len = typeDesc.byteCount + static_cast<uint32_t>(typeDesc.value);
-                    return (len <= subLen);
-                }
+string Decode::dumpToString() const {
+    return reader().dumpToString();
+}
 
-            case MT_array:
-            case MT_map:
-                {
-                    uint32_t countMultiplier = (typeDesc.majorType == MT_map) ? 2 : 1;
-                    uint32_t len = getCompoundLength(countMultiplier);
-                    if (len > subLen) { return false; }
-                    auto count = typeDesc.isIndefiniteValue ? 0 : countMultiplier * typeDesc.value;
-                    uint32_t idx = typeDesc.byteCount;
-                    for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i)
-                    {
-                        Decode nextElem = skipClone(idx);
-                        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) { break; }
-                        if (!nextElem.isValid()) { return false; }
-                        idx += nextElem.getTotalLen();
-                    }
-                    return true;
+Data Decode::encoded() const
+{
+    assert(subStart + subLen <= data->origData.size());
+    return TW::data(data->origData.data() + subStart, subLen);
+}
+
+namespace {
+
+/// Length of an encoded string/bytes item; lengths are limited to 32 bits
+std::size_t stringTotalLen(const Reader::Head& head) {
+    if (head.value > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) - head.byteCount) {
+        throw std::invalid_argument("CBOR bytes/string length overflow");
+    }
+    return head.byteCount + static_cast<std::size_t>(head.value);
+}
+
+} // namespace
+
+Reader::Head Reader::head() const {
+    Head head;
+    head.majorType = (MajorType)(getByte(0) >> 5);
+    const auto minorType = (TW::byte)(getByte(0) & 0x1F);
+    if (minorType < 24) {
+        // direct value
+        head.byteCount = 1;
+        head.value = minorType;
+        return head;
+    }
+    if (minorType <= 27) {
+        // value in the next 1, 2, 4 or 8 bytes, big endian
+        const auto valueSize = (TW::byte)(1 << (minorType - 24));
+        head.byteCount = 1 + valueSize;
+        for (TW::byte i = 1; i <= valueSize; ++i) {
+            head.value = (head.value << 8) | getByte(i);
+        }
+        return head;
+    }
+    if (minorType <= 30) {
+        throw std::invalid_argument("CBOR unassigned type not supported");
+    }
+    // minorType == 31
+    // stop code
+    head.byteCount = 1;
+    head.value = 0;
+    head.isIndefinite = true;
+    return head;
+}
+
+bool Reader::isBreak() const {
+    const auto head = this->head();
+    return head.majorType == Decode::MT_special && head.isIndefinite;
+}
+
+bool Reader::isValid() const {
+    try {
+        const auto head = this->head();
+        switch (head.majorType) {
+            case Decode::MT_uint:
+            case Decode::MT_negint:
+            case Decode::MT_special:
+                return head.byteCount <= data.size();
+
+            case Decode::MT_bytes:
+            case Decode::MT_string:
+                return stringTotalLen(head) <= data.size();
+
+            case Decode::MT_array:
+            case Decode::MT_map:
+                // each element is checked to fit while iterating
+                for (const auto& elem : elements()) {
+                    if (!elem.isValid()) { return false; }
                 }
+                return true;
 
             default:
-            case MT_tag:
-                return skipClone(typeDesc.byteCount).isValid();
+            case Decode::MT_tag:
+                return getTagElement().isValid();
         }
     } catch (exception& ex) {
         return false;
     }
 }
 
-string Decode::dumpToStringInternal() const {
-    stringstream s;
-    TypeDesc typeDesc = getTypeDesc();
-    switch (typeDesc.majorType) {
-        case MT_uint:
-            s << typeDesc.value;
+uint64_t Reader::getValue() const {
+    const auto head = this->head();
+    if (head.majorType != Decode::MT_uint && head.majorType != Decode::MT_negint) {
+        throw std::invalid_argument("CBOR data type not a value-type");
+    }
+    return head.value;
+}
+
+std::span<const byte> Reader::getBytes() const {
+    const auto head = this->head();
+    if (head.majorType != Decode::MT_bytes && head.majorType != Decode::MT_string) {
+        throw std::invalid_argument("CBOR data type not bytes/string");
+    }
+    if (stringTotalLen(head) > data.size()) {
+        throw std::invalid_argument("CBOR bytes/string data too short");
+    }
+    return data.subspan(head.byteCount, static_cast<std::size_t>(head.value));
+}
+
+std::string_view Reader::getString() const {
+    const auto bytes = getBytes();
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+Reader::Elements Reader::elements() const {
+    const auto majorType = getMajorType();
+    if (majorType != Decode::MT_array && majorType != Decode::MT_map) {
+        throw std::invalid_argument("CBOR data type mismatch");
+    }
+    return Elements(data);
+}
+
+uint64_t Reader::getTagValue() const {
+    const auto head = this->head();
+    if (head.majorType != Decode::MT_tag) {
+        throw std::invalid_argument("CBOR data type not tag");
+    }
+    return head.value;
+}
+
+Reader Reader::getTagElement() const {
+    const auto head = this->head();
+    if (head.majorType != Decode::MT_tag) {
+        throw std::invalid_argument("CBOR data type not tag");
+    }
+    return Reader(data.subspan(head.byteCount));
+}
+
+std::size_t Reader::getTotalLen() const {
+    const auto head = this->head();
+    switch (head.majorType) {
+        case Decode::MT_uint:
+        case Decode::MT_negint:
+        case Decode::MT_special:
+            // simple types
+            return head.byteCount;
+        case Decode::MT_bytes:
+        case Decode::MT_string:
+            return stringTotalLen(head);
+        case Decode::MT_array:
+        case Decode::MT_map:
+            {
+                auto it = elements().begin();
+                while (it != std::default_sentinel) {
+                    ++it;
+                }
+                // account for the break, if indefinite-length
+                return it.offset + (it.isIndefinite ? 1 : 0);
+            }
+        default:
+        case Decode::MT_tag:
+            return head.byteCount + getTagElement().getTotalLen();
+    }
+}
+
+Reader::Iterator::Iterator(std::span<const byte> compound)
+: compound(compound) {
+    const auto head = Reader(compound).head();
+    isIndefinite = head.isIndefinite;
+    offset = head.byteCount;
+    if (!isIndefinite) {
+        // Every element takes at least one byte; bounding the count here also keeps it from overflowing.
+        if (head.value > compound.size()) {
+            throw std::invalid_argument("CBOR array data too short");
+        }
+        remaining = head.value * (head.majorType == Decode::MT_map ? 2 : 1);
+    }
+    load();
+}
+
+void Reader::Iterator::load() {
+    if (!isIndefinite && remaining == 0) {
+        done = true;
+        return;
+    }
+    const Reader next(compound.subspan(offset));
+    if (isIndefinite && next.isBreak()) {
+        // end of indefinite-length
+        done = true;
+        return;
+    }
+    const auto elemLen = next.getTotalLen();
+    if (elemLen > compound.size() - offset) {
+        throw std::invalid_argument("CBOR array data too short");
+    }
+    current = Reader(compound.subspan(offset, elemLen));
+}
+
+Reader::Iterator& Reader::Iterator::operator++() {
+    offset += current.data.size();
+    if (!isIndefinite) {
+        --remaining;
+    }
+    load();
+    return *this;
+}
+
+namespace {
+
+void dumpItem(const Reader& item, stringstream& s) {
+    const auto head = item.head();
+    switch (head.majorType) {
+        case Decode::MT_uint:
+            s << head.value;
             break;
 
-        case MT_negint:
-            s << (int64_t)-1 - (int64_t)typeDesc.value;
+        case Decode::MT_negint:
+            s << (int64_t)-1 - (int64_t)head.value;
             break;
 
-        case MT_bytes:
-            s << "h\"" << TW::hex(getString()) << "\"";
+        case Decode::MT_bytes:
+            s << "h\"" << TW::hex(item.getBytes()) << "\"";
             break;
 
-        case MT_string:
+        case Decode::MT_string:
             {
-                auto str = getString();
-                if (!Rust::tw_string_is_utf8_bytes(reinterpret_cast<const uint8_t*>(str.data()), str.size())) {
+                const auto bytes = item.getBytes();
+                if (!Rust::tw_string_is_utf8_bytes(bytes.data(), bytes.size())) {
                     throw std::invalid_argument("CBOR string is not valid UTF-8");
                 }
-                s << "\"" << str << "\"";
+                s << "\"" << item.getString() << "\"";
             }
             break;
 
-        case MT_array:
+        case Decode::MT_array:
             {
-                if (typeDesc.isIndefiniteValue) {
+                if (head.isIndefinite) {
                     s << "[_ ";
                 } else {
                     s << "[";
                 }
-                vector<Decode> elems = getArrayElements();
-                for (auto i = 0ul; i < elems.size(); ++i) {
-                    if (i > 0) s << ", ";
-                    s << elems[i].dumpToStringInternal();
+                auto first = true;
+                for (const auto& elem : item.elements()) {
+                    if (!first) s << ", ";
+                    first = false;
+                    dumpItem(elem, s);
                 }
                 s << "]";
             }
             break;
 
-        case MT_map:
+        case Decode::MT_map:
             {
-                if (typeDesc.isIndefiniteValue) {
+                if (head.isIndefinite) {
                     s << "{_ ";
                 } else {
                     s << "{";
                 }
-                auto elems = getMapElements();
-                for (auto i = 0ul; i < elems.size(); ++i) {
-                    if (i > 0) s << ", ";
-                    s << elems[i].first.dumpToStringInternal() << ": " << elems[i].second.dumpToStringInternal();
+                std::size_t count = 0;
+                for (const auto& elem : item.elements()) {
+                    if (count > 0) s << (count % 2 == 0 ? ", " : ": ");
+                    ++count;
+                    dumpItem(elem, s);
+                }
+                if (count % 2 != 0) {
+                    throw std::invalid_argument("CBOR map with odd number of elements");
                 }
                 s << "}";
             }
             break;
 
-        case MT_tag:
-            s << "tag " << typeDesc.value << " " << getTagElement().dumpToStringInternal();
+        case Decode::MT_tag:
+            s << "tag " << head.value << " ";
+            dumpItem(item.getTagElement(), s);
             break;
 
         default:
-        case MT_special: // float or simple
-            if (typeDesc.isIndefiniteValue) {
+        case Decode::MT_special: // float or simple
+            if (head.isIndefinite) {
                 // skip break command
             } else {
-                if (typeDesc.value == 0x16) {
+                if (head.value == 0x16) {
                     s << "null";
                 } else {
-                    s << "spec " << typeDesc.value;
+                    s << "spec " << head.value;
                 }
             }
             break;
     }
-    return s.str();
 }
 
-string Decode::dumpToString() const {
+} // namespace
+
+string Reader::dumpToString() const {
     stringstream s;
-    s << dumpToStringInternal();
+    dumpItem(*this, s);
     return s.str();
 }
 
-Data Decode::encoded() const
-{
-    assert(subStart + subLen <= data->origData.size());
-    return TW::data(data->origData.data() + subStart, subLen);
-}
-
 } // namespace TW::Cbor
@@ -6,9 +6,12 @@
 
 #include "Data.h"
 
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <span>
 #include <vector>
 #include <map>
 
@@ -56,6 +59,10 @@ public:
 
     /// Create from raw content, must be valid CBOR data, may throw
     static Encode fromRaw(const TW::Data& rawData);
+
+    /// Size of the encoded head of an item: the size of an encoded unsigned int of this value,
+    /// or the size of the part preceding the contents of a string, array or map of this length.
+    static std::size_t headSize(uint64_t value);
     const Data& getDataInternal() const { return _data; }
 
 private:
@@ -78,12 +85,82 @@ inline bool operator<(const Encode& lhs, const Encode& rhs) {
     return lhs.getDataInternal() < rhs.getDataInternal();
 }
 
+/// Streaming CBOR encoder: items are written one after the other into a single buffer, no intermediate copies are made.
+/// Arrays are written as a head with the number of elements, followed by the elements.
+/// Maps are ordered like `Encode::map`: by the encoded bytes of the keys, keeping the first of equal keys.
+/// For that, the entries are written in any order between `beginMap` and `endMap`, every key preceded by `key()`
+/// and every value by `value()`; `endMap` then writes the head and sorts the entries by their key spans.
+/// See CborTests.cpp for usage.
+class Writer {
+public:
+    Writer() = default;
+    /// Reserves space for `capacity` bytes in the buffer
+    explicit Writer(std::size_t capacity) { _data.reserve(capacity); }
+
+    /// Return encoded bytes
+    const Data& encoded() const;
+    /// Move the encoded bytes out; the writer is left empty
+    Data release();
+
+    /// write an unsigned int
+    Writer& uint(uint64_t value);
+    /// write a negative int (positive is given), same as Encode::negInt
+    Writer& negInt(uint64_t value);
+    /// write a string
+    Writer& string(const std::string& str);
+    /// write a byte array
+    Writer& bytes(const Data& data);
+    /// write a byte array
+    Writer& bytes(const byte* data, std::size_t size);
+    /// write the head of an array of `count` elements, which are to be written next
+    Writer& arrayHead(std::size_t count);
+    /// write a tag; the tagged element is to be written next
+    Writer& tag(uint64_t value);
+    /// write a null value (special)
+    Writer& null();
+    /// write a version
+    Writer& version(uint64_t value);
+    /// write raw content, must be valid CBOR data, may throw
+    Writer& raw(const Data& rawData);
+
+    /// Start a map, its entries are to be written next
+    Writer& beginMap();
+    /// Start a map entry, its key is to be written next
+    Writer& key();
+    /// End the key of a map entry, its value is to be written next
+    Writer& value();
+    /// Close the innermost map: write its head and sort its entries
+    Writer& endMap();
+
+private:
+    Writer& appendValue(byte majorType, uint64_t value);
+
+    struct MapEntry {
+        std::size_t keyStart;
+        std::size_t keyEnd;
+    };
+    struct OpenMap {
+        std::size_t start;
+        std::vector<MapEntry> entries;
+    };
+
+    /// Encoded data is stored here, always well-formed when no map is open
+    Data _data;
+    /// Maps currently open, innermost last
+    std::vector<OpenMap> openMaps;
+};
+
+class Reader;
+
 /// CBOR Decoder and container for data for decoding.  Contains reference to read-only CBOR data.
+/// Parsing is done by `Reader`; this class keeps the data alive, and hands out elements as separate `Decode` objects.
 /// See CborTests.cpp for usage.
 class Decode {
 public:
     /// Constructor, create from CBOR byte stream
     Decode(const Data& input);
+    /// Constructor, create from CBOR byte stream, taking it over without a copy
+    Decode(Data&& input);
 
 public:
     enum MajorType {
@@ -110,7 +187,7 @@ public:
     /// Get the value of a string/bytes as Data
     TW::Data getBytes() const;
     /// Get all elements of array
-    std::vector<Decode> getArrayElements() const { return getCompoundElements(1, MT_array); }
+    std::vector<Decode> getArrayElements() const { return getCompoundElements(MT_array); }
     /// Get all elements of map
     MapElements getMapElements() const;
     /// Get the tag number
@@ -128,28 +205,14 @@ private:
     struct OrigDataRef {
         Data origData;
         OrigDataRef(const Data& o) : origData(o) {}
+        OrigDataRef(Data&& o) : origData(std::move(o)) {}
     };
     Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubIdx, uint32_t nSubLen);
     /// Skip ahead: form other Decode data with offset
     Decode skipClone(uint32_t offset) const;
-    /// Get the Nth byte
-    inline TW::byte getByte(uint32_t idx) const {
-        if (subStart + idx >= data->origData.size()) { throw std::invalid_argument("CBOR data too short"); }
-        return data->origData[subStart + idx];
-    }
-    struct TypeDesc {
-        MajorType majorType = MT_uint;
-        TW::byte byteCount = 0;
-        uint64_t value = 0;
-        bool isIndefiniteValue = false;
-    };
-    /// Parse out type sepcifiers
-    TypeDesc getTypeDesc() const;
-    uint32_t getTotalLen() const;
-    uint32_t getCompoundLength(uint32_t countMultiplier) const;
-    std::vector<Decode> getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const;
-    bool isBreak() const;
-    std::string dumpToStringInternal() const;
+    /// Reader over the substring
+    Reader reader() const;
+    std::vector<Decode> getCompoundElements(MajorType expectedType) const;
 
 private:
     /// Reference to raw data, to the whole orginal, smart ptr
@@ -159,4 +222,107 @@ private:
     uint32_t subLen;
 };
 
+/// CBOR pull decoder: a non-owning view of the data item at the start of a byte span.
+/// Nothing is copied or allocated: strings and bytes are returned as views into the span,
+/// and the elements of arrays and maps are visited in place, see `elements()`.
+/// The bytes must outlive the reader, and the views taken from it.  Errors are thrown as `std::invalid_argument`.
+/// See CborTests.cpp for usage.
+class Reader {
+public:
+    using MajorType = Decode::MajorType;
+
+    /// The initial bytes of a data item: major type, and the value, length or count given with it
+    struct Head {
+        MajorType majorType = Decode::MT_uint;
+        TW::byte byteCount = 0;
+        uint64_t value = 0;
+        bool isIndefinite = false;
+    };
+
+    class Iterator;
+    class Elements;
+
+    Reader() = default;
+    /// The data item starts at the first byte of `data`; it may be followed by other bytes.
+    Reader(std::span<const TW::byte> data) : data(data) {}
+
+    /// Check if the span starts with a valid data item
+    bool isValid() const;
+    /// Parse the initial bytes
+    Head head() const;
+    MajorType getMajorType() const { return head().majorType; }
+    /// Get the value of a simple type
+    uint64_t getValue() const;
+    /// Get the value of a string/bytes, as a view into the span
+    std::span<const TW::byte> getBytes() const;
+    /// Get the value of a string/bytes, as a view into the span
+    std::string_view getString() const;
+    /// Elements of an array, or keys and values of a map, alternating
+    Elements elements() const;
+    /// Get the tag number
+    uint64_t getTagValue() const;
+    /// Get the tag element
+    Reader getTagElement() const;
+    /// Length of the encoded data item, including nested items
+    std::size_t getTotalLen() const;
+    /// The encoded data item
+    std::span<const TW::byte> encoded() const { return data.first(getTotalLen()); }
+    /// The bytes the reader is over.  For array and map elements, exactly the encoded element.
+    std::span<const TW::byte> span() const { return data; }
+    /// Dump to a JSON-like string (debugging)
+    std::string dumpToString() const;
+
+private:
+    /// Get the Nth byte
+    TW::byte getByte(std::size_t idx) const {
+        if (idx >= data.size()) { throw std::invalid_argument("CBOR data too short"); }
+        return data[idx];
+    }
+    bool isBreak() const;
+
+    std::span<const TW::byte> data;
+};
+
+/// Forward iterator over the elements of an array or map.  Each element is checked to fit in the span before it is visited.
+/// Compare with `std::default_sentinel` for the end.
+class Reader::Iterator {
+public:
+    using value_type = Reader;
+    using difference_type = std::ptrdiff_t;
+
+    const Reader& operator*() const { return current; }
+    const Reader* operator->() const { return &current; }
+    Iterator& operator++();
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return done; }
+
+private:
+    friend class Reader;
+    explicit Iterator(std::span<const TW::byte> compound);
+    /// Position on the element at `offset`, or at the end
+    void load();
+
+    /// The whole array or map
+    std::span<const TW::byte> compound;
+    /// Start of the current element; past the last element (at the break, if indefinite) at the end
+    std::size_t offset = 0;
+    /// Number of elements left, including the current one, if not indefinite
+    uint64_t remaining = 0;
+    bool isIndefinite = false;
+    bool done = false;
+    Reader current;
+};
+
+class Reader::Elements {
+public:
+    Iterator begin() const { return Iterator(compound); }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    friend class Reader;
+    explicit Elements(std::span<const TW::byte> compound) : compound(compound) {}
+
+    std::span<const TW::byte> compound;
+};
+
 } // namespace TW::Cbor
@@ -5,10 +5,14 @@
 #include "Coin.h"
 
 #include "CoinEntry.h"
+#include "WorkerPool.h"
 #include <TrustWalletCore/TWCoinTypeConfiguration.h>
 #include <TrustWalletCore/TWHRP.h>
 
+#include <algorithm>
+#include <cctype>
 #include <map>
+#include <unordered_map>
 
 // #coin-list# Includes for entry points for coin implementations
 #include "Aeternity/Entry.h"
@@ -238,10 +242,11 @@ bool TW::validateAddress(TWCoinType coin, const std::string& string) {
     auto* dispatcher = coinDispatcher(coin);
     assert(dispatcher != nullptr);
 
+    // Entries reject invalid addresses without throwing; this only guards against unexpected errors.
     try {
         bool isValid = false;
         // First check HRP.
-        if (hrp != nullptr && !std::string(hrp).empty()) {
+        if (hrp != nullptr && hrp[0] != '\0') {
             isValid = dispatcher->validateAddress(coin, string, Bech32Prefix(hrp));
         }
         // Then check UTXO
@@ -258,6 +263,115 @@ bool TW::validateAddress(TWCoinType coin, const std::string& string) {
     }
 }
 
+namespace {
+
+/// The coins grouped by how their addresses are validated, from the registry.
+struct AddressClassifier {
+    /// A coin whose addresses are either Base58 or Bech32 with its own HRP (empty if none).
+    struct Base58Coin {
+        TWCoinType coin;
+        std::string hrp;
+    };
+
+    /// Coins that only accept Bech32 addresses with their HRP, by HRP.
+    std::unordered_map<std::string, std::vector<TWCoinType>> bech32Coins;
+    /// EVM coins: their addresses are validated the same way, whatever the coin.
+    std::vector<TWCoinType> evmCoins;
+    /// Bitcoin-like UTXO coins, only validated if the address could be theirs.
+    std::vector<Base58Coin> base58Coins;
+    /// Other coins, validated one by one.
+    std::vector<TWCoinType> otherCoins;
+
+    AddressClassifier() {
+        for (const auto coin : getCoinTypes()) {
+            const auto* hrp = stringForHRP(TW::hrp(coin));
+            switch (TW::blockchain(coin)) {
+            case TWBlockchainCosmos:
+                if (hrp != nullptr && hrp[0] != '\0') {
+                    bech32Coins[hrp].push_back(coin);
+                    continue;
+                }
+                break;
+            case TWBlockchainEthereum:
+                if (hrp == nullptr && TW::p2pkhPrefix(coin) == 0 && TW::p2shPrefix(coin) == 0) {
+                    evmCoins.push_back(coin);
+                    continue;
+                }
+                break;
+            // Their entries accept Base58Check addresses, or SegWit addresses with the coin's HRP.
+            // Not Bitcoin Cash (CashAddr without prefix) nor Zcash (TEX addresses with any HRP).
+            case TWBlockchainBitcoin:
+            case TWBlockchainBitcoinDiamond:
+            case TWBlockchainDecred:
+            case TWBlockchainGroestlcoin:
+            case TWBlockchainVerge:
+            case TWBlockchainZen:
+                base58Coins.push_back({coin, hrp != nullptr ? hrp : ""});
+                continue;
+            default:
+                break;
+            }
+            otherCoins.push_back(coin);
+        }
+    }
+};
+
+/// The lowercase human-readable part of a string if it were a Bech32 address, i.e. up to the last '1'.
+std::string bech32Hrp(const std::string& string) {
+    const auto separator = string.rfind('1');
+    if (separator == std::string::npos || separator == 0) {
+        return "";
+    }
+    std::string hrp = string.substr(0, separator);
+    std::transform(hrp.begin(), hrp.end(), hrp.begin(), [](unsigned char c) { return std::tolower(c); });
+    return hrp;
+}
+
+/// Whether a string only has characters of the Bitcoin Base58 alphabet, so it could decode as Base58.
+bool isBase58(const std::string& string) {
+    static constexpr const char* alphabet = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    return !string.empty() && string.find_first_not_of(alphabet) == std::string::npos;
+}
+
+/// Whether a string has the shape of an EVM address, i.e. "0x" and 40 more characters.
+bool isEvmShaped(const std::string& string) {
+    return string.size() == 42 && string[0] == '0' && string[1] == 'x';
+}
+
+} // namespace
+
+std::vector<TWCoinType> TW::detectCoins(const std::string& address) {
+    static const AddressClassifier classifier;
+
+    const auto hrp = bech32Hrp(address);
+    const auto base58 = isBase58(address);
+
+    std::vector<TWCoinType> coins;
+    if (const auto bech32 = classifier.bech32Coins.find(hrp); bech32 != classifier.bech32Coins.end()) {
+        for (const auto coin : bech32->second) {
+            if (validateAddress(coin, address)) {
+                coins.push_back(coin);
+            }
+        }
+    }
+    if (!classifier.evmCoins.empty() && isEvmShaped(address) && validateAddress(classifier.evmCoins.front(), address)) {
+        coins.insert(coins.end(), classifier.evmCoins.begin(), classifier.evmCoins.end());
+    }
+    for (const auto& entry : classifier.base58Coins) {
+        const auto couldBeSegwit = !entry.hrp.empty() && entry.hrp == hrp;
+        if ((base58 || couldBeSegwit) && validateAddress(entry.coin, address)) {
+            coins.push_back(entry.coin);
+        }
+    }
+    for (const auto coin : classifier.otherCoins) {
+        if (validateAddress(coin, address)) {
+            coins.push_back(coin);
+        }
+    }
+    std::sort(coins.begin(), coins.end());
+    return coins;
+}
+
 namespace TW::internal {
     inline std::string normalizeAddress(TWCoinType coin, const string& address) {
         // dispatch
@@ -318,6 +432,26 @@ void TW::anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
     dispatcher->sign(coinType, dataIn, dataOut);
 }
 
+std::vector<Data> TW::anyCoinSignBatch(const std::vector<TWCoinType>& coins, const std::vector<Data>& inputs) {
+    if (coins.size() != 1 && coins.size() != inputs.size()) {
+        throw std::invalid_argument("Expected one coin, or one coin per input");
+    }
+
+    std::vector<Data> outputs(inputs.size());
+    // Keep the pool alive even if it gets replaced while the batch is running.
+    const auto pool = WorkerPool::shared();
+    pool->parallelFor(inputs.size(), [&](std::size_t i) {
+        const auto coin = coins.size() == 1 ? coins.front() : coins[i];
+        try {
+            anyCoinSign(coin, inputs[i], outputs[i]);
+        } catch (...) {
+            // Do not let a single item fail the whole batch.
+            outputs[i].clear();
+        }
+    });
+    return outputs;
+}
+
 std::string TW::anySignJSON(TWCoinType coinType, const std::string& json, const Data& key) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
@@ -342,6 +476,12 @@ Data TW::anyCoinPreImageHashes(TWCoinType coinType, const Data& txInputData) {
     return dispatcher->preImageHashes(coinType, txInputData);
 }
 
+Data TW::anyCoinPrepareCompileInput(TWCoinType coinType, const Data& txInputData) {
+    auto* dispatcher = coinDispatcher(coinType);
+    assert(dispatcher != nullptr);
+    return dispatcher->prepareCompileInput(coinType, txInputData);
+}
+
 void TW::anyCoinCompileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& txOutputOut) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
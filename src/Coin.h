@@ -33,6 +33,11 @@ bool validateAddress(TWCoinType coin, const std::string& address);
 /// Validates an address for a particular coin.
 bool validateAddress(TWCoinType coin, const std::string& address, const PrefixVariant& prefix);
 
+/// Returns the coins an address is valid for, as by `validateAddress(coin, address)`, sorted by coin type.
+/// Only the coins the address could belong to are validated: e.g. Cosmos chains only if its Bech32 prefix is theirs,
+/// Bitcoin-like chains only if it is Base58 or has their Bech32 prefix, and EVM chains once for all of them.
+std::vector<TWCoinType> detectCoins(const std::string& address);
+
 /// Validates and normalizes an address for a particular coin.
 std::string normalizeAddress(TWCoinType coin, const std::string& address);
 std::string normalizeAddress(TWCoinType coin, const std::string& address, const PrefixVariant& prefix);
@@ -115,6 +120,11 @@ const char* chainId(TWCoinType coin);
 // Note: use output parameter to avoid unneeded copies
 void anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 
+/// Signs many transactions in parallel on the shared worker pool.
+/// `coins` holds either a single coin used for every input, or one coin per input.
+/// Outputs are in the order of the inputs; an output is empty if its input could not be signed at all.
+std::vector<Data> anyCoinSignBatch(const std::vector<TWCoinType>& coins, const std::vector<Data>& inputs);
+
 uint32_t slip44Id(TWCoinType coin);
 
 std::string anySignJSON(TWCoinType coinType, const std::string& json, const Data& key);
@@ -125,6 +135,8 @@ void anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 
 Data anyCoinPreImageHashes(TWCoinType coinType, const Data& txInputData);
 
+Data anyCoinPrepareCompileInput(TWCoinType coinType, const Data& txInputData);
+
 void anyCoinCompileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& txOutputOut);
 
 // Describes a derivation: path + optional format + optional name
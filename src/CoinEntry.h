@@ -14,6 +14,9 @@
 #include "proto/Common.pb.h"
 #include "uint256.h"
 
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message_lite.h>
+
 #include <string>
 #include <vector>
 #include <variant>
@@ -66,99 +69,120 @@ public:
     // We provide a default `PreSigningOutput` in TransactionCompiler.proto.
     // For some special coins, such as bitcoin, we will create a custom `PreSigningOutput` object in its proto file.
     virtual Data preImageHashes([[maybe_unused]] TWCoinType coin, [[maybe_unused]] const Data& txInputData) const { return {}; }
+    // Optional method for fixing the decisions taken while obtaining pre-image hashes (e.g. the UTXO plan) into the signing input,
+    // so that `preImageHashes` and `compile` called on the returned input do not take them again.
+    // Default impl. returns the input unchanged.
+    virtual Data prepareCompileInput([[maybe_unused]] TWCoinType coin, const Data& txInputData) const { return txInputData; }
     // Optional method for compiling a transaction with externally-supplied signatures & pubkeys.
     virtual void compile([[maybe_unused]] TWCoinType coin, [[maybe_unused]] const Data& txInputData, [[maybe_unused]] const std::vector<Data>& signatures, [[maybe_unused]] const std::vector<PublicKey>& publicKeys, [[maybe_unused]] Data& dataOut) const {}
     // Optional method for decoding a private key. Could throw an exception if the encoded private key is invalid.
     virtual PrivateKey decodePrivateKey([[maybe_unused]] TWCoinType coin, const std::string& privateKey) const;
 };
 
+// Serializes a proto message straight to the end of `dataOut`, avoiding the intermediate string of `SerializeAsString`.
+inline void serializeProtoTo(const google::protobuf::MessageLite& message, Data& dataOut) {
+    const auto size = message.ByteSizeLong();
+    const auto offset = dataOut.size();
+    dataOut.resize(offset + size);
+    message.SerializeWithCachedSizesToArray(dataOut.data() + offset);
+}
+
+// Serializes a proto message into a new, exactly sized `Data` buffer.
+inline Data serializeProto(const google::protobuf::MessageLite& message) {
+    Data result;
+    serializeProtoTo(message, result);
+    return result;
+}
+
 // In each coin's Entry.cpp the specific types of the coin are used, this template enforces the Signer implement:
 // static Proto::SigningOutput sign(const Proto::SigningInput& input);
-// Note: use output parameter to avoid unneeded copies
+// Note: use output parameter to avoid unneeded copies.
+// The input and all its nested messages are allocated on a single arena, released at once when signing is done.
 template <typename Signer, typename Input, typename Output>
 void signTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
+    input->ParseFromArray(dataIn.data(), (int)dataIn.size());
     try {
-        const auto serializedOut = Signer::sign(input).SerializeAsString();
-        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+        serializeProtoTo(Signer::sign(*input), dataOut);
     } catch (...) {
-        Output output;
-        output.set_error(Common::Proto::Error_invalid_params);
-        const auto serializedOut = output.SerializeAsString();
-        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+        auto* output = google::protobuf::Arena::CreateMessage<Output>(&arena);
+        output->set_error(Common::Proto::Error_invalid_params);
+        serializeProtoTo(*output, dataOut);
     }
 }
 
 // Note: use output parameter to avoid unneeded copies
 template <typename Planner, typename Input, typename Output>
 void planTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
+    input->ParseFromArray(dataIn.data(), (int)dataIn.size());
     try {
-        auto serializedOut = Planner::plan(input).SerializeAsString();
-        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+        serializeProtoTo(Planner::plan(*input), dataOut);
     } catch (...) {
-        Output output;
-        output.set_error(Common::Proto::Error_invalid_params);
-        auto serializedOut = output.SerializeAsString();
-        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+        auto* output = google::protobuf::Arena::CreateMessage<Output>(&arena);
+        output->set_error(Common::Proto::Error_invalid_params);
+        serializeProtoTo(*output, dataOut);
     }
 }
 
 // This template will be used for preImageHashes and compile in each coin's Entry.cpp.
 // It is a helper function to simplify exception handle.
+// Note: the input is parsed onto an arena; the output stays heap-allocated, as handlers typically move a signer result into it.
 template <typename Input, typename Output, typename Func>
 Data txCompilerTemplate(const Data& dataIn, Func&& fnHandler) {
-    auto input = Input();
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
     auto output = Output();
-    if (!input.ParseFromArray(dataIn.data(), (int)dataIn.size())) {
+    if (!input->ParseFromArray(dataIn.data(), (int)dataIn.size())) {
         output.set_error(Common::Proto::Error_input_parse);
         output.set_error_message("failed to parse input data");
-        return TW::data(output.SerializeAsString());
+        return serializeProto(output);
     }
 
     try {
         // each coin function handler
-        fnHandler(input, output);
+        fnHandler(*input, output);
     } catch (const std::exception& e) {
         output.set_error(Common::Proto::Error_internal);
         output.set_error_message(e.what());
     }
-    return TW::data(output.SerializeAsString());
+    return serializeProto(output);
 }
 
 // This template will be used for compile in each coin's Entry.cpp.
 // It is a helper function to simplify exception handle that validates if there is only one `signatures` and one `publicKeys`.
 template <typename Input, typename Output, typename Func>
 Data txCompilerSingleTemplate(const Data& dataIn, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Func&& fnHandler) {
-    auto input = Input();
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
     auto output = Output();
-    if (!input.ParseFromArray(dataIn.data(), (int)dataIn.size())) {
+    if (!input->ParseFromArray(dataIn.data(), (int)dataIn.size())) {
         output.set_error(Common::Proto::Error_input_parse);
         output.set_error_message("failed to parse input data");
-        return TW::data(output.SerializeAsString());
+        return serializeProto(output);
     }
 
     if (signatures.empty() || publicKeys.empty()) {
         output.set_error(Common::Proto::Error_invalid_params);
         output.set_error_message("empty signatures or publickeys");
-        return TW::data(output.SerializeAsString());
+        return serializeProto(output);
     }
     if (signatures.size() != 1 || publicKeys.size() != 1) {
         output.set_error(Common::Proto::Error_no_support_n2n);
         output.set_error_message("signatures and publickeys size can only be one");
-        return TW::data(output.SerializeAsString());
+        return serializeProto(output);
     }
 
     try {
         // each coin function handler
-        fnHandler(input, output, signatures[0], publicKeys[0]);
+        fnHandler(*input, output, signatures[0], publicKeys[0]);
     } catch (const std::exception& e) {
         output.set_error(Common::Proto::Error_internal);
         output.set_error_message(e.what());
     }
-    return TW::data(output.SerializeAsString());
+    return serializeProto(output);
 }
 
 // Get the hrp from the prefix variant, or the coin-default if it is empty or it is not an hrp
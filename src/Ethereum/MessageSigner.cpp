@@ -20,10 +20,10 @@ std::string signMessageRust(const PrivateKey& privateKey, const std::string& mes
         input.mutable_chain_id()->set_chain_id(static_cast<uint64_t>(chainId.value()));
     }
 
-    Rust::TWDataWrapper inputData(data(input.SerializeAsString()));
-    Rust::TWDataWrapper outputPtr = Rust::tw_message_signer_sign(TWCoinTypeEthereum, inputData.get());
+    const auto inputData = data(input.SerializeAsString());
+    Rust::CByteArrayWrapper outputPtr = Rust::tw_message_signer_sign_bytes(TWCoinTypeEthereum, inputData.data(), inputData.size());
 
-    auto outputData = outputPtr.toDataOrDefault();
+    const auto& outputData = outputPtr.data;
     if (outputData.empty()) {
         return {};
     }
@@ -42,10 +42,10 @@ Data messagePreImageHashRust(const std::string& message, Proto::MessageType msgT
     input.set_message(message);
     input.set_message_type(msgType);
 
-    Rust::TWDataWrapper inputData(data(input.SerializeAsString()));
-    Rust::TWDataWrapper outputPtr = Rust::tw_message_signer_pre_image_hashes(TWCoinTypeEthereum, inputData.get());
+    const auto inputData = data(input.SerializeAsString());
+    Rust::CByteArrayWrapper outputPtr = Rust::tw_message_signer_pre_image_hashes_bytes(TWCoinTypeEthereum, inputData.data(), inputData.size());
 
-    auto outputData = outputPtr.toDataOrDefault();
+    const auto& outputData = outputPtr.data;
     if (outputData.empty()) {
         return {};
     }
@@ -65,8 +65,8 @@ bool verifyMessageRust(const PublicKey& publicKey, const std::string& message, c
     input.set_message(message);
     input.set_signature(signature);
 
-    Rust::TWDataWrapper inputData(data(input.SerializeAsString()));
-    return Rust::tw_message_signer_verify(TWCoinTypeEthereum, inputData.get());
+    const auto inputData = data(input.SerializeAsString());
+    return Rust::tw_message_signer_verify_bytes(TWCoinTypeEthereum, inputData.data(), inputData.size());
 }
 
 std::string MessageSigner::signMessage(const PrivateKey& privateKey, const std::string& message, MessageType msgType, MaybeChainId chainId) {
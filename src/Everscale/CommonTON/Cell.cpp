@@ -5,14 +5,19 @@
 #include "Cell.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstring>
-#include <map>
+#include <exception>
+#include <limits>
 #include <optional>
 #include <unordered_map>
 
 #include "Base64.h"
 #include "BinaryCoding.h"
 #include "BitReader.h"
+#include "WorkerPool.h"
+
+#include <TrezorCrypto/sha2.h>
 
 using namespace TW;
 
@@ -20,13 +25,13 @@ namespace TW::CommonTON {
 
 constexpr static uint32_t BOC_MAGIC = 0xb5ee9c72;
 
-uint16_t computeBitLen(const Data& data, bool aligned) {
-    auto bitLen = static_cast<uint16_t>(data.size() * 8);
+uint16_t computeBitLen(const uint8_t* _Nonnull data, size_t size, bool aligned) {
+    auto bitLen = static_cast<uint16_t>(size * 8);
     if (aligned) {
         return bitLen;
     }
 
-    for (auto i = static_cast<int64_t>(data.size() - 1); i >= 0; --i) {
+    for (auto i = static_cast<int64_t>(size - 1); i >= 0; --i) {
         const auto index = static_cast<size_t>(i);
         if (data[index] == 0) {
             bitLen -= 8;
@@ -87,6 +92,135 @@ struct Reader {
     }
 };
 
+// Memory for the cells of one bag of cells. It is handed out in order, never reused,
+// and released at once when the last cell allocated from it is destroyed.
+class CellArena {
+public:
+    explicit CellArena(size_t cellCount)
+        : capacity(cellCount * SLOT_SIZE), buffer(std::make_unique<std::byte[]>(capacity)) {}
+
+    void* _Nonnull allocate(size_t size, size_t alignment) {
+        const auto offset = (used + alignment - 1) / alignment * alignment;
+        if (offset + size > capacity) {
+            // Estimate exceeded, which is not expected; fall back to separate blocks
+            return overflow.emplace_back(std::make_unique<std::byte[]>(size)).get();
+        }
+        used = offset + size;
+        return buffer.get() + offset;
+    }
+
+private:
+    // A cell with its shared_ptr control block
+    constexpr static size_t SLOT_SIZE = sizeof(Cell) + 8 * sizeof(void*);
+
+    size_t capacity;
+    size_t used = 0;
+    std::unique_ptr<std::byte[]> buffer;
+    std::vector<std::unique_ptr<std::byte[]>> overflow{};
+};
+
+// Allocates from a `CellArena`, which every copy keeps alive.
+template <typename T>
+struct CellArenaAllocator {
+    using value_type = T;
+
+    std::shared_ptr<CellArena> arena;
+
+    explicit CellArenaAllocator(std::shared_ptr<CellArena> arena) noexcept
+        : arena(std::move(arena)) {}
+
+    template <typename U>
+    CellArenaAllocator(const CellArenaAllocator<U>& other) noexcept
+        : arena(other.arena) {}
+
+    T* _Nonnull allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* _Nonnull, size_t) noexcept {
+        // released with the arena
+    }
+
+    template <typename U>
+    bool operator==(const CellArenaAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+};
+
+struct CellHashHasher {
+    size_t operator()(const Cell::CellHash& hash) const noexcept {
+        // The hash is uniformly distributed already
+        size_t result = 0;
+        std::memcpy(&result, hash.data(), sizeof(result));
+        return result;
+    }
+};
+
+// Levels with fewer cells are hashed on the calling thread: handing them out would cost more than hashing them.
+constexpr static size_t PARALLEL_HASHING_MIN_CELLS = 256;
+// Cells are handed out to the workers in chunks, for the same reason
+constexpr static size_t HASHING_CHUNK_SIZE = 64;
+
+// The cells under a root (itself included), each one once
+struct CellGraph {
+    // Children before their parent, in depth-first order
+    std::vector<Cell* _Nonnull> cells{};
+    // Cells not finalized yet, grouped by height: a cell only refers to cells of the previous levels
+    std::vector<std::vector<Cell* _Nonnull>> unfinalizedLevels{};
+
+    // Collects the cells under `root` with one depth-first walk.
+    // Finalized cells are only collected (and descended into) if `withFinalized` is set.
+    static CellGraph collect(Cell& root, bool withFinalized) {
+        CellGraph graph{};
+
+        constexpr auto FINALIZED = std::numeric_limits<size_t>::max();
+        // Height of every visited cell, or FINALIZED
+        std::unordered_map<const Cell*, size_t> heights{};
+
+        // The stack is explicit, so that deep trees do not exhaust the call stack
+        struct Frame {
+            Cell* _Nonnull cell;
+            uint8_t nextRef;
+        };
+        std::vector<Frame> stack{{&root, 0}};
+        heights.emplace(&root, FINALIZED);
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            if (frame.nextRef < Cell::MAX_REFS && frame.cell->references[frame.nextRef] != nullptr) {
+                auto* child = frame.cell->references[frame.nextRef++].get();
+                if ((withFinalized || !child->finalized) && heights.emplace(child, FINALIZED).second) {
+                    stack.push_back(Frame{child, 0});
+                }
+                continue;
+            }
+
+            auto* cell = frame.cell;
+            stack.pop_back();
+            graph.cells.push_back(cell);
+            if (cell->finalized) {
+                continue;
+            }
+
+            size_t height = 0;
+            for (const auto& ref : cell->references) {
+                if (ref == nullptr) {
+                    break;
+                }
+                const auto it = heights.find(ref.get());
+                if (it != heights.end() && it->second != FINALIZED) {
+                    height = std::max(height, it->second + 1);
+                }
+            }
+            heights[cell] = height;
+            if (height >= graph.unfinalizedLevels.size()) {
+                graph.unfinalizedLevels.resize(height + 1);
+            }
+            graph.unfinalizedLevels[height].push_back(cell);
+        }
+        return graph;
+    }
+};
+
 std::shared_ptr<Cell> Cell::fromBase64(const std::string& encoded) {
     auto boc = Base64::decode(encoded);
     return Cell::deserialize(boc.data(), boc.size());
@@ -126,6 +260,10 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
     if (rootCount > cellCount) {
         throw std::runtime_error("root count is greater than cell count");
     }
+    // Every cell takes at least 2 bytes
+    if (cellCount > (len - reader.offset) / 2) {
+        throw std::runtime_error("cell count is greater than data size");
+    }
     const auto absent_count = reader.readNextUint(refSize);
     if (absent_count > 0) {
         throw std::runtime_error("absent cells are not supported");
@@ -140,15 +278,17 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
         reader.advance(cellCount * offsetSize);
     }
 
-    // 5. Deserialize cells
-    struct IntermediateCell {
+    // 5. Parse cells. Cells only refer to cells after them, so they are built in reverse order
+    struct RawCell {
         uint16_t bitLen;
-        Data data;
-        std::vector<size_t> references;
+        const uint8_t* _Nonnull data;
+        uint8_t byteLen;
+        uint8_t refCount;
+        std::array<size_t, Cell::MAX_REFS> references;
     };
 
-    std::vector<IntermediateCell> intermediate{};
-    intermediate.reserve(cellCount);
+    std::vector<RawCell> rawCells{};
+    rawCells.reserve(cellCount);
 
     for (size_t i = 0; i < cellCount; ++i) {
         struct Descriptor {
@@ -175,7 +315,7 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
             throw std::runtime_error("invalid ref count");
         }
         const auto d2 = reader.data()[1];
-        const auto byteLen = (d2 >> 1) + (d2 & 0b1);
+        const auto byteLen = static_cast<uint8_t>((d2 >> 1) + (d2 & 0b1));
         reader.advance(2);
 
         // Skip stored hashes
@@ -184,63 +324,93 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
         }
 
         reader.require(byteLen);
-        Data cellData(byteLen);
-        std::memcpy(cellData.data(), reader.data(), byteLen);
+        const auto* cellData = reader.data();
         reader.advance(byteLen);
 
-        std::vector<size_t> references{};
-        references.reserve(refSize * d1.refCount);
+        RawCell rawCell{
+            .bitLen = computeBitLen(cellData, byteLen, (d2 & 0b1) == 0),
+            .data = cellData,
+            .byteLen = byteLen,
+            .refCount = d1.refCount,
+            .references = {},
+        };
         reader.require(refSize * d1.refCount);
         for (size_t r = 0; r < d1.refCount; ++r) {
             const auto index = reader.readNextUint(refSize);
             if (index > cellCount || index <= i) {
                 throw std::runtime_error("invalid child index");
             }
-
-            references.push_back(index);
+            rawCell.references[r] = index;
         }
+        rawCells.push_back(rawCell);
+    }
 
-        const auto bitLen = computeBitLen(cellData, (d2 & 0b1) == 0);
-        intermediate.emplace_back(
-            IntermediateCell{
-                .bitLen = bitLen,
-                .data = std::move(cellData),
-                .references = std::move(references),
-            });
+    // 6. Group cells by height: a cell only refers to cells of the previous levels
+    std::vector<size_t> heights(cellCount, 0);
+    std::vector<std::vector<size_t>> levels{};
+    for (size_t i = cellCount; i-- > 0;) {
+        const auto& raw = rawCells[i];
+        for (size_t r = 0; r < raw.refCount; ++r) {
+            if (raw.references[r] >= cellCount) {
+                throw std::runtime_error("child cell not found");
+            }
+            heights[i] = std::max(heights[i], heights[raw.references[r]] + 1);
+        }
+        if (heights[i] >= levels.size()) {
+            levels.resize(heights[i] + 1);
+        }
+        levels[heights[i]].push_back(i);
     }
 
-    std::unordered_map<size_t, Cell::Ref> doneCells{};
+    // 7. Build cells, level by level
+    const auto arena = std::make_shared<CellArena>(cellCount);
+    std::vector<Cell::Ref> cells(cellCount);
+    // Identical subtrees are kept once
+    std::unordered_map<Cell::CellHash, Cell::Ref, CellHashHasher> uniqueCells{};
+    uniqueCells.reserve(cellCount);
+
+    std::vector<Cell* _Nonnull> levelCells{};
+    for (const auto& level : levels) {
+        levelCells.clear();
+        for (const auto i : level) {
+            const auto& raw = rawCells[i];
+
+            Cell::Refs references{};
+            for (size_t r = 0; r < raw.refCount; ++r) {
+                references[r] = cells[raw.references[r]];
+            }
 
-    size_t index = cellCount;
-    for (auto it = intermediate.rbegin(); it != intermediate.rend(); ++it, --index) {
-        auto& raw = *it;
+            cells[i] = std::allocate_shared<Cell>(CellArenaAllocator<Cell>(arena),
+                                                  raw.bitLen, raw.data, raw.byteLen, raw.refCount, std::move(references));
+            levelCells.push_back(cells[i].get());
+        }
 
-        Cell::Refs references{};
-        for (size_t r = 0; r < raw.references.size(); ++r) {
-            const auto child = doneCells.find(raw.references[r]);
-            if (child == doneCells.end()) {
-                throw std::runtime_error("child cell not found");
+        Cell::computeHashes(levelCells);
+
+        for (const auto i : level) {
+            const auto [unique, inserted] = uniqueCells.emplace(cells[i]->hash, cells[i]);
+            if (!inserted) {
+                cells[i] = unique->second;
             }
-            references[r] = child->second;
         }
-
-        auto cell = std::make_shared<Cell>(raw.bitLen, std::move(raw.data), raw.references.size(), std::move(references));
-        cell->finalize();
-        doneCells.emplace(index - 1, cell);
     }
 
-    const auto root = doneCells.find(rootIndex);
-    if (root == doneCells.end()) {
+    if (rootIndex >= cellCount) {
         throw std::runtime_error("root cell not found");
     }
-    return std::move(root->second);
+    return std::move(cells[rootIndex]);
 }
 
 class SerializationContext {
 public:
-    static SerializationContext build(const Cell& cell) {
+    // Indexes finalized cells given children before their parent; duplicates of indexed cells are skipped
+    static SerializationContext build(const std::vector<Cell* _Nonnull>& cells) {
         SerializationContext ctx{};
-        fillContext(cell, ctx);
+        ctx.indices.reserve(cells.size());
+        ctx.reversedCells.reserve(cells.size());
+        for (const auto* cell : cells) {
+            ctx.add(*cell);
+        }
         return ctx;
     }
 
@@ -310,30 +480,26 @@ private:
 
     size_t cellsSize = 0;
     ref_t index = 0;
-    std::map<Cell::CellHash, ref_t> indices{};
+    std::unordered_map<Cell::CellHash, ref_t, CellHashHasher> indices{};
     std::vector<const Cell* _Nonnull> reversedCells{};
 
-    static void fillContext(const Cell& cell, SerializationContext& ctx) {
-        if (ctx.indices.find(cell.hash) != ctx.indices.end()) {
+    void add(const Cell& cell) {
+        if (!indices.emplace(cell.hash, index).second) {
             return;
         }
-
-        for (const auto& ref : cell.references) {
-            if (ref == nullptr) {
-                break;
-            }
-            fillContext(*ref, ctx);
-        }
-
-        ctx.indices.insert(std::make_pair(cell.hash, ctx.index++));
-        ctx.reversedCells.emplace_back(&cell);
-        ctx.cellsSize += cell.serializedSize(REF_SIZE);
+        ++index;
+        reversedCells.emplace_back(&cell);
+        cellsSize += cell.serializedSize(REF_SIZE);
     }
 };
 
-void Cell::serialize(Data& os) const {
-    assert(finalized);
-    const auto ctx = SerializationContext::build(*this);
+void Cell::serialize(Data& os) {
+    // The walk collecting the cells to index also tells which of them are to be hashed first
+    const auto graph = CellGraph::collect(*this, true);
+    for (const auto& level : graph.unfinalizedLevels) {
+        computeHashes(level);
+    }
+    const auto ctx = SerializationContext::build(graph.cells);
     ctx.encode(os);
 }
 
@@ -342,58 +508,100 @@ void Cell::finalize() {
         return;
     }
 
+    const auto childrenFinalized = std::all_of(references.begin(), references.end(), [](const auto& ref) {
+        return ref == nullptr || ref->finalized;
+    });
+    if (childrenFinalized) {
+        // Cells are built from finalized children, so this is the usual case
+        computeHash();
+        return;
+    }
+
+    // Finalize children first, from the leaves up
+    const auto graph = CellGraph::collect(*this, false);
+    for (const auto& level : graph.unfinalizedLevels) {
+        computeHashes(level);
+    }
+}
+
+void Cell::computeHashes(const std::vector<Cell* _Nonnull>& cells) {
+    if (cells.size() < PARALLEL_HASHING_MIN_CELLS) {
+        for (auto* cell : cells) {
+            cell->computeHash();
+        }
+        return;
+    }
+
+    // Cells of one level only read the hashes of the previous levels, so they are hashed independently.
+    // Workers must not throw, so errors are passed back to the calling thread.
+    const auto chunks = (cells.size() + HASHING_CHUNK_SIZE - 1) / HASHING_CHUNK_SIZE;
+    std::vector<std::exception_ptr> errors(chunks);
+    WorkerPool::shared()->parallelFor(chunks, [&cells, &errors](size_t chunk) {
+        try {
+            const auto end = std::min(cells.size(), (chunk + 1) * HASHING_CHUNK_SIZE);
+            for (auto i = chunk * HASHING_CHUNK_SIZE; i < end; ++i) {
+                cells[i]->computeHash();
+            }
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void Cell::computeHash() {
     if (bitLen > Cell::MAX_BITS || refCount > Cell::MAX_REFS) {
         throw std::invalid_argument("invalid cell");
     }
 
-    // Finalize child cells and update current cell depth
-    // NOTE: Use before context creation to reduce stack size
     for (const auto& ref : references) {
         if (ref == nullptr) {
             break;
         }
-        ref->finalize();
         depth = std::max(depth, static_cast<uint16_t>(ref->depth + 1));
     }
 
-    // Compute cell hash
-    const auto dataSize = std::min(data.size(), static_cast<size_t>((bitLen + 7) / 8));
+    // The hashed representation is fed to the hasher piece by piece, instead of being assembled first
+    SHA256_CTX ctx;
+    sha256_Init(&ctx);
 
-    Data normalized{};
-    normalized.reserve(/* descriptor bytes */ 2 + dataSize + refCount * (sizeof(uint16_t) + Hash::sha256Size));
-
-    // Write descriptor bytes
+    // Descriptor bytes
     const auto [d1, d2] = getDescriptorBytes();
-    normalized.push_back(d1);
-    normalized.push_back(d2);
-    std::copy(data.begin(), std::next(data.begin(), static_cast<ssize_t>(dataSize)), std::back_inserter(normalized));
+    const uint8_t descriptor[] = {d1, d2};
+    sha256_Update(&ctx, descriptor, sizeof(descriptor));
+
+    // Data
+    const auto dataSize = std::min(data.size(), static_cast<size_t>((bitLen + 7) / 8));
+    sha256_Update(&ctx, data.data(), dataSize);
 
-    // Write all children depths
+    // All children depths
     for (const auto& ref : references) {
         if (ref == nullptr) {
             break;
         }
-        encode16BE(ref->depth, normalized);
+        const uint8_t childDepth[] = {static_cast<uint8_t>(ref->depth >> 8), static_cast<uint8_t>(ref->depth)};
+        sha256_Update(&ctx, childDepth, sizeof(childDepth));
     }
 
-    // Write all children hashes
+    // All children hashes
     for (const auto& ref : references) {
         if (ref == nullptr) {
             break;
         }
-        std::copy(ref->hash.begin(), ref->hash.end(), std::back_inserter(normalized));
+        sha256_Update(&ctx, ref->hash.data(), ref->hash.size());
     }
 
     // Done
-    const auto computedHash = Hash::sha256(normalized);
-    assert(computedHash.size() == Hash::sha256Size);
-
-    std::copy(computedHash.begin(), computedHash.end(), hash.begin());
+    sha256_Final(&ctx, hash.data());
     finalized = true;
 }
 
 std::optional<AddressData> Cell::parseAddress() const {
-    auto reader = BitReader::createExact(data, static_cast<uint64_t>(bitLen));
+    auto reader = BitReader::createExact(Data(data.begin(), data.end()), static_cast<uint64_t>(bitLen));
     if (!reader) {
         return std::nullopt;
     }
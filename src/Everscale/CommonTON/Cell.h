@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "Data.h"
@@ -18,14 +20,38 @@ class Cell {
 public:
     constexpr static uint16_t MAX_BITS = 1023;
     constexpr static uint8_t MAX_REFS = 4;
+    constexpr static uint8_t MAX_BYTES = (MAX_BITS + 7) / 8;
 
     using Ref = std::shared_ptr<Cell>;
     using Refs = std::array<Ref, MAX_REFS>;
     using CellHash = std::array<uint8_t, Hash::sha256Size>;
 
+    // Cell data, stored inline: a cell never holds more than `MAX_BYTES` bytes.
+    class Bytes {
+    public:
+        Bytes() = default;
+        Bytes(const uint8_t* _Nonnull bytes, size_t size) {
+            if (size > MAX_BYTES) {
+                throw std::invalid_argument("invalid cell");
+            }
+            std::copy(bytes, bytes + size, storage.begin());
+            length = static_cast<uint8_t>(size);
+        }
+
+        [[nodiscard]] const uint8_t* _Nonnull data() const noexcept { return storage.data(); }
+        [[nodiscard]] size_t size() const noexcept { return length; }
+        [[nodiscard]] const uint8_t* _Nonnull begin() const noexcept { return storage.data(); }
+        [[nodiscard]] const uint8_t* _Nonnull end() const noexcept { return storage.data() + length; }
+        uint8_t operator[](size_t index) const noexcept { return storage[index]; }
+
+    private:
+        std::array<uint8_t, MAX_BYTES> storage{};
+        uint8_t length = 0;
+    };
+
     bool finalized = false;
     uint16_t bitLen = 0;
-    std::vector<uint8_t> data{};
+    Bytes data{};
     uint8_t refCount = 0;
     Refs references{};
 
@@ -34,19 +60,25 @@ public:
 
     Cell() = default;
 
-    Cell(uint16_t bitLen, std::vector<uint8_t> data, uint8_t refCount, Refs references)
-        : bitLen(bitLen), data(std::move(data)), refCount(refCount), references(std::move(references)) {}
+    Cell(uint16_t bitLen, const uint8_t* _Nonnull data, size_t size, uint8_t refCount, Refs references)
+        : bitLen(bitLen), data(data, size), refCount(refCount), references(std::move(references)) {}
+
+    Cell(uint16_t bitLen, const Data& data, uint8_t refCount, Refs references)
+        : Cell(bitLen, data.data(), data.size(), refCount, std::move(references)) {}
 
     // Deserialize from Base64
     static std::shared_ptr<Cell> fromBase64(const std::string& encoded);
 
-    // Deserialize from BOC representation
+    // Deserialize from BOC representation.
+    // All cells of the bag are allocated from one arena, and identical subtrees are shared.
+    // Cells are hashed level by level, from the leaves up; large levels are hashed in parallel.
     static std::shared_ptr<Cell> deserialize(const uint8_t* _Nonnull data, size_t len);
 
-    // Serialize to binary stream
-    void serialize(Data& os) const;
+    // Serialize to binary stream, finalizing the cells not finalized yet in the same pass
+    void serialize(Data& os);
 
-    // Compute cell depth and hash
+    // Compute cell depth and hash, and those of the children not finalized yet.
+    // Children are hashed level by level, from the leaves up; large levels are hashed in parallel.
     void finalize();
 
     [[nodiscard]] inline std::pair<uint8_t, uint8_t> getDescriptorBytes() const noexcept {
@@ -61,6 +93,13 @@ public:
 
     // Tries to parse an address from the Cell.
     std::optional<AddressData> parseAddress() const;
+
+private:
+    // Computes depth and hash from the children, which must be finalized
+    void computeHash();
+
+    // Computes hashes of cells which don't refer to each other, in parallel if there are many
+    static void computeHashes(const std::vector<Cell* _Nonnull>& cells);
 };
 
 } // namespace TW::CommonTON
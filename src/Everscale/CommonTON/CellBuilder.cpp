@@ -144,7 +144,7 @@ void CellBuilder::appendBuilder(const CellBuilder& builder) {
 }
 
 void CellBuilder::appendCellSlice(const CellSlice& other) {
-    Data appendedData(other.cell->data);
+    Data appendedData(other.cell->data.begin(), other.cell->data.end());
     appendRaw(appendedData, other.cell->bitLen);
 
     for (const auto& cell : other.cell->references) {
@@ -33,28 +33,31 @@ const Data cidPrefix = {
     0x20,
 };
 
-Cbor::Encode Transaction::message() const {
-    Cbor::Encode cborGasLimit = gasLimit >= 0 ? Cbor::Encode::uint((uint64_t)gasLimit)
-                                              : Cbor::Encode::negInt((uint64_t)(-gasLimit - 1));
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(0),                             // version
-        Cbor::Encode::bytes(to.toBytes()),                   // to address
-        Cbor::Encode::bytes(from.toBytes()),                 // from address
-        Cbor::Encode::uint(nonce),                         // nonce
-        Cbor::Encode::bytes(encodeBigInt(value)),            // value
-        cborGasLimit,                                            // gas limit
-        Cbor::Encode::bytes(encodeBigInt(gasFeeCap)),  // gas fee cap
-        Cbor::Encode::bytes(encodeBigInt(gasPremium)), // gas premium
-        Cbor::Encode::uint(method),                        // abi.MethodNum
-        Cbor::Encode::bytes(params)                          // params
-    });
+Data Transaction::message() const {
+    Cbor::Writer writer;
+    writer.arrayHead(10);
+    writer.uint(0);                         // version
+    writer.bytes(to.toBytes());             // to address
+    writer.bytes(from.toBytes());           // from address
+    writer.uint(nonce);                     // nonce
+    writer.bytes(encodeBigInt(value));      // value
+    if (gasLimit >= 0) {                    // gas limit
+        writer.uint((uint64_t)gasLimit);
+    } else {
+        writer.negInt((uint64_t)(-gasLimit - 1));
+    }
+    writer.bytes(encodeBigInt(gasFeeCap));  // gas fee cap
+    writer.bytes(encodeBigInt(gasPremium)); // gas premium
+    writer.uint(method);                    // abi.MethodNum
+    writer.bytes(params);                   // params
+    return writer.release();
 }
 
 Data Transaction::cid() const {
     Data cid;
     cid.reserve(cidPrefix.size() + 32);
     cid.insert(cid.end(), cidPrefix.begin(), cidPrefix.end());
-    Data hash = Hash::blake2b(message().encoded(), 32);
+    Data hash = Hash::blake2b(message(), 32);
     cid.insert(cid.end(), hash.begin(), hash.end());
     return cid;
 }
@@ -62,7 +62,7 @@ class Transaction {
 
   public:
     // message returns the CBOR encoding of the Filecoin Message to be signed.
-    Cbor::Encode message() const;
+    Data message() const;
 
     // cid returns the raw Filecoin message CID (excluding the signature).
     Data cid() const;
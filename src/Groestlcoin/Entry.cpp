@@ -14,7 +14,10 @@ bool Entry::validateAddress([[maybe_unused]] TWCoinType coin, const std::string&
     if (auto* prefix = std::get_if<Base58Prefix>(&addressPrefix); prefix) {
         return Address::isValid(address, {prefix->p2pkh, prefix->p2sh});
     }
-    return TW::Bitcoin::SegwitAddress::isValid(address, std::get<Bech32Prefix>(addressPrefix));
+    if (auto* hrp = std::get_if<Bech32Prefix>(&addressPrefix); hrp) {
+        return TW::Bitcoin::SegwitAddress::isValid(address, *hrp);
+    }
+    return false;
 }
 
 std::string Entry::deriveAddress([[maybe_unused]] TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const {
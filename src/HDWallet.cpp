@@ -25,6 +25,7 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 
 using namespace TW;
 
@@ -146,6 +147,53 @@ static HDNode getNode(const HDWallet<seedSize>& wallet, TWCurve curve, const Der
     return node;
 }
 
+namespace {
+
+/// Nodes derived from the master node of each curve, by derivation path, for curves with default private keys.
+template <size_t seedSize>
+class NodeCache {
+public:
+    explicit NodeCache(const HDWallet<seedSize>& wallet) : wallet(wallet) {}
+
+    ~NodeCache() {
+        for (auto& entry : nodes) {
+            TW::memzero(&entry.second);
+        }
+    }
+
+    NodeCache(const NodeCache&) = delete;
+    NodeCache& operator=(const NodeCache&) = delete;
+
+    /// Returns the same node as `getNode`, deriving only the indices that were not derived yet.
+    HDNode getNode(TWCurve curve, const DerivationPath& derivationPath) {
+        std::pair<TWCurve, std::vector<uint32_t>> key{curve, {}};
+        key.second.reserve(derivationPath.indices.size());
+
+        auto found = nodes.find(key);
+        if (found == nodes.end()) {
+            found = nodes.emplace(key, getMasterNode(wallet, curve)).first;
+        }
+        HDNode node = found->second;
+        for (const auto& index : derivationPath.indices) {
+            key.second.push_back(index.derivationIndex());
+            found = nodes.find(key);
+            if (found != nodes.end()) {
+                node = found->second;
+                continue;
+            }
+            hdnode_private_ckd(&node, index.derivationIndex());
+            nodes.emplace(key, node);
+        }
+        return node;
+    }
+
+private:
+    const HDWallet<seedSize>& wallet;
+    std::map<std::pair<TWCurve, std::vector<uint32_t>>, HDNode> nodes;
+};
+
+} // namespace
+
 template <std::size_t seedSize>
 PrivateKey HDWallet<seedSize>::getMasterKey(TWCurve curve) const {
     auto node = getMasterNode(*this, curve);
@@ -217,6 +265,45 @@ PrivateKey HDWallet<seedSize>::getKey(TWCoinType coin, TWDerivation derivation)
     return getKey(coin, path);
 }
 
+template <std::size_t seedSize>
+std::vector<typename HDWallet<seedSize>::DerivedKey> HDWallet<seedSize>::deriveKeys(const std::vector<KeyRequest>& requests) const {
+    NodeCache<seedSize> cache(*this);
+    std::vector<DerivedKey> keys;
+    keys.reserve(requests.size());
+    for (const auto& request : requests) {
+        const auto curve = TWCoinTypeCurve(request.coin);
+        const auto& derivationPath = request.derivationPath;
+        if (PrivateKey::getType(curve) != TWPrivateKeyTypeDefault || curve == TWCurveStarkex) {
+            // Not plain nodes: see `getKeyByCurve`.
+            keys.push_back({getKeyByCurve(curve, derivationPath),
+                            getExtendedPublicKey(derivationPath.purpose(), request.coin, request.extendedPublicKeyVersion)});
+            continue;
+        }
+
+        auto node = cache.getNode(curve, derivationPath);
+        auto privateKey = PrivateKey(Data(node.private_key, node.private_key + PrivateKey::_size), curve);
+        TW::memzero(&node);
+
+        std::string extendedPublicKey;
+        if (request.extendedPublicKeyVersion != TWHDVersionNone) {
+            // Same as `getExtendedPublicKeyAccount` with the default derivation and account 0.
+            const auto coinIndex = TW::derivationPath(request.coin, TWDerivationDefault).coin();
+            auto accountPath = DerivationPath({DerivationPathIndex(derivationPath.purpose(), true), DerivationPathIndex(coinIndex, true)});
+            auto parent = cache.getNode(curve, accountPath);
+            const auto fingerprintValue = fingerprint(&parent, publicKeyHasher(request.coin));
+            TW::memzero(&parent);
+
+            accountPath.indices.emplace_back(0, true);
+            auto account = cache.getNode(curve, accountPath);
+            hdnode_fill_public_key(&account);
+            extendedPublicKey = serialize(&account, fingerprintValue, request.extendedPublicKeyVersion, true, base58Hasher(request.coin));
+            TW::memzero(&account);
+        }
+        keys.push_back({std::move(privateKey), std::move(extendedPublicKey)});
+    }
+    return keys;
+}
+
 template <std::size_t seedSize>
 std::string HDWallet<seedSize>::getRootKey(TWCoinType coin, TWHDVersion version) const {
     const auto curve = TWCoinTypeCurve(coin);
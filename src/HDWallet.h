@@ -19,6 +19,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace TW {
 
@@ -86,6 +87,25 @@ public:
     /// Returns the private key at the given derivation path and curve.
     PrivateKey getKeyByCurve(TWCurve curve, const DerivationPath& derivationPath) const;
 
+    /// A key to derive with `deriveKeys`.
+    struct KeyRequest {
+        TWCoinType coin;
+        DerivationPath derivationPath;
+        /// Version of the extended public key of the account to derive, as in `getExtendedPublicKey`; none if `TWHDVersionNone`.
+        TWHDVersion extendedPublicKeyVersion = TWHDVersionNone;
+    };
+
+    struct DerivedKey {
+        PrivateKey privateKey;
+        /// Empty if not requested.
+        std::string extendedPublicKey;
+    };
+
+    /// Derives several keys at once, with the same results as `getKey` and
+    /// `getExtendedPublicKey(derivationPath.purpose(), coin, extendedPublicKeyVersion)`.
+    /// The master node of each curve, and every node shared by several derivation paths, are derived only once.
+    std::vector<DerivedKey> deriveKeys(const std::vector<KeyRequest>& requests) const;
+
     /// Derives the address for a coin (default derivation).
     std::string deriveAddress(TWCoinType coin) const;
 
@@ -63,8 +63,12 @@ AESParameters AESParameters::AESParametersFromJson(const nlohmann::json& json, c
         throw std::invalid_argument("Missing iv");
     }
 
-    auto parameters = AESParameters::AESParametersFromEncryption(getCipher(cipher));
-    parameters.iv = parse_hex(json[CodingKeys::iv].get<std::string>());
+    return AESParametersFromCipher(cipher, parse_hex(json[CodingKeys::iv].get<std::string>()));
+}
+
+AESParameters AESParameters::AESParametersFromCipher(const std::string& cipher, Data iv) {
+    auto parameters = gEncryptionRegistry.at(getCipher(cipher));
+    parameters.iv = std::move(iv);
     return parameters;
 }
 
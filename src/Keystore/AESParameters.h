@@ -44,6 +44,10 @@ struct AESParameters {
     /// Initializes `AESParameters` with a JSON object.
     static AESParameters AESParametersFromJson(const nlohmann::json& json, const std::string& cipher);
 
+    /// Initializes `AESParameters` with a cipher name and an IV.
+    /// \throws std::invalid_argument if the cipher is not supported.
+    static AESParameters AESParametersFromCipher(const std::string& cipher, Data iv);
+
     /// Creates a copy of `this` with a new random IV.
     [[nodiscard]] AESParameters copyWithNewIv() const;
 
@@ -214,17 +214,20 @@ EncryptedPayload EncryptedPayload::regenerateWithRecommendedParams(const Data& p
         return *this;
     }
 
-    const auto decryptedData = ZeroizingData(decrypt(password));
-
     // Regenerate only necessary Scrypt parameters, while leaving other settings as is.
     const auto fixedScryptParams = std::get<ScryptParameters>(params.kdfParams).regenerateWithRecommendedParams();
+    return reencrypt(password, password, fixedScryptParams);
+}
+
+EncryptedPayload EncryptedPayload::reencrypt(const Data& password, const Data& newPassword, const ScryptParameters& scryptParams) const {
+    const auto decryptedData = ZeroizingData(decrypt(password));
     const auto cipherParams = params.cipherParams.copyWithNewIv();
 
-    auto reEncryptedPayload = EncryptedPayload(password, decryptedData.get(), cipherParams, fixedScryptParams);
+    auto reEncryptedPayload = EncryptedPayload(newPassword, decryptedData.get(), cipherParams, scryptParams);
 
     // Try to decrypt the new payload to verify the full backward compatibility, before returning it.
     {
-        auto reDecryptedData = ZeroizingData(reEncryptedPayload.decrypt(password));
+        auto reDecryptedData = ZeroizingData(reEncryptedPayload.decrypt(newPassword));
         if (!isEqualConstantTime(decryptedData.get(), reDecryptedData.get())) {
             throw DecryptionError::invalidKeyFile;
         }
@@ -103,6 +103,12 @@ public:
     /// See implementation for details.
     [[nodiscard]] EncryptedPayload regenerateWithRecommendedParams(const Data& password) const;
 
+    /// Decrypts the payload with `password`, and encrypts it again with `newPassword`, the given Scrypt parameters and a new IV.
+    /// The cipher is left as is. The new payload is verified by decrypting it again.
+    ///
+    /// \throws DecryptionError
+    [[nodiscard]] EncryptedPayload reencrypt(const Data& password, const Data& newPassword, const ScryptParameters& scryptParams) const;
+
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
 
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace TW::Keystore {
+
+/// Bounds the memory reserved by concurrent tasks; a reservation larger than the limit waits until it is alone.
+class MemoryBudget {
+public:
+    explicit MemoryBudget(std::size_t limit) : limit(limit) {}
+
+    class Reservation {
+    public:
+        Reservation(MemoryBudget& budget, std::size_t bytes) : budget(budget), bytes(bytes) { budget.acquire(bytes); }
+        ~Reservation() { budget.release(bytes); }
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+    private:
+        MemoryBudget& budget;
+        std::size_t bytes;
+    };
+
+private:
+    void acquire(std::size_t bytes) {
+        std::unique_lock lock(mutex);
+        released.wait(lock, [this, bytes] { return used == 0 || used + bytes <= limit; });
+        used += bytes;
+    }
+
+    void release(std::size_t bytes) {
+        {
+            std::lock_guard lock(mutex);
+            used -= bytes;
+        }
+        released.notify_all();
+    }
+
+    std::size_t limit;
+    std::size_t used = 0;
+    std::mutex mutex;
+    std::condition_variable released;
+};
+
+} // namespace TW::Keystore
@@ -104,6 +104,11 @@ struct ScryptParameters {
         return salt.size() < minSaltLength;
     }
 
+    /// Approximate number of bytes of memory used to derive a key with these parameters.
+    std::size_t memoryCost() const {
+        return 128 * static_cast<std::size_t>(r) * (static_cast<std::size_t>(n) + p + 2);
+    }
+
     /// Initializes `ScryptParameters` with a JSON object.
     explicit ScryptParameters(const nlohmann::json& json);
 
@@ -3,6 +3,7 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "StoredKey.h"
+#include "StoredKeyCodec.h"
 
 #include "Coin.h"
 #include "HexCoding.h"
@@ -14,7 +15,9 @@
 
 #include <cassert>
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
+#include <streambuf>
 
 using namespace TW;
 
@@ -70,7 +73,7 @@ StoredKey StoredKey::createWithPrivateKeyAddDefaultAddress(
     const auto pubKeyType = TW::publicKeyType(coin);
     const auto pubKey = PrivateKey(privateKeyData, TWCoinTypeCurve(coin)).getPublicKey(pubKeyType);
     const auto address = TW::deriveAddress(coin, PrivateKey(privateKeyData), derivation);
-    key.accounts.emplace_back(address, coin, derivation, derivationPath, hex(pubKey.bytes), "");
+    key.addAccount(address, coin, derivation, derivationPath, hex(pubKey.bytes), "");
     return key;
 }
 
@@ -89,12 +92,12 @@ StoredKey StoredKey::createWithEncodedPrivateKeyAddDefaultAddress(
     const auto pubKeyType = TW::publicKeyType(coin);
     const auto pubKey = privateKey.getPublicKey(pubKeyType);
     const auto address = TW::deriveAddress(coin, privateKey, derivation);
-    key.accounts.emplace_back(address, coin, derivation, derivationPath, hex(pubKey.bytes), "");
+    key.addAccount(address, coin, derivation, derivationPath, hex(pubKey.bytes), "");
     return key;
 }
 
 StoredKey::StoredKey(StoredKeyType type, std::string name, const Data& password, const Data& data, TWStoredKeyEncryptionLevel encryptionLevel, TWStoredKeyEncryption encryption, const std::optional<std::string>& encodedStr)
-    : type(type), id(), name(std::move(name)), accounts() {
+    : type(type), id(), name(std::move(name)), activeAccounts() {
     const auto cipherParams = AESParameters::AESParametersFromEncryption(encryption);
     const auto scryptParams = ScryptParameters::getPreset(encryptionLevel);
     payload = EncryptedPayload(password, data, cipherParams, scryptParams);
@@ -128,61 +131,79 @@ HDWallet<> StoredKey::wallet(const Data& password) const {
     return wallet;
 }
 
+template <typename Visitor>
+std::size_t StoredKey::visitAccounts(TWCoinType coin, Visitor&& visit) const {
+    const auto coinAccounts = accountsByCoin.find(coin);
+    if (coinAccounts == accountsByCoin.end()) {
+        return activeAccounts.size();
+    }
+    for (const auto position : coinAccounts->second) {
+        if (visit(position)) {
+            return position;
+        }
+    }
+    return activeAccounts.size();
+}
+
 std::vector<Account> StoredKey::getAccounts(TWCoinType coin) const {
     std::vector<Account> result;
-    for (auto& account : accounts) {
-        if (account.coin == coin) {
-            result.push_back(account);
+    visitAccounts(coin, [this, &result](std::size_t position) {
+        result.push_back(activeAccounts[position]);
+        return false;
+    });
+    return result;
+}
+
+const Account* StoredKey::findAccount(TWCoinType coin) const {
+    return getDefaultAccountOrAny(coin, nullptr);
+}
+
+const Account* StoredKey::findAccount(TWCoinType coin, TWDerivation derivation) const {
+    const auto position = visitAccounts(coin, [this, derivation](std::size_t position) {
+        return activeAccounts[position].derivation == derivation;
+    });
+    return position < activeAccounts.size() ? &activeAccounts[position] : nullptr;
+}
+
+const Account* StoredKey::findAccount(TWCoinType coin, const std::string& address) const {
+    const Account* found = nullptr;
+    const auto [begin, end] = accountsByAddress.equal_range(address);
+    for (auto indexed = begin; indexed != end; ++indexed) {
+        const auto& account = activeAccounts[indexed->second];
+        if (account.coin == coin && (found == nullptr || &account < found)) {
+            found = &account;
         }
     }
-    return result;
+    return found;
 }
 
-std::optional<Account> StoredKey::getDefaultAccount(TWCoinType coin, const HDWallet<>* wallet) const {
+const Account* StoredKey::getDefaultAccount(TWCoinType coin, const HDWallet<>* wallet) const {
     // there are multiple, try to look for default
     if (wallet != nullptr) {
         const auto address = wallet->deriveAddress(coin);
-        const auto defaultAccount = getAccount(coin, address);
-        if (defaultAccount.has_value()) {
+        const auto* defaultAccount = findAccount(coin, address);
+        if (defaultAccount != nullptr) {
             return defaultAccount;
         }
     }
     // no wallet or not found, rely on derivation=0 condition
-    const auto coinAccounts = getAccounts(coin);
-    for (auto& account : coinAccounts) {
-        if (account.derivation == TWDerivationDefault) {
-            return account;
-        }
-    }
-    return std::nullopt;
+    return findAccount(coin, TWDerivationDefault);
 }
 
-std::optional<Account> StoredKey::getDefaultAccountOrAny(TWCoinType coin, const HDWallet<>* wallet) const {
-    const auto defaultAccount = getDefaultAccount(coin, wallet);
-    if (defaultAccount.has_value()) {
+const Account* StoredKey::getDefaultAccountOrAny(TWCoinType coin, const HDWallet<>* wallet) const {
+    const auto* defaultAccount = getDefaultAccount(coin, wallet);
+    if (defaultAccount != nullptr) {
         return defaultAccount;
     }
     // return any
-    const auto coinAccounts = getAccounts(coin);
-    if (coinAccounts.size() > 0) {
-        return coinAccounts[0];
-    }
-    return std::nullopt;
+    const auto position = visitAccounts(coin, [](std::size_t) { return true; });
+    return position < activeAccounts.size() ? &activeAccounts[position] : nullptr;
 }
 
-std::optional<Account> StoredKey::getAccount(TWCoinType coin, const std::string& address) const {
-    for (auto& account : accounts) {
-        if (account.coin == coin && account.address == address) {
-            return account;
-        }
-    }
-    return std::nullopt;
-}
-
-std::optional<Account> StoredKey::getAccount(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) const {
+const Account* StoredKey::getAccount(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) const {
     // obtain address
     const auto address = wallet.deriveAddress(coin, derivation);
-    return getAccount(coin, address);
+    return findAccount(coin, address);
 }
 
 Account StoredKey::fillAddressIfMissing(Account& account, const HDWallet<>* wallet) const {
@@ -204,9 +225,9 @@ void StoredKey::updateAddressForAccount(const PrivateKey& privKey, Account& acco
 }
 
 std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet<>* wallet) {
-    const auto account = getDefaultAccountOrAny(coin, wallet);
-    if (account.has_value()) {
-        Account accountLval = account.value();
+    const auto* account = getDefaultAccountOrAny(coin, wallet);
+    if (account != nullptr) {
+        Account accountLval = *account;
         return fillAddressIfMissing(accountLval, wallet);
     }
     // not found, add
@@ -222,13 +243,13 @@ std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet<
     const auto pubKey = wallet->getKey(coin, derivationPath).getPublicKey(pubKeyType);
 
     addAccount(address, coin, TWDerivationDefault, derivationPath, hex(pubKey.bytes), extendedPublicKey);
-    return accounts.back();
+    return activeAccounts.back();
 }
 
 Account StoredKey::account(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) {
-    const auto coinAccount = getAccount(coin, derivation, wallet);
-    if (coinAccount.has_value()) {
-        Account accountLval = coinAccount.value();
+    const auto* coinAccount = getAccount(coin, derivation, wallet);
+    if (coinAccount != nullptr) {
+        Account accountLval = *coinAccount;
         return fillAddressIfMissing(accountLval, &wallet);
     }
     // not found, add
@@ -240,17 +261,21 @@ Account StoredKey::account(TWCoinType coin, TWDerivation derivation, const HDWal
     const auto pubKey = wallet.getKey(coin, derivationPath).getPublicKey(pubKeyType);
 
     addAccount(address, coin, derivation, derivationPath, hex(pubKey.bytes), extendedPublicKey);
-    return accounts.back();
+    return activeAccounts.back();
 }
 
 std::optional<const Account> StoredKey::account(TWCoinType coin) const {
-    return getDefaultAccountOrAny(coin, nullptr);
+    const auto* account = getDefaultAccountOrAny(coin, nullptr);
+    if (account == nullptr) {
+        return std::nullopt;
+    }
+    return *account;
 }
 
 std::optional<const Account> StoredKey::account(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) const {
-    const auto account = getAccount(coin, derivation, wallet);
-    if (account.has_value()) {
-        Account accountLval = account.value();
+    const auto* account = getAccount(coin, derivation, wallet);
+    if (account != nullptr) {
+        Account accountLval = *account;
         return fillAddressIfMissing(accountLval, &wallet);
     }
     return std::nullopt;
@@ -263,33 +288,74 @@ void StoredKey::addAccount(
     const DerivationPath& derivationPath,
     const std::string& publicKey,
     const std::string& extendedPublicKey) {
-    if (getAccount(coin, address).has_value()) {
+    if (findAccount(coin, address) != nullptr) {
         // address already present
         return;
     }
-    accounts.emplace_back(address, coin, derivation, derivationPath, publicKey, extendedPublicKey);
+    activeAccounts.emplace_back(address, coin, derivation, derivationPath, publicKey, extendedPublicKey);
+    indexAccount(activeAccounts.size() - 1);
 }
 
 void StoredKey::removeAccount(TWCoinType coin) {
-    accounts.erase(
-        std::remove_if(accounts.begin(), accounts.end(), [coin](Account& account) -> bool { return account.coin == coin; }),
-        accounts.end());
+    if (visitAccounts(coin, [](std::size_t) { return true; }) == activeAccounts.size()) {
+        return;
+    }
+    activeAccounts.erase(
+        std::remove_if(activeAccounts.begin(), activeAccounts.end(), [coin](Account& account) -> bool { return account.coin == coin; }),
+        activeAccounts.end());
+    reindexAccounts();
 }
 
 void StoredKey::removeAccount(TWCoinType coin, TWDerivation derivation) {
-    accounts.erase(
-        std::remove_if(accounts.begin(), accounts.end(), [coin, derivation](Account& account) -> bool {
+    if (findAccount(coin, derivation) == nullptr) {
+        return;
+    }
+    activeAccounts.erase(
+        std::remove_if(activeAccounts.begin(), activeAccounts.end(), [coin, derivation](Account& account) -> bool {
             return account.coin == coin && account.derivation == derivation;
         }),
-        accounts.end());
+        activeAccounts.end());
+    reindexAccounts();
 }
 
 void StoredKey::removeAccount(TWCoinType coin, DerivationPath derivationPath) {
-    accounts.erase(
-        std::remove_if(accounts.begin(), accounts.end(), [coin, derivationPath](Account& account) -> bool {
+    const auto found = visitAccounts(coin, [this, &derivationPath](std::size_t position) {
+        return activeAccounts[position].derivationPath == derivationPath;
+    });
+    if (found == activeAccounts.size()) {
+        return;
+    }
+    activeAccounts.erase(
+        std::remove_if(activeAccounts.begin(), activeAccounts.end(), [coin, &derivationPath](Account& account) -> bool {
             return account.coin == coin && account.derivationPath == derivationPath;
         }),
-        accounts.end());
+        activeAccounts.end());
+    reindexAccounts();
+}
+
+void StoredKey::setAccounts(std::vector<Account> accounts) {
+    activeAccounts = std::move(accounts);
+    reindexAccounts();
+}
+
+void StoredKey::replaceAccount(std::size_t index, Account account) {
+    activeAccounts.at(index) = std::move(account);
+    reindexAccounts();
+}
+
+void StoredKey::reindexAccounts() {
+    accountsByCoin.clear();
+    accountsByAddress.clear();
+    accountsByAddress.reserve(activeAccounts.size());
+    for (std::size_t position = 0; position < activeAccounts.size(); ++position) {
+        indexAccount(position);
+    }
+}
+
+void StoredKey::indexAccount(std::size_t position) {
+    const auto& account = activeAccounts[position];
+    accountsByCoin[account.coin].push_back(position);
+    accountsByAddress.emplace(account.address, position);
 }
 
 const PrivateKey StoredKey::privateKey(TWCoinType coin, const Data& password) {
@@ -310,7 +376,7 @@ void StoredKey::fixAddresses(const Data& password) {
     switch (type) {
     case StoredKeyType::mnemonicPhrase: {
         const auto wallet = this->wallet(password);
-        for (auto& account : accounts) {
+        for (auto& account : activeAccounts) {
             if (!account.address.empty() && !account.publicKey.empty() &&
                 TW::validateAddress(account.coin, account.address)) {
                 continue;
@@ -323,7 +389,7 @@ void StoredKey::fixAddresses(const Data& password) {
 
     case StoredKeyType::privateKey: {
         auto key = PrivateKey(payload.decrypt(password));
-        for (auto& account : accounts) {
+        for (auto& account : activeAccounts) {
             if (!account.address.empty() && !account.publicKey.empty() &&
                 TW::validateAddress(account.coin, account.address)) {
                 continue;
@@ -332,6 +398,7 @@ void StoredKey::fixAddresses(const Data& password) {
         }
     } break;
     }
+    reindexAccounts();
 }
 
 void StoredKey::fixEncryption(const Data& password) {
@@ -358,21 +425,50 @@ void StoredKey::fixEncryption(const Data& password) {
     }
 }
 
+void StoredKey::reencrypt(const Data& password, const Data& newPassword, std::optional<TWStoredKeyEncryptionLevel> encryptionLevel) {
+    const auto scryptParams = [&encryptionLevel](const EncryptedPayload& encrypted) {
+        if (encryptionLevel.has_value()) {
+            return ScryptParameters::getPreset(*encryptionLevel);
+        }
+        if (const auto* current = std::get_if<ScryptParameters>(&encrypted.params.kdfParams); current) {
+            return current->regenerateWithRecommendedParams();
+        }
+        return ScryptParameters::getPreset(TWStoredKeyEncryptionLevelDefault);
+    };
+
+    // Replace the payloads only once both are re-encrypted, like in `fixEncryption`.
+    auto reencryptedPayload = payload.reencrypt(password, newPassword, scryptParams(payload));
+    std::optional<EncryptedPayload> reencryptedEncodedPayload;
+    if (encodedPayload.has_value()) {
+        reencryptedEncodedPayload = encodedPayload->reencrypt(password, newPassword, scryptParams(*encodedPayload));
+    }
+
+    payload = std::move(reencryptedPayload);
+    if (reencryptedEncodedPayload.has_value()) {
+        encodedPayload = std::move(*reencryptedEncodedPayload);
+    }
+}
+
 bool StoredKey::updateAddress(TWCoinType coin) {
     bool addressUpdated = false;
     const auto publicKeyType = TW::publicKeyType(coin);
 
-    for (auto& account : accounts) {
+    visitAccounts(coin, [this, publicKeyType, &addressUpdated](std::size_t position) {
+        auto& account = activeAccounts[position];
         // Update the address for the given chain if only `publicKey` is set.
-        if (account.coin == coin && !account.publicKey.empty()) {
+        if (!account.publicKey.empty()) {
             const auto publicKeyBytes = parse_hex(account.publicKey);
             const PublicKey publicKey(publicKeyBytes, publicKeyType);
             account.address = TW::deriveAddress(account.coin, publicKey, account.derivation);
 
             addressUpdated = true;
         }
-    }
+        return false;
+    });
 
+    if (addressUpdated) {
+        reindexAccounts();
+    }
     return addressUpdated;
 }
 
@@ -457,19 +553,20 @@ void StoredKey::loadJson(const nlohmann::json& json) {
     if (json.count(CodingKeys::SK::activeAccounts) != 0 &&
         json[CodingKeys::SK::activeAccounts].is_array()) {
         for (auto& accountJSON : json[CodingKeys::SK::activeAccounts]) {
-            accounts.emplace_back(accountJSON);
+            activeAccounts.emplace_back(accountJSON);
         }
     }
 
-    if (accounts.empty() && json.count(CodingKeys::SK::address) != 0 &&
+    if (activeAccounts.empty() && json.count(CodingKeys::SK::address) != 0 &&
         json[CodingKeys::SK::address].is_string()) {
         TWCoinType coin = TWCoinTypeEthereum;
         if (json.count(CodingKeys::SK::coin) != 0) {
             coin = json[CodingKeys::SK::coin].get<TWCoinType>();
         }
         auto address = json[CodingKeys::SK::address].get<std::string>();
-        accounts.emplace_back(address, coin, TWDerivationDefault, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0), "", "");
+        activeAccounts.emplace_back(address, coin, TWDerivationDefault, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0), "", "");
     }
+    reindexAccounts();
 }
 
 nlohmann::json StoredKey::json() const {
@@ -496,7 +593,7 @@ nlohmann::json StoredKey::json() const {
     }
 
     nlohmann::json accountsJSON = nlohmann::json::array();
-    for (const auto& account : accounts) {
+    for (const auto& account : activeAccounts) {
         accountsJSON.push_back(account.json());
     }
     j[CodingKeys::SK::activeAccounts] = accountsJSON;
@@ -506,8 +603,50 @@ nlohmann::json StoredKey::json() const {
 
 // File operations
 
+namespace {
+
+/// Reads a whole file, with a single read for regular files.
+/// Key files are not memory-mapped: `store` rewrites them in place, which would fault a concurrent reader of the mapping.
+/// \throws std::invalid_argument if the file can't be opened.
+std::string readFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        throw std::invalid_argument("Can't open file");
+    }
+    std::string contents;
+    const auto size = static_cast<std::streamoff>(stream.tellg());
+    if (size > 0 && stream.seekg(0)) {
+        contents.resize(static_cast<std::size_t>(size));
+        stream.read(contents.data(), size);
+        // The file may have been truncated meanwhile.
+        contents.resize(static_cast<std::size_t>(stream.gcount()));
+        return contents;
+    }
+    // Not a regular file, or empty: read until the end.
+    stream.clear();
+    stream.seekg(0);
+    contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    return contents;
+}
+
+/// Input stream buffer over existing memory, to parse it like a file stream without copying it.
+class MemoryBuffer : public std::streambuf {
+public:
+    explicit MemoryBuffer(std::string_view buffer) {
+        auto* begin = const_cast<char*>(buffer.data());
+        setg(begin, begin, begin + buffer.size());
+    }
+};
+
+} // namespace
+
+void StoredKey::storeToBuffer(std::string& out) const {
+    writeStoredKeyJson(*this, out);
+}
+
 void StoredKey::store(const std::string& path) const {
-    const std::string jsonData = json().dump();
+    std::string jsonData;
+    storeToBuffer(jsonData);
 
     auto stream = std::ofstream(path);
     if (!stream) {
@@ -535,10 +674,18 @@ void StoredKey::storeWithTemporaryFile(const std::string& path, const std::strin
 }
 
 StoredKey StoredKey::load(const std::string& path) {
-    std::ifstream stream(path);
-    if (!stream.is_open()) {
-        throw std::invalid_argument("Can't open file");
+    return loadFromBuffer(readFile(path));
+}
+
+StoredKey StoredKey::loadFromBuffer(std::string_view buffer) {
+    StoredKey key;
+    if (readStoredKeyJson(buffer, key)) {
+        return key;
     }
+
+    // Not in the standard format: let the JSON document decide, or report the error.
+    MemoryBuffer memory(buffer);
+    std::istream stream(&memory);
     nlohmann::json j;
     stream >> j;
 
@@ -16,6 +16,8 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TW::Keystore {
@@ -42,9 +44,6 @@ public:
     /// Optional encoded payload. Used when an encoded private key is imported.
     std::optional<EncryptedPayload> encodedPayload;
 
-    /// Active accounts.  Address should be unique.
-    std::vector<Account> accounts;
-
     /// Create a new StoredKey, with the given name, mnemonic and password.
     /// @throws std::invalid_argument if mnemonic is invalid
     static StoredKey createWithMnemonic(const std::string& name, const Data& password, const std::string& mnemonic, TWStoredKeyEncryptionLevel encryptionLevel, TWStoredKeyEncryption encryption = TWStoredKeyEncryptionAes128Ctr);
@@ -91,9 +90,23 @@ public:
     /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
     [[nodiscard]] HDWallet<> wallet(const Data& password) const;
 
+    /// Returns the active accounts.  Address should be unique.
+    [[nodiscard]] const std::vector<Account>& accounts() const { return activeAccounts; }
+
     /// Returns all the accounts for a specific coin: 0, 1, or more.
     [[nodiscard]] std::vector<Account> getAccounts(TWCoinType coin) const;
 
+    /// Returns the account for a specific coin, without copying it.
+    /// In case of muliple accounts, the default derivation is returned, or the first one is returned.
+    /// The pointer is valid until accounts are added or removed.
+    [[nodiscard]] const Account* findAccount(TWCoinType coin) const;
+
+    /// Returns the first account for a specific coin with the given (stored) derivation, without copying it.
+    [[nodiscard]] const Account* findAccount(TWCoinType coin, TWDerivation derivation) const;
+
+    /// Returns the first account for a specific coin with the given address, without copying it.
+    [[nodiscard]] const Account* findAccount(TWCoinType coin, const std::string& address) const;
+
     /// If found, returns the account for a specific coin. In case of muliple accounts, the default derivation is returned, or the first one is returned.
     /// If none exists, and wallet is not null, an account is created (with default derivation).
     std::optional<const Account> account(TWCoinType coin, const HDWallet<>* wallet);
@@ -129,6 +142,13 @@ public:
     /// Remove the account for a specific coin with the given derivation path.
     void removeAccount(TWCoinType coin, DerivationPath derivationPath);
 
+    /// Replaces all the accounts.
+    void setAccounts(std::vector<Account> accounts);
+
+    /// Replaces the account at `index`.
+    /// @throws std::out_of_range if there is no account at `index`
+    void replaceAccount(std::size_t index, Account account);
+
     /// Returns the private key for a specific coin, using default derivation, creating an account if necessary.
     ///
     /// \throws std::invalid_argument if this key is of a type other than
@@ -142,17 +162,30 @@ public:
     const PrivateKey privateKey(TWCoinType coin, TWDerivation derivation, const Data& password);
 
     /// Loads and decrypts a stored key from a file.
+    /// The file is read into memory at once, and parsed with `loadFromBuffer`.
     ///
     /// \param path file path to load from.
     /// \returns decrypted key.
     /// \throws DecryptionError
     static StoredKey load(const std::string& path);
 
+    /// Loads a stored key from the contents of a key file.
+    /// Files in the standard format are read without building a JSON document; the result is the same as
+    /// `createWithJson` on the parsed JSON, including the errors thrown.
+    ///
+    /// \param buffer JSON contents of a key file.
+    /// \throws DecryptionError
+    static StoredKey loadFromBuffer(std::string_view buffer);
+
     /// Stores the key into an encrypted file.
     ///
     /// \param path file path to store in.
     void store(const std::string& path) const;
 
+    /// Writes the contents of the key file into `out`, replacing its contents.
+    /// The output is identical to `json().dump()`, and is written into a buffer allocated once with the exact size.
+    void storeToBuffer(std::string& out) const;
+
     /// Stores the key into an encrypted file, using a temporary file to ensure atomicity of the operation.
     ///
     /// \param path file path to store in.
@@ -178,6 +211,14 @@ public:
     /// Only Scrypt encryption parameters are supported by the current implementation's fix-up logic.
     void fixEncryption(const Data& password);
 
+    /// Re-encrypts all encrypted data with a new password, e.g. to rotate the password or upgrade weak encryption parameters.
+    /// Uses the Scrypt parameters of `encryptionLevel` if set, or else the current Scrypt parameters with a new salt.
+    /// PBKDF2 payloads are re-encrypted with Scrypt, using the default encryption level if `encryptionLevel` is not set.
+    /// The key is left unchanged if any payload cannot be re-encrypted.
+    ///
+    /// \throws DecryptionError
+    void reencrypt(const Data& password, const Data& newPassword, std::optional<TWStoredKeyEncryptionLevel> encryptionLevel = std::nullopt);
+
     /// Re-derives address for the account(s) associated with the given coin.
     ///
     /// This method can be used if address format has been changed.
@@ -209,23 +250,40 @@ private:
 
     /// Find default account for coin, if exists.  If multiple exist, default is returned.
     /// Optional wallet is needed to derive default address
-    std::optional<Account> getDefaultAccount(TWCoinType coin, const HDWallet<>* wallet) const;
+    const Account* getDefaultAccount(TWCoinType coin, const HDWallet<>* wallet) const;
 
     /// Find account for coin, if exists.  If multiple exist, default is returned, or any.
     /// Optional wallet is needed to derive default address
-    std::optional<Account> getDefaultAccountOrAny(TWCoinType coin, const HDWallet<>* wallet) const;
-
-    /// Find account by coin+address (should be one, if multiple, first is returned)
-    [[nodiscard]] std::optional<Account> getAccount(TWCoinType coin, const std::string& address) const;
+    const Account* getDefaultAccountOrAny(TWCoinType coin, const HDWallet<>* wallet) const;
 
     /// Find account by coin+derivation (should be one, if multiple, first is returned)
-    [[nodiscard]] std::optional<Account> getAccount(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) const;
+    [[nodiscard]] const Account* getAccount(TWCoinType coin, TWDerivation derivation, const HDWallet<>& wallet) const;
+
+    /// Calls `visit` with the position of every account of a coin, in order, until it returns true.
+    /// Returns the position it stopped at, or `activeAccounts.size()`.
+    template <typename Visitor>
+    std::size_t visitAccounts(TWCoinType coin, Visitor&& visit) const;
+
+    /// Rebuilds the account index; called by every member function that modifies the accounts.
+    void reindexAccounts();
+
+    /// Adds the account at `position` to the index; accounts must be indexed in order.
+    void indexAccount(std::size_t position);
 
     /// Re-derive account address if missing
     Account fillAddressIfMissing(Account& account, const HDWallet<>* wallet) const;
 
     /// Re-derives public key and address for the specified account.
     static void updateAddressForAccount(const PrivateKey& privKey, Account& account);
+
+    /// Active accounts, indexed by coin and address.
+    std::vector<Account> activeAccounts;
+
+    /// Positions in `activeAccounts` of the accounts of each coin, in order.
+    std::unordered_map<TWCoinType, std::vector<std::size_t>> accountsByCoin;
+
+    /// Positions in `activeAccounts` of the accounts with each address; an address may be used by several coins.
+    std::unordered_multimap<std::string, std::size_t> accountsByAddress;
 };
 
 } // namespace TW::Keystore
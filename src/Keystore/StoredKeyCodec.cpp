@@ -0,0 +1,759 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "StoredKeyCodec.h"
+
+#include "StoredKey.h"
+#include "../HexCoding.h"
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace TW::Keystore {
+
+// Key names are the same as the `CodingKeys` of `StoredKey`, `Account`, `EncryptedPayload` and the parameter types.
+
+namespace {
+
+// -------
+// Writing
+// -------
+
+/// Counts the bytes that would be written.
+struct CountingSink {
+    std::size_t size = 0;
+
+    void put(char) { ++size; }
+    void append(std::string_view value) { size += value.size(); }
+};
+
+struct StringSink {
+    std::string& out;
+
+    void put(char c) { out.push_back(c); }
+    void append(std::string_view value) { out.append(value); }
+};
+
+/// Returns true if `value` is valid UTF-8, by the same rules as `nlohmann::json::dump()`.
+bool isValidUTF8(std::string_view value) {
+    std::size_t i = 0;
+    while (i < value.size()) {
+        const auto lead = static_cast<std::uint8_t>(value[i]);
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        }
+        std::size_t length = 0;
+        std::uint8_t low = 0x80;
+        std::uint8_t high = 0xbf;
+        if (lead >= 0xc2 && lead <= 0xdf) {
+            length = 2;
+        } else if (lead >= 0xe0 && lead <= 0xef) {
+            length = 3;
+            low = lead == 0xe0 ? 0xa0 : 0x80; // overlong
+            high = lead == 0xed ? 0x9f : 0xbf; // surrogates
+        } else if (lead >= 0xf0 && lead <= 0xf4) {
+            length = 4;
+            low = lead == 0xf0 ? 0x90 : 0x80; // overlong
+            high = lead == 0xf4 ? 0x8f : 0xbf; // above U+10FFFF
+        } else {
+            return false;
+        }
+        if (value.size() - i < length) {
+            return false;
+        }
+        for (std::size_t k = 1; k < length; ++k) {
+            const auto byte = static_cast<std::uint8_t>(value[i + k]);
+            if (byte < (k == 1 ? low : 0x80) || byte > (k == 1 ? high : 0xbf)) {
+                return false;
+            }
+        }
+        i += length;
+    }
+    return true;
+}
+
+/// Writes compact JSON exactly like `nlohmann::json::dump()`.
+/// Object keys must be written in sorted order, which is how `nlohmann::json` orders them.
+template <typename Sink>
+class JSONWriter {
+  public:
+    explicit JSONWriter(Sink& sink) : sink(sink) {}
+
+    void beginObject() {
+        separate();
+        sink.put('{');
+        first = true;
+    }
+
+    void endObject() {
+        sink.put('}');
+        first = false;
+    }
+
+    void beginArray() {
+        separate();
+        sink.put('[');
+        first = true;
+    }
+
+    void endArray() {
+        sink.put(']');
+        first = false;
+    }
+
+    /// The name must not need escaping.
+    void key(std::string_view name) {
+        separate();
+        sink.put('"');
+        sink.append(name);
+        sink.append("\":");
+        first = true;
+    }
+
+    void string(std::string_view value) {
+        separate();
+        if (!isValidUTF8(value)) {
+            // Let nlohmann::json report the error, exactly like `dump()`.
+            (void)nlohmann::json(std::string(value)).dump();
+        }
+        sink.put('"');
+        for (const auto c : value) {
+            switch (c) {
+            case '"': sink.append("\\\""); break;
+            case '\\': sink.append("\\\\"); break;
+            case '\b': sink.append("\\b"); break;
+            case '\f': sink.append("\\f"); break;
+            case '\n': sink.append("\\n"); break;
+            case '\r': sink.append("\\r"); break;
+            case '\t': sink.append("\\t"); break;
+            default:
+                if (static_cast<std::uint8_t>(c) < 0x20) {
+                    sink.append("\\u00");
+                    sink.put(digits[static_cast<std::uint8_t>(c) >> 4]);
+                    sink.put(digits[c & 0x0f]);
+                } else {
+                    sink.put(c);
+                }
+            }
+        }
+        sink.put('"');
+        first = false;
+    }
+
+    /// Writes bytes as a lowercase hex string, like `hex()`.
+    void hex(const Data& bytes) {
+        separate();
+        sink.put('"');
+        for (const auto byte : bytes) {
+            sink.put(digits[byte >> 4]);
+            sink.put(digits[byte & 0x0f]);
+        }
+        sink.put('"');
+        first = false;
+    }
+
+    template <typename Integer>
+    void number(Integer value) {
+        separate();
+        char buffer[24];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        sink.append(std::string_view(buffer, result.ptr - buffer));
+        first = false;
+    }
+
+  private:
+    static constexpr char digits[] = "0123456789abcdef";
+
+    Sink& sink;
+    /// True if no comma is due before the next value.
+    bool first = true;
+
+    void separate() {
+        if (!first) {
+            sink.put(',');
+        }
+    }
+};
+
+template <typename Sink>
+void writeAccount(JSONWriter<Sink>& writer, const Account& account) {
+    writer.beginObject();
+    writer.key("address");
+    writer.string(account.address);
+    writer.key("coin");
+    writer.number(static_cast<std::uint32_t>(account.coin));
+    if (account.derivation != TWDerivationDefault) {
+        writer.key("derivation");
+        writer.number(static_cast<int>(account.derivation));
+    }
+    writer.key("derivationPath");
+    writer.string(account.derivationPath.string());
+    if (!account.extendedPublicKey.empty()) {
+        writer.key("extendedPublicKey");
+        writer.string(account.extendedPublicKey);
+    }
+    if (!account.publicKey.empty()) {
+        writer.key("publicKey");
+        writer.string(account.publicKey);
+    }
+    writer.endObject();
+}
+
+template <typename Sink>
+void writePayload(JSONWriter<Sink>& writer, const EncryptedPayload& payload) {
+    const auto& params = payload.params;
+    writer.beginObject();
+    writer.key("cipher");
+    writer.string(params.cipherParams.mCipher);
+    writer.key("cipherparams");
+    writer.beginObject();
+    writer.key("iv");
+    writer.hex(params.cipherParams.iv);
+    writer.endObject();
+    writer.key("ciphertext");
+    writer.hex(payload.encrypted);
+    if (const auto* scryptParams = std::get_if<ScryptParameters>(&params.kdfParams); scryptParams) {
+        writer.key("kdf");
+        writer.string("scrypt");
+        writer.key("kdfparams");
+        writer.beginObject();
+        writer.key("dklen");
+        writer.number(scryptParams->desiredKeyLength);
+        writer.key("n");
+        writer.number(scryptParams->n);
+        writer.key("p");
+        writer.number(scryptParams->p);
+        writer.key("r");
+        writer.number(scryptParams->r);
+        writer.key("salt");
+        writer.hex(scryptParams->salt);
+        writer.endObject();
+    } else if (const auto* pbkdf2Params = std::get_if<PBKDF2Parameters>(&params.kdfParams); pbkdf2Params) {
+        writer.key("kdf");
+        writer.string("pbkdf2");
+        writer.key("kdfparams");
+        writer.beginObject();
+        writer.key("c");
+        writer.number(pbkdf2Params->iterations);
+        writer.key("dklen");
+        writer.number(pbkdf2Params->desiredKeyLength);
+        writer.key("salt");
+        writer.hex(pbkdf2Params->salt);
+        writer.endObject();
+    }
+    writer.key("mac");
+    writer.hex(payload._mac);
+    writer.endObject();
+}
+
+template <typename Sink>
+void writeStoredKey(Sink& sink, const StoredKey& key) {
+    JSONWriter writer(sink);
+    writer.beginObject();
+    writer.key("activeAccounts");
+    writer.beginArray();
+    for (const auto& account : key.accounts()) {
+        writeAccount(writer, account);
+    }
+    writer.endArray();
+    writer.key("crypto");
+    writePayload(writer, key.payload);
+    if (key.encodedPayload) {
+        writer.key("encodedCrypto");
+        writePayload(writer, *key.encodedPayload);
+    }
+    if (key.id) {
+        writer.key("id");
+        writer.string(*key.id);
+    }
+    writer.key("name");
+    writer.string(key.name);
+    writer.key("type");
+    writer.string(key.type == StoredKeyType::mnemonicPhrase ? "mnemonic" : "private-key");
+    writer.key("version");
+    writer.number(3);
+    writer.endObject();
+}
+
+// -------
+// Reading
+// -------
+
+enum class Field : std::uint8_t {
+    unknown,
+    // key file
+    activeAccounts,
+    address,
+    coin,
+    crypto,
+    cryptoUppercase,
+    encodedCrypto,
+    id,
+    name,
+    type,
+    // encrypted payload
+    cipher,
+    cipherParams,
+    cipherText,
+    kdf,
+    kdfParams,
+    mac,
+    // cipher params
+    iv,
+    // kdf params
+    salt,
+    desiredKeyLength,
+    n,
+    p,
+    r,
+    iterations,
+    // account (and address, coin)
+    derivation,
+    derivationPath,
+    extendedPublicKey,
+    publicKey,
+};
+
+enum class FrameKind : std::uint8_t {
+    key,
+    payload,
+    cipherParams,
+    kdfParams,
+    accounts,
+    account,
+    skipped,
+};
+
+Field fieldOf(FrameKind kind, std::string_view name) {
+    switch (kind) {
+    case FrameKind::key:
+        if (name == "activeAccounts") return Field::activeAccounts;
+        if (name == "address") return Field::address;
+        if (name == "coin") return Field::coin;
+        if (name == "crypto") return Field::crypto;
+        if (name == "Crypto") return Field::cryptoUppercase;
+        if (name == "encodedCrypto") return Field::encodedCrypto;
+        if (name == "id") return Field::id;
+        if (name == "name") return Field::name;
+        if (name == "type") return Field::type;
+        break;
+    case FrameKind::payload:
+        if (name == "cipher") return Field::cipher;
+        if (name == "cipherparams") return Field::cipherParams;
+        if (name == "ciphertext") return Field::cipherText;
+        if (name == "kdf") return Field::kdf;
+        if (name == "kdfparams") return Field::kdfParams;
+        if (name == "mac") return Field::mac;
+        break;
+    case FrameKind::cipherParams:
+        if (name == "iv") return Field::iv;
+        break;
+    case FrameKind::kdfParams:
+        if (name == "salt") return Field::salt;
+        if (name == "dklen") return Field::desiredKeyLength;
+        if (name == "n") return Field::n;
+        if (name == "p") return Field::p;
+        if (name == "r") return Field::r;
+        if (name == "c") return Field::iterations;
+        break;
+    case FrameKind::account:
+        if (name == "address") return Field::address;
+        if (name == "coin") return Field::coin;
+        if (name == "derivation") return Field::derivation;
+        if (name == "derivationPath") return Field::derivationPath;
+        if (name == "extendedPublicKey") return Field::extendedPublicKey;
+        if (name == "publicKey") return Field::publicKey;
+        break;
+    default:
+        break;
+    }
+    return Field::unknown;
+}
+
+struct PayloadFields {
+    std::optional<std::string> cipher;
+    std::optional<std::string> kdf;
+    std::optional<std::string> cipherText;
+    std::optional<std::string> mac;
+    std::optional<std::string> iv;
+    bool hasCipherParams = false;
+    bool hasKdfParams = false;
+    std::optional<std::string> salt;
+    std::optional<std::uint64_t> desiredKeyLength;
+    std::optional<std::uint64_t> n;
+    std::optional<std::uint64_t> p;
+    std::optional<std::uint64_t> r;
+    std::optional<std::uint64_t> iterations;
+};
+
+struct AccountFields {
+    std::optional<std::string> address;
+    std::optional<std::string> derivationPath;
+    std::optional<std::string> extendedPublicKey;
+    std::optional<std::string> publicKey;
+    std::optional<std::uint64_t> coin;
+    std::optional<std::uint64_t> derivation;
+};
+
+struct KeyFields {
+    std::optional<std::string> type;
+    std::optional<std::string> name;
+    std::optional<std::string> id;
+    std::optional<std::string> address;
+    std::optional<std::uint64_t> coin;
+    std::optional<PayloadFields> crypto;
+    std::optional<PayloadFields> cryptoUppercase;
+    std::optional<PayloadFields> encodedCrypto;
+    std::optional<std::vector<AccountFields>> accounts;
+};
+
+/// nlohmann::json SAX handler collecting the fields of a key file.
+/// Returning false from a handler stops parsing: the file is then left to the DOM parser.
+class KeyFileReader {
+  public:
+    KeyFields fields;
+
+    bool null() { return scalar(); }
+    bool boolean(bool) { return scalar(); }
+    bool number_integer(std::int64_t) { return scalar(); }
+    bool number_float(double, const std::string&) { return scalar(); }
+    bool binary(nlohmann::json::binary_t&) { return false; }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception&) { return false; }
+
+    bool number_unsigned(std::uint64_t value) {
+        auto* slot = unsignedSlot();
+        if (slot == nullptr) {
+            return scalar();
+        }
+        *slot = value;
+        return true;
+    }
+
+    bool string(std::string& value) {
+        auto* slot = stringSlot();
+        if (slot == nullptr) {
+            return scalar();
+        }
+        *slot = std::move(value);
+        return true;
+    }
+
+    bool key(std::string& name) {
+        auto& frame = frames.back();
+        if (frame.kind == FrameKind::skipped) {
+            return true;
+        }
+        frame.field = fieldOf(frame.kind, name);
+        if (frame.field == Field::unknown) {
+            return true;
+        }
+        // the DOM keeps the last duplicate
+        const auto bit = std::uint32_t(1) << static_cast<unsigned>(frame.field);
+        if ((frame.seen & bit) != 0) {
+            return false;
+        }
+        frame.seen |= bit;
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (frames.empty()) {
+            frames.push_back({FrameKind::key});
+            return true;
+        }
+        auto& frame = frames.back();
+        if (frame.kind == FrameKind::skipped || (frame.kind != FrameKind::accounts && frame.field == Field::unknown)) {
+            frames.push_back({FrameKind::skipped});
+            return true;
+        }
+        if (frame.kind == FrameKind::accounts) {
+            fields.accounts->emplace_back();
+            frames.push_back({FrameKind::account});
+            return true;
+        }
+        switch (frame.field) {
+        case Field::crypto:
+            frames.push_back({FrameKind::payload, &fields.crypto.emplace()});
+            return true;
+        case Field::cryptoUppercase:
+            frames.push_back({FrameKind::payload, &fields.cryptoUppercase.emplace()});
+            return true;
+        case Field::encodedCrypto:
+            frames.push_back({FrameKind::payload, &fields.encodedCrypto.emplace()});
+            return true;
+        case Field::cipherParams:
+            frame.payload->hasCipherParams = true;
+            frames.push_back({FrameKind::cipherParams, frame.payload});
+            return true;
+        case Field::kdfParams:
+            frame.payload->hasKdfParams = true;
+            frames.push_back({FrameKind::kdfParams, frame.payload});
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool end_object() {
+        frames.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (frames.empty() || frames.back().kind == FrameKind::accounts) {
+            return false;
+        }
+        const auto& frame = frames.back();
+        if (frame.kind == FrameKind::skipped || frame.field == Field::unknown) {
+            frames.push_back({FrameKind::skipped});
+            return true;
+        }
+        if (frame.field == Field::activeAccounts) {
+            fields.accounts.emplace();
+            frames.push_back({FrameKind::accounts});
+            return true;
+        }
+        return false;
+    }
+
+    bool end_array() {
+        frames.pop_back();
+        return true;
+    }
+
+  private:
+    struct Frame {
+        FrameKind kind;
+        PayloadFields* payload = nullptr;
+        Field field = Field::unknown;
+        /// Bit set of the fields seen in this object.
+        std::uint32_t seen = 0;
+    };
+
+    std::vector<Frame> frames;
+
+    /// A value that is not stored: fine if it is ignored, an error if a known field has an unexpected type.
+    bool scalar() const {
+        if (frames.empty() || frames.back().kind == FrameKind::accounts) {
+            return false;
+        }
+        return frames.back().kind == FrameKind::skipped || frames.back().field == Field::unknown;
+    }
+
+    std::optional<std::string>* stringSlot() {
+        if (frames.empty()) {
+            return nullptr;
+        }
+        const auto& frame = frames.back();
+        switch (frame.kind) {
+        case FrameKind::key:
+            switch (frame.field) {
+            case Field::type: return &fields.type;
+            case Field::name: return &fields.name;
+            case Field::id: return &fields.id;
+            case Field::address: return &fields.address;
+            default: return nullptr;
+            }
+        case FrameKind::payload:
+            switch (frame.field) {
+            case Field::cipher: return &frame.payload->cipher;
+            case Field::kdf: return &frame.payload->kdf;
+            case Field::cipherText: return &frame.payload->cipherText;
+            case Field::mac: return &frame.payload->mac;
+            default: return nullptr;
+            }
+        case FrameKind::cipherParams:
+            return frame.field == Field::iv ? &frame.payload->iv : nullptr;
+        case FrameKind::kdfParams:
+            return frame.field == Field::salt ? &frame.payload->salt : nullptr;
+        case FrameKind::account: {
+            auto& account = fields.accounts->back();
+            switch (frame.field) {
+            case Field::address: return &account.address;
+            case Field::derivationPath: return &account.derivationPath;
+            case Field::extendedPublicKey: return &account.extendedPublicKey;
+            case Field::publicKey: return &account.publicKey;
+            default: return nullptr;
+            }
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    std::optional<std::uint64_t>* unsignedSlot() {
+        if (frames.empty()) {
+            return nullptr;
+        }
+        const auto& frame = frames.back();
+        switch (frame.kind) {
+        case FrameKind::key:
+            return frame.field == Field::coin ? &fields.coin : nullptr;
+        case FrameKind::kdfParams:
+            switch (frame.field) {
+            case Field::desiredKeyLength: return &frame.payload->desiredKeyLength;
+            case Field::n: return &frame.payload->n;
+            case Field::p: return &frame.payload->p;
+            case Field::r: return &frame.payload->r;
+            case Field::iterations: return &frame.payload->iterations;
+            default: return nullptr;
+            }
+        case FrameKind::account:
+            switch (frame.field) {
+            case Field::coin: return &fields.accounts->back().coin;
+            case Field::derivation: return &fields.accounts->back().derivation;
+            default: return nullptr;
+            }
+        default:
+            return nullptr;
+        }
+    }
+};
+
+/// Builds a payload like `EncryptedPayload(const nlohmann::json&)`, or returns nullopt where that would throw.
+std::optional<EncryptedPayload> buildPayload(const PayloadFields& fields) {
+    if (!fields.cipher || !fields.kdf || !fields.cipherText || !fields.mac || !fields.hasCipherParams || !fields.hasKdfParams || !fields.iv) {
+        return std::nullopt;
+    }
+
+    auto cipherParams = AESParameters::AESParametersFromCipher(*fields.cipher, parse_hex(*fields.iv));
+    if (cipherParams.validate().has_value()) {
+        return std::nullopt;
+    }
+
+    std::optional<EncryptionParameters> params;
+    if (*fields.kdf == "scrypt") {
+        if (!fields.n || !fields.p || !fields.r || !fields.desiredKeyLength) {
+            return std::nullopt;
+        }
+        Data salt;
+        if (fields.salt) {
+            const auto res = parse_hex_checked(*fields.salt);
+            if (res.isFailure()) {
+                return std::nullopt;
+            }
+            salt = res.payload();
+        }
+        ScryptParameters scryptParams(std::move(salt), static_cast<std::uint32_t>(*fields.n), static_cast<std::uint32_t>(*fields.r),
+                                      static_cast<std::uint32_t>(*fields.p), static_cast<std::size_t>(*fields.desiredKeyLength));
+        if (scryptParams.validate().has_value()) {
+            return std::nullopt;
+        }
+        params.emplace(std::move(cipherParams), std::move(scryptParams));
+    } else if (*fields.kdf == "pbkdf2") {
+        if (!fields.salt || !fields.desiredKeyLength) {
+            return std::nullopt;
+        }
+        const auto iterations = fields.iterations ? static_cast<std::uint32_t>(*fields.iterations) : PBKDF2Parameters::defaultIterations;
+        params.emplace(std::move(cipherParams), PBKDF2Parameters(parse_hex(*fields.salt), iterations, static_cast<std::size_t>(*fields.desiredKeyLength)));
+    } else {
+        return std::nullopt;
+    }
+
+    return EncryptedPayload(std::move(*params), parse_hex(*fields.cipherText), parse_hex(*fields.mac));
+}
+
+/// Builds an account like `Account(const nlohmann::json&)`, or returns nullopt for the legacy derivation path format.
+std::optional<Account> buildAccount(AccountFields& fields) {
+    if (!fields.derivationPath) {
+        return std::nullopt;
+    }
+    Account account;
+    if (fields.derivation) {
+        account.derivation = TWDerivation(static_cast<std::uint32_t>(*fields.derivation));
+    }
+    account.derivationPath = DerivationPath(*fields.derivationPath);
+    if (fields.coin) {
+        account.coin = TWCoinType(static_cast<std::uint32_t>(*fields.coin));
+    } else if (account.derivationPath.indices.size() >= 2) {
+        // legacy format, get coin from derivation path
+        account.coin = TWCoinType(account.derivationPath.indices[1].value);
+    } else {
+        return std::nullopt;
+    }
+    account.address = std::move(fields.address).value_or("");
+    account.extendedPublicKey = std::move(fields.extendedPublicKey).value_or("");
+    account.publicKey = std::move(fields.publicKey).value_or("");
+    return account;
+}
+
+/// Fills `key` like `StoredKey::loadJson`.
+bool buildStoredKey(KeyFields& fields, StoredKey& key) {
+    key.type = fields.type && *fields.type == "mnemonic" ? StoredKeyType::mnemonicPhrase : StoredKeyType::privateKey;
+    if (fields.name) {
+        key.name = std::move(*fields.name);
+    }
+    if (fields.id) {
+        key.id = std::move(*fields.id);
+    }
+
+    // Workaround for myEtherWallet files
+    const auto& crypto = fields.crypto ? fields.crypto : fields.cryptoUppercase;
+    if (!crypto) {
+        return false;
+    }
+    auto payload = buildPayload(*crypto);
+    if (!payload) {
+        return false;
+    }
+    key.payload = std::move(*payload);
+
+    key.encodedPayload = std::nullopt;
+    if (fields.encodedCrypto) {
+        auto encodedPayload = buildPayload(*fields.encodedCrypto);
+        if (!encodedPayload) {
+            return false;
+        }
+        key.encodedPayload = std::move(*encodedPayload);
+    }
+
+    std::vector<Account> accounts;
+    if (fields.accounts) {
+        accounts.reserve(fields.accounts->size());
+        for (auto& accountFields : *fields.accounts) {
+            auto account = buildAccount(accountFields);
+            if (!account) {
+                return false;
+            }
+            accounts.push_back(std::move(*account));
+        }
+    }
+
+    if (accounts.empty() && fields.address) {
+        const auto coin = fields.coin ? TWCoinType(static_cast<std::uint32_t>(*fields.coin)) : TWCoinTypeEthereum;
+        accounts.emplace_back(std::move(*fields.address), coin, TWDerivationDefault, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0), "", "");
+    }
+    key.setAccounts(std::move(accounts));
+    return true;
+}
+
+} // namespace
+
+void writeStoredKeyJson(const StoredKey& key, std::string& out) {
+    CountingSink counter;
+    writeStoredKey(counter, key);
+
+    out.clear();
+    out.reserve(counter.size);
+    StringSink sink{out};
+    writeStoredKey(sink, key);
+}
+
+bool readStoredKeyJson(std::string_view json, StoredKey& key) noexcept {
+    try {
+        KeyFileReader reader;
+        // Not strict, like `operator>>`: content after the key file JSON is ignored.
+        if (!nlohmann::json::sax_parse(json.begin(), json.end(), &reader, nlohmann::json::input_format_t::json, false)) {
+            return false;
+        }
+        return buildStoredKey(reader.fields, key);
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace TW::Keystore {
+
+class StoredKey;
+
+/// Writes the key file JSON of `key` into `out`, replacing its contents.
+/// The output is identical to `key.json().dump()`, but is written directly into a buffer of the exact size.
+///
+/// \throws nlohmann::json::type_error if a string is not valid UTF-8, like `dump()`.
+void writeStoredKeyJson(const StoredKey& key, std::string& out);
+
+/// Reads key file JSON with a SAX parser, straight into the fields of `key`, without building a JSON document.
+///
+/// Only well-formed key files are read: on anything else, including malformed JSON, unexpected value types,
+/// duplicate keys or invalid parameters, returns false and `key` must be discarded.
+/// Such files are left to `StoredKey::loadJson`, which decides how to interpret them or which error to report.
+bool readStoredKeyJson(std::string_view json, StoredKey& key) noexcept;
+
+} // namespace TW::Keystore
@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "StoredKeyDirectory.h"
+
+#include "../WorkerPool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+namespace TW::Keystore {
+
+namespace fs = std::filesystem;
+
+namespace CodingKeys::Index {
+
+static const auto version = "version";
+static const auto files = "files";
+static const auto size = "size";
+static const auto modified = "modified";
+static const auto id = "id";
+static const auto name = "name";
+static const auto type = "type";
+static const auto accounts = "accounts";
+
+} // namespace CodingKeys::Index
+
+namespace {
+
+const auto indexVersion = 1;
+const auto mnemonicType = "mnemonic";
+const auto privateKeyType = "private-key";
+
+std::string filePath(const std::string& directory, const std::string& fileName) {
+    return (fs::path(directory) / fileName).string();
+}
+
+std::string tempFileName(const std::string& fileName) {
+    return "." + fileName + ".tmp";
+}
+
+/// Identifiers are used as file names, so they must not be able to point outside of the directory.
+bool isValidFileName(const std::string& fileName) {
+    return !fileName.empty() && fileName.front() != '.' &&
+           std::all_of(fileName.begin(), fileName.end(), [](char c) {
+               return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+           });
+}
+
+StoredKeyDirectory::Entry entryOf(const StoredKey& key, const std::string& fileName) {
+    StoredKeyDirectory::Entry entry{key.id.value_or(fileName), key.name, key.type, {}, fileName};
+    entry.accounts.reserve(key.accounts().size());
+    for (const auto& account : key.accounts()) {
+        entry.accounts.emplace_back(account.coin, account.address);
+    }
+    return entry;
+}
+
+} // namespace
+
+std::size_t StoredKeyDirectory::AddressHash::operator()(const std::pair<TWCoinType, std::string>& account) const {
+    return std::hash<std::string>{}(account.second) ^ static_cast<std::size_t>(account.first);
+}
+
+StoredKeyDirectory::StoredKeyDirectory(std::string path)
+    : directory(std::move(path)) {
+    fs::create_directories(directory);
+    readIndex();
+    refresh();
+}
+
+std::optional<StoredKeyDirectory::Entry> StoredKeyDirectory::parseFile(const std::string& path, const std::string& fileName) {
+    try {
+        return entryOf(StoredKey::load(path), fileName);
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+bool StoredKeyDirectory::refresh() {
+    std::lock_guard update(updateMutex);
+
+    // Only the metadata of the files is read here.
+    std::map<std::string, FileState> found;
+    for (const auto& file : fs::directory_iterator(directory)) {
+        auto fileName = file.path().filename().string();
+        std::error_code error;
+        if (fileName.empty() || fileName.front() == '.' || !file.is_regular_file(error)) {
+            continue;
+        }
+        const auto size = file.file_size(error);
+        if (error) {
+            continue;
+        }
+        const auto modified = file.last_write_time(error);
+        if (error) {
+            continue;
+        }
+        found.emplace(std::move(fileName), FileState{size, static_cast<std::int64_t>(modified.time_since_epoch().count())});
+    }
+
+    std::vector<std::pair<std::string, std::optional<IndexedFile>>> changes;
+    for (const auto& [fileName, state] : found) {
+        const auto indexed = files.find(fileName);
+        if (indexed == files.end() || !(indexed->second.state == state)) {
+            changes.emplace_back(fileName, IndexedFile{state, std::nullopt});
+        }
+    }
+    WorkerPool::shared()->parallelFor(changes.size(), [this, &changes](std::size_t i) {
+        auto& [fileName, file] = changes[i];
+        file->entry = parseFile(filePath(directory, fileName), fileName);
+    });
+    for (const auto& indexed : files) {
+        if (found.count(indexed.first) == 0) {
+            changes.emplace_back(indexed.first, std::nullopt);
+        }
+    }
+
+    if (changes.empty()) {
+        return false;
+    }
+    apply(std::move(changes));
+    writeIndex();
+    return true;
+}
+
+std::size_t StoredKeyDirectory::size() const {
+    std::shared_lock lock(mutex);
+    return fileById.size();
+}
+
+std::vector<std::string> StoredKeyDirectory::identifiers() const {
+    std::shared_lock lock(mutex);
+    return sortedIds;
+}
+
+std::optional<std::string> StoredKeyDirectory::identifier(std::size_t index) const {
+    std::shared_lock lock(mutex);
+    if (index >= sortedIds.size()) {
+        return std::nullopt;
+    }
+    return sortedIds[index];
+}
+
+std::optional<StoredKeyDirectory::Entry> StoredKeyDirectory::entry(const std::string& id) const {
+    std::shared_lock lock(mutex);
+    const auto fileName = fileById.find(id);
+    if (fileName == fileById.end()) {
+        return std::nullopt;
+    }
+    return files.at(fileName->second).entry;
+}
+
+std::optional<std::string> StoredKeyDirectory::findKey(TWCoinType coin, const std::string& address) const {
+    std::shared_lock lock(mutex);
+    const auto id = idByAddress.find(std::make_pair(coin, address));
+    if (id == idByAddress.end()) {
+        return std::nullopt;
+    }
+    return id->second;
+}
+
+std::optional<StoredKey> StoredKeyDirectory::load(const std::string& id) const {
+    std::string fileName;
+    {
+        std::shared_lock lock(mutex);
+        const auto indexed = fileById.find(id);
+        if (indexed == fileById.end()) {
+            return std::nullopt;
+        }
+        fileName = indexed->second;
+    }
+    try {
+        return StoredKey::load(filePath(directory, fileName));
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+void StoredKeyDirectory::store(const StoredKey& key) {
+    if (!key.id.has_value() || key.id->empty()) {
+        throw std::invalid_argument("Key has no identifier");
+    }
+
+    std::lock_guard update(updateMutex);
+    std::string fileName;
+    {
+        std::shared_lock lock(mutex);
+        const auto indexed = fileById.find(*key.id);
+        fileName = indexed != fileById.end() ? indexed->second : *key.id + ".json";
+    }
+    if (!isValidFileName(fileName)) {
+        throw std::invalid_argument("Key identifier is not a valid file name");
+    }
+
+    const auto path = filePath(directory, fileName);
+    key.storeWithTemporaryFile(path, filePath(directory, tempFileName(fileName)));
+    const FileState state{fs::file_size(path), static_cast<std::int64_t>(fs::last_write_time(path).time_since_epoch().count())};
+
+    std::vector<std::pair<std::string, std::optional<IndexedFile>>> changes;
+    changes.emplace_back(fileName, IndexedFile{state, entryOf(key, fileName)});
+    apply(std::move(changes));
+    writeIndex();
+}
+
+bool StoredKeyDirectory::remove(const std::string& id) {
+    std::lock_guard update(updateMutex);
+    std::string fileName;
+    {
+        std::shared_lock lock(mutex);
+        const auto indexed = fileById.find(id);
+        if (indexed == fileById.end()) {
+            return false;
+        }
+        fileName = indexed->second;
+    }
+
+    fs::remove(filePath(directory, fileName));
+
+    std::vector<std::pair<std::string, std::optional<IndexedFile>>> changes;
+    changes.emplace_back(fileName, std::nullopt);
+    apply(std::move(changes));
+    writeIndex();
+    return true;
+}
+
+void StoredKeyDirectory::apply(std::vector<std::pair<std::string, std::optional<IndexedFile>>> changes) {
+    std::unique_lock lock(mutex);
+    bool released = false;
+    for (auto& [fileName, file] : changes) {
+        if (const auto indexed = files.find(fileName); indexed != files.end()) {
+            if (indexed->second.entry) {
+                released = removeLookups(*indexed->second.entry) || released;
+            }
+            files.erase(indexed);
+        }
+        if (file) {
+            if (file->entry) {
+                addLookups(*file->entry);
+            }
+            files.emplace(fileName, std::move(*file));
+        }
+    }
+    if (released) {
+        // Another file may have the same identifier or accounts as a removed one: it takes over their lookups.
+        for (const auto& indexed : files) {
+            if (indexed.second.entry) {
+                addLookups(*indexed.second.entry);
+            }
+        }
+    }
+
+    sortedIds.clear();
+    sortedIds.reserve(fileById.size());
+    for (const auto& item : fileById) {
+        sortedIds.push_back(item.first);
+    }
+    std::sort(sortedIds.begin(), sortedIds.end());
+}
+
+void StoredKeyDirectory::addLookups(const Entry& entry) {
+    fileById.emplace(entry.id, entry.fileName);
+    for (const auto& account : entry.accounts) {
+        if (!account.second.empty()) {
+            idByAddress.emplace(account, entry.id);
+        }
+    }
+}
+
+bool StoredKeyDirectory::removeLookups(const Entry& entry) {
+    // Lookups of another file with the same identifier or accounts are kept.
+    bool released = false;
+    if (const auto indexed = fileById.find(entry.id); indexed != fileById.end() && indexed->second == entry.fileName) {
+        fileById.erase(indexed);
+        released = true;
+    }
+    for (const auto& account : entry.accounts) {
+        if (const auto indexed = idByAddress.find(account); indexed != idByAddress.end() && indexed->second == entry.id) {
+            idByAddress.erase(indexed);
+            released = true;
+        }
+    }
+    return released;
+}
+
+void StoredKeyDirectory::readIndex() {
+    std::ifstream stream(filePath(directory, indexFileName));
+    if (!stream.is_open()) {
+        return;
+    }
+    const auto json = nlohmann::json::parse(stream, nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        return;
+    }
+
+    std::vector<std::pair<std::string, std::optional<IndexedFile>>> indexed;
+    try {
+        if (json.at(CodingKeys::Index::version).get<int>() != indexVersion) {
+            return;
+        }
+        for (const auto& item : json.at(CodingKeys::Index::files).items()) {
+            const auto& fileJson = item.value();
+            IndexedFile file{{fileJson.at(CodingKeys::Index::size).get<std::uintmax_t>(), fileJson.at(CodingKeys::Index::modified).get<std::int64_t>()}, std::nullopt};
+            if (fileJson.contains(CodingKeys::Index::id)) {
+                Entry entry;
+                entry.id = fileJson.at(CodingKeys::Index::id).get<std::string>();
+                entry.name = fileJson.at(CodingKeys::Index::name).get<std::string>();
+                entry.type = fileJson.at(CodingKeys::Index::type).get<std::string>() == mnemonicType ? StoredKeyType::mnemonicPhrase : StoredKeyType::privateKey;
+                for (const auto& account : fileJson.at(CodingKeys::Index::accounts)) {
+                    entry.accounts.emplace_back(account.at(0).get<TWCoinType>(), account.at(1).get<std::string>());
+                }
+                entry.fileName = item.key();
+                file.entry = std::move(entry);
+            }
+            indexed.emplace_back(item.key(), std::move(file));
+        }
+    } catch (...) {
+        // A damaged index is rebuilt from the key files.
+        return;
+    }
+    apply(std::move(indexed));
+}
+
+void StoredKeyDirectory::writeIndex() const {
+    nlohmann::json filesJson = nlohmann::json::object();
+    for (const auto& [fileName, file] : files) {
+        nlohmann::json fileJson;
+        fileJson[CodingKeys::Index::size] = file.state.size;
+        fileJson[CodingKeys::Index::modified] = file.state.modified;
+        if (file.entry) {
+            fileJson[CodingKeys::Index::id] = file.entry->id;
+            fileJson[CodingKeys::Index::name] = file.entry->name;
+            fileJson[CodingKeys::Index::type] = file.entry->type == StoredKeyType::mnemonicPhrase ? mnemonicType : privateKeyType;
+            nlohmann::json accountsJson = nlohmann::json::array();
+            for (const auto& [coin, address] : file.entry->accounts) {
+                accountsJson.push_back(nlohmann::json::array({coin, address}));
+            }
+            fileJson[CodingKeys::Index::accounts] = std::move(accountsJson);
+        }
+        filesJson[fileName] = std::move(fileJson);
+    }
+    nlohmann::json json;
+    json[CodingKeys::Index::version] = indexVersion;
+    json[CodingKeys::Index::files] = std::move(filesJson);
+
+    // The index is only a cache of the key files: it is not an error if it cannot be written.
+    const auto indexPath = filePath(directory, indexFileName);
+    const auto tempPath = filePath(directory, tempFileName(indexFileName));
+    {
+        std::ofstream stream(tempPath);
+        stream << json.dump();
+        if (!stream) {
+            std::error_code error;
+            fs::remove(tempPath, error);
+            return;
+        }
+    }
+    std::error_code error;
+    fs::rename(tempPath, indexPath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+    }
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "StoredKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// A directory of key files, indexed by key identifier and account address.
+///
+/// Only a summary of every key (identifier, name, type and account addresses) is kept in memory.
+/// The summaries are also persisted in an index file inside the directory, along with the size and
+/// modification time of each key file, so opening the directory again only parses the key files that
+/// changed since; these are parsed in parallel. Full keys are loaded from their files on demand.
+///
+/// Files whose name starts with a dot are ignored. Files that are not valid keys are remembered as such,
+/// and are not parsed again until they change.
+/// All methods may be called from several threads at once.
+class StoredKeyDirectory {
+public:
+    /// Summary of a key file.
+    struct Entry {
+        /// Key identifier; the file name if the key has none.
+        std::string id;
+        std::string name;
+        StoredKeyType type = StoredKeyType::privateKey;
+        /// Coin and address of every account.
+        std::vector<std::pair<TWCoinType, std::string>> accounts;
+        /// File name within the directory.
+        std::string fileName;
+    };
+
+    /// Name of the index file within the directory.
+    static constexpr const char* indexFileName = ".keystore-index.json";
+
+    /// Opens a directory, creating it if needed, and indexes its keys.
+    ///
+    /// \throws std::filesystem::filesystem_error if the directory cannot be created or read.
+    explicit StoredKeyDirectory(std::string path);
+
+    const std::string& path() const { return directory; }
+
+    /// Re-scans the directory and re-indexes the files that were added, changed or removed,
+    /// e.g. by another process. A file is considered changed if its size or modification time changed.
+    ///
+    /// \returns true if any file was added, changed or removed.
+    /// \throws std::filesystem::filesystem_error if the directory cannot be read.
+    bool refresh();
+
+    /// Number of keys.
+    std::size_t size() const;
+
+    /// Identifiers of all the keys, sorted.
+    std::vector<std::string> identifiers() const;
+
+    /// Returns the identifier at `index` in `identifiers()`.
+    std::optional<std::string> identifier(std::size_t index) const;
+
+    /// Returns the summary of a key.
+    std::optional<Entry> entry(const std::string& id) const;
+
+    /// Returns the identifier of the key that has an account with the given coin and address.
+    /// If several keys have such an account, any of them is returned.
+    std::optional<std::string> findKey(TWCoinType coin, const std::string& address) const;
+
+    /// Loads a key from its file.
+    ///
+    /// \returns nullopt if there is no such key, or its file cannot be loaded anymore.
+    std::optional<StoredKey> load(const std::string& id) const;
+
+    /// Stores a key, replacing the file of the key with the same identifier, if any.
+    /// New keys are stored in a file named after their identifier.
+    ///
+    /// \throws std::invalid_argument if the key has no identifier.
+    /// \throws std::runtime_error if the file cannot be written.
+    void store(const StoredKey& key);
+
+    /// Deletes the file of a key.
+    ///
+    /// \returns false if there is no such key.
+    /// \throws std::filesystem::filesystem_error if the file cannot be deleted.
+    bool remove(const std::string& id);
+
+private:
+    struct FileState {
+        std::uintmax_t size = 0;
+        std::int64_t modified = 0;
+
+        bool operator==(const FileState& other) const { return size == other.size && modified == other.modified; }
+    };
+
+    struct IndexedFile {
+        FileState state;
+        /// nullopt if the file is not a valid key.
+        std::optional<Entry> entry;
+    };
+
+    struct AddressHash {
+        std::size_t operator()(const std::pair<TWCoinType, std::string>& account) const;
+    };
+
+    static std::optional<Entry> parseFile(const std::string& filePath, const std::string& fileName);
+
+    /// Replaces the indexed state of the given files; nullopt removes a file. Caller must hold `updateMutex`.
+    void apply(std::vector<std::pair<std::string, std::optional<IndexedFile>>> changes);
+
+    /// Adds the lookups of a key file, unless another file already has them. Caller must hold `mutex` exclusively.
+    void addLookups(const Entry& entry);
+
+    /// Removes the lookups of a key file; returns true if any was removed, which another file may then take over.
+    /// Caller must hold `mutex` exclusively.
+    bool removeLookups(const Entry& entry);
+
+    void readIndex();
+    void writeIndex() const;
+
+    std::string directory;
+
+    /// Serializes `refresh`, `store` and `remove`.
+    std::mutex updateMutex;
+
+    /// Guards all the members below.
+    mutable std::shared_mutex mutex;
+    std::map<std::string, IndexedFile> files;
+    std::unordered_map<std::string, std::string> fileById;
+    std::vector<std::string> sortedIds;
+    std::unordered_map<std::pair<TWCoinType, std::string>, std::string, AddressHash> idByAddress;
+};
+
+} // namespace TW::Keystore
+
+/// Wrapper for C interface.
+struct TWStoredKeyDirectory {
+    TW::Keystore::StoredKeyDirectory impl;
+};
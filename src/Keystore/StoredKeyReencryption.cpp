@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "StoredKeyReencryption.h"
+
+#include "MemoryBudget.h"
+#include "StoredKey.h"
+#include "../WorkerPool.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace TW::Keystore {
+
+namespace {
+
+/// The paths listed in a checkpoint file, which new paths are appended to.
+class Checkpoint {
+public:
+    explicit Checkpoint(const std::string& path) {
+        if (path.empty()) {
+            return;
+        }
+        std::ifstream input(path);
+        for (std::string line; std::getline(input, line);) {
+            if (!line.empty()) {
+                done.insert(line);
+            }
+        }
+        output.open(path, std::ios::app);
+        if (!output) {
+            throw std::runtime_error("Can't open checkpoint file: " + path);
+        }
+    }
+
+    bool isEnabled() const { return output.is_open(); }
+
+    bool contains(const std::string& path) const { return done.count(path) != 0; }
+
+    void add(const std::string& path) {
+        if (!output.is_open()) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        output << path << '\n';
+        output.flush();
+    }
+
+private:
+    std::unordered_set<std::string> done;
+    std::ofstream output;
+    std::mutex mutex;
+};
+
+std::string temporaryPath(const std::string& path) {
+    const auto file = std::filesystem::path(path);
+    return (file.parent_path() / ("." + file.filename().string() + ".tmp")).string();
+}
+
+std::size_t memoryCost(const EncryptedPayload& payload) {
+    const auto* scryptParams = std::get_if<ScryptParameters>(&payload.params.kdfParams);
+    return scryptParams != nullptr ? scryptParams->memoryCost() : 0;
+}
+
+/// Whether re-encrypting a payload with the same password would change its parameters.
+bool needsReencryption(const EncryptedPayload& payload, const std::optional<ScryptParameters>& target) {
+    const auto* current = std::get_if<ScryptParameters>(&payload.params.kdfParams);
+    if (!target.has_value()) {
+        // PBKDF2 parameters are left as is, like in `StoredKey::fixEncryption`.
+        return current != nullptr && current->shouldFix();
+    }
+    return current == nullptr || current->shouldFix() || current->n != target->n || current->r != target->r ||
+           current->p != target->p || current->desiredKeyLength != target->desiredKeyLength;
+}
+
+/// Whether `password` is the password of the key.
+bool decryptsWith(const StoredKey& key, const Data& password) {
+    try {
+        auto data = key.payload.decrypt(password);
+        memzero(data.data(), data.size());
+        return true;
+    } catch (DecryptionError) {
+        return false;
+    }
+}
+
+std::string toString(DecryptionError error) {
+    switch (error) {
+    case DecryptionError::unsupportedKDF:
+        return "Unsupported KDF";
+    case DecryptionError::unsupportedCipher:
+        return "Unsupported cipher";
+    case DecryptionError::unsupportedCoin:
+        return "Unsupported coin";
+    case DecryptionError::invalidKeyFile:
+        return "Invalid key file";
+    case DecryptionError::invalidCipher:
+        return "Invalid cipher";
+    case DecryptionError::invalidPassword:
+        return "Invalid password";
+    default:
+        return "Unknown error";
+    }
+}
+
+} // namespace
+
+std::vector<ReencryptionResult> reencryptKeyFiles(const std::vector<ReencryptionJob>& jobs, const ReencryptionOptions& options) {
+    std::vector<ReencryptionResult> results(jobs.size());
+    Checkpoint checkpoint(options.checkpointPath);
+    MemoryBudget budget(options.memoryBudget);
+
+    std::optional<ScryptParameters> target;
+    if (options.encryptionLevel.has_value()) {
+        target = ScryptParameters::getPreset(*options.encryptionLevel);
+    }
+    // Without an encryption level, Scrypt payloads keep their parameters, and PBKDF2 ones get the default ones.
+    const auto defaultCost = ScryptParameters::getPreset(TWStoredKeyEncryptionLevelDefault).memoryCost();
+    const auto reencryptionCost = [&target, defaultCost](const EncryptedPayload& payload) {
+        const auto current = memoryCost(payload);
+        if (target.has_value()) {
+            return std::max(current, target->memoryCost());
+        }
+        return std::holds_alternative<ScryptParameters>(payload.params.kdfParams) ? current : defaultCost;
+    };
+
+    const auto pool = WorkerPool::shared();
+    pool->parallelFor(jobs.size(), [&](std::size_t index) {
+        const auto& job = jobs[index];
+        auto& result = results[index];
+        if (checkpoint.contains(job.path)) {
+            result.status = ReencryptionStatus::checkpointed;
+            return;
+        }
+
+        try {
+            auto key = StoredKey::load(job.path);
+            const auto samePassword = job.password == job.newPassword;
+            const auto needed = needsReencryption(key.payload, target) ||
+                                (key.encodedPayload.has_value() && needsReencryption(*key.encodedPayload, target));
+            if (samePassword && !needed) {
+                result.status = ReencryptionStatus::unchanged;
+                return;
+            }
+
+            // Payloads are decrypted, encrypted and verified one after the other: reserve for the largest key derivation.
+            auto cost = reencryptionCost(key.payload);
+            if (key.encodedPayload.has_value()) {
+                cost = std::max(cost, reencryptionCost(*key.encodedPayload));
+            }
+            {
+                const MemoryBudget::Reservation reservation(budget, cost);
+                try {
+                    key.reencrypt(job.password, job.newPassword, options.encryptionLevel);
+                } catch (DecryptionError error) {
+                    // An interrupted batch may have replaced the file without adding it to the checkpoint.
+                    if (error != DecryptionError::invalidPassword || samePassword || !checkpoint.isEnabled() ||
+                        !decryptsWith(key, job.newPassword)) {
+                        throw;
+                    }
+                    if (!needed) {
+                        checkpoint.add(job.path);
+                        result.status = ReencryptionStatus::unchanged;
+                        return;
+                    }
+                    key.reencrypt(job.newPassword, job.newPassword, options.encryptionLevel);
+                }
+            }
+
+            key.storeWithTemporaryFile(job.path, temporaryPath(job.path));
+            checkpoint.add(job.path);
+            result.status = ReencryptionStatus::reencrypted;
+        } catch (DecryptionError error) {
+            result.status = error == DecryptionError::invalidPassword ? ReencryptionStatus::invalidPassword : ReencryptionStatus::failed;
+            result.error = toString(error);
+        } catch (ScryptValidationError error) {
+            result.error = toString(error);
+        } catch (const std::exception& error) {
+            result.error = error.what();
+        } catch (...) {
+            result.error = "Unknown error";
+        }
+    });
+    return results;
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrustWalletCore/TWStoredKeyEncryptionLevel.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// A key file to re-encrypt.
+struct ReencryptionJob {
+    std::string path;
+    /// Current password.
+    Data password;
+    /// New password; the same as `password` to only upgrade the encryption parameters.
+    Data newPassword;
+};
+
+struct ReencryptionOptions {
+    /// Scrypt parameters to re-encrypt with; see `StoredKey::reencrypt`.
+    /// If not set, keys are only re-encrypted if their password changes or their parameters need fixing.
+    std::optional<TWStoredKeyEncryptionLevel> encryptionLevel;
+
+    /// Maximum amount of memory used by the key derivations running at once, in bytes.
+    /// Scrypt at the standard level needs 256 MB per key. A key that needs more than the budget is re-encrypted alone.
+    std::size_t memoryBudget = std::size_t(1) << 30;
+
+    /// File listing the paths already re-encrypted, one per line; none if empty.
+    /// The listed paths are skipped, and every path is appended as soon as its file is replaced,
+    /// so an interrupted batch is resumed by running it again with the same file.
+    /// A file replaced just before the interruption may be missing from the list: with a checkpoint file, a key that
+    /// already has its new password instead of its current one is considered done, and reported as `unchanged`.
+    std::string checkpointPath;
+};
+
+enum class ReencryptionStatus {
+    /// The file was re-encrypted and replaced.
+    reencrypted,
+    /// The file already had the requested password and parameters, and was left as is.
+    /// With a checkpoint file, this includes a file with the new password instead of the current one.
+    unchanged,
+    /// The file is listed in the checkpoint file, and was skipped.
+    checkpointed,
+    /// The current password is wrong.
+    invalidPassword,
+    /// The file could not be loaded, re-encrypted or written; see `error`.
+    failed,
+};
+
+struct ReencryptionResult {
+    ReencryptionStatus status = ReencryptionStatus::failed;
+    std::string error;
+};
+
+/// Re-encrypts key files in parallel on the shared worker pool, e.g. to rotate their passwords or upgrade
+/// weak Scrypt parameters, keeping the memory used by key derivations within `options.memoryBudget`.
+///
+/// Each file is replaced atomically through a temporary file in the same directory, named after it with
+/// a leading dot and a `.tmp` extension. Failures are reported per file, and do not stop the others.
+///
+/// \returns one result per job, in the same order.
+/// \throws std::runtime_error if the checkpoint file cannot be opened.
+std::vector<ReencryptionResult> reencryptKeyFiles(const std::vector<ReencryptionJob>& jobs, const ReencryptionOptions& options = {});
+
+} // namespace TW::Keystore
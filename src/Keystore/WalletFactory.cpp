@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "WalletFactory.h"
+
+#include "MemoryBudget.h"
+#include "../Coin.h"
+#include "../HDWallet.h"
+#include "../HexCoding.h"
+#include "../WorkerPool.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+namespace TW::Keystore {
+
+void WalletFactory::generate(std::size_t count, const std::vector<TWCoinType>& coins, const std::vector<TWDerivation>& derivations,
+                             const Options& options, const Sink& sink) {
+    if (options.strength % 32 != 0 || options.strength < 128 || options.strength > 256) {
+        throw std::invalid_argument("Invalid strength");
+    }
+    if (!derivations.empty() && derivations.size() != coins.size()) {
+        throw std::invalid_argument("Derivations do not match coins");
+    }
+
+    // The same keys are derived for every wallet.
+    std::vector<HDWallet<>::KeyRequest> requests;
+    requests.reserve(coins.size());
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        const auto derivation = derivations.empty() ? TWDerivationDefault : derivations[i];
+        requests.push_back({coins[i], TW::derivationPath(coins[i], derivation), TW::xpubVersionDerivation(coins[i], derivation)});
+    }
+
+    MemoryBudget budget(options.memoryBudget);
+    const auto encryptionCost = ScryptParameters::getPreset(options.encryptionLevel).memoryCost();
+
+    std::mutex sinkMutex;
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    // Called with `sinkMutex` locked.
+    const auto fail = [&failed, &error](std::exception_ptr exception) {
+        if (!failed.exchange(true)) {
+            error = std::move(exception);
+        }
+    };
+
+    WorkerPool::shared()->parallelFor(count, [&](std::size_t index) {
+        if (failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::optional<StoredKey> key;
+        try {
+            const HDWallet<> wallet(options.strength, "");
+            {
+                const MemoryBudget::Reservation reservation(budget, encryptionCost);
+                key = StoredKey::createWithMnemonic(options.name, options.password, wallet.getMnemonic(), options.encryptionLevel, options.encryption);
+            }
+
+            const auto keys = wallet.deriveKeys(requests);
+            for (std::size_t i = 0; i < requests.size(); ++i) {
+                const auto& request = requests[i];
+                const auto derivation = derivations.empty() ? TWDerivationDefault : derivations[i];
+                const auto publicKey = keys[i].privateKey.getPublicKey(TW::publicKeyType(request.coin));
+                const auto address = TW::deriveAddress(request.coin, publicKey, derivation);
+                key->addAccount(address, request.coin, derivation, request.derivationPath, hex(publicKey.bytes), keys[i].extendedPublicKey);
+            }
+        } catch (...) {
+            std::lock_guard lock(sinkMutex);
+            fail(std::current_exception());
+            return;
+        }
+
+        // The failure is recorded before the lock is released, so that the sink is not called again.
+        std::lock_guard lock(sinkMutex);
+        if (failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            sink(index, std::move(*key));
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    });
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "StoredKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWDerivation.h>
+#include <TrustWalletCore/TWStoredKeyEncryption.h>
+#include <TrustWalletCore/TWStoredKeyEncryptionLevel.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// Generates many new random wallets at once, e.g. to provision deposit wallets.
+struct WalletFactory {
+    struct Options {
+        /// Name of the generated keys.
+        std::string name;
+        /// Password to encrypt the mnemonics with.
+        Data password;
+        /// Mnemonic strength in bits: 128 to 256, in steps of 32.
+        int strength = 128;
+        TWStoredKeyEncryptionLevel encryptionLevel = TWStoredKeyEncryptionLevelDefault;
+        TWStoredKeyEncryption encryption = TWStoredKeyEncryptionAes128Ctr;
+        /// Maximum amount of memory used by the mnemonic encryptions running at once, in bytes.
+        /// Scrypt at the standard level needs 256 MB per key. A key that needs more than the budget is encrypted alone.
+        std::size_t memoryBudget = std::size_t(1) << 30;
+    };
+
+    /// Receives every generated key, with its index in `[0, count)`.
+    /// Called from the worker threads, one key at a time, in no particular order.
+    using Sink = std::function<void(std::size_t index, StoredKey&& key)>;
+
+    /// Generates `count` keys with random mnemonics, each with an account for every coin,
+    /// the same as `StoredKey::createWithMnemonicRandom` followed by `StoredKey::account(coin, derivation, wallet)`.
+    /// Keys are generated in parallel on the shared worker pool, keeping the memory used by encryptions within
+    /// `options.memoryBudget`, and handed to `sink` as soon as they are ready, so they are not all kept in memory. The keys of each wallet are derived by `HDWallet::deriveKeys`.
+    ///
+    /// \param derivations the derivation of each coin; empty for the default ones.
+    /// \throws std::invalid_argument if the strength is invalid, or `derivations` does not match `coins`.
+    /// Rethrows the first exception thrown by `sink` or while generating a key, after which no more keys are generated.
+    static void generate(std::size_t count, const std::vector<TWCoinType>& coins, const std::vector<TWDerivation>& derivations,
+                         const Options& options, const Sink& sink);
+};
+
+} // namespace TW::Keystore
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace TW {
+
+/// A BIP39 wordlist with an index for word lookup and prefix search, meant to be built at compile time.
+///
+/// Words are hashed into an open addressing table at most half full, and the longest probe sequence is recorded,
+/// so a lookup reads a small, bounded number of slots.  The words must be sorted, as the BIP39 English list is,
+/// so the words starting with a given prefix are contiguous.
+template <std::size_t Count>
+class MnemonicWordlist {
+public:
+    static_assert(Count > 0 && Count < 0xffff);
+
+    /// \throws std::invalid_argument if the words are not sorted and unique, which fails compilation in a constant expression.
+    constexpr explicit MnemonicWordlist(const std::array<std::string_view, Count>& words) : words(words) {
+        for (std::size_t index = 0; index < Count; ++index) {
+            if (words[index].empty() || (index > 0 && !(words[index - 1] < words[index]))) {
+                throw std::invalid_argument("Wordlist is not sorted");
+            }
+            maxLength = std::max(maxLength, words[index].size());
+
+            auto slot = hash(words[index]) & mask;
+            std::size_t probes = 1;
+            for (; table[slot] != 0; slot = (slot + 1) & mask) {
+                ++probes;
+            }
+            table[slot] = static_cast<std::uint16_t>(index + 1);
+            maxProbes = std::max(maxProbes, probes);
+        }
+    }
+
+    static constexpr std::size_t size() { return Count; }
+
+    constexpr std::string_view operator[](std::size_t index) const { return words[index]; }
+
+    /// Returns the index of a word, or -1 if it is not in the list.
+    constexpr int find(std::string_view word) const {
+        auto slot = hash(word) & mask;
+        for (std::size_t probe = 0; probe < maxProbes && table[slot] != 0; ++probe, slot = (slot + 1) & mask) {
+            if (words[table[slot] - 1] == word) {
+                return table[slot] - 1;
+            }
+        }
+        return -1;
+    }
+
+    /// Determines whether a word is in the list without an early exit: the same number of slots
+    /// and bytes are compared whether it is found or not, and wherever it is.
+    constexpr bool contains(std::string_view word) const {
+        const auto start = hash(word);
+        std::uint8_t found = 0;
+        for (std::size_t probe = 0; probe < maxProbes; ++probe) {
+            const auto entry = table[(start + probe) & mask];
+            // an empty slot never matches, not even an empty word
+            found |= static_cast<std::uint8_t>(entry != 0) & equal(entry != 0 ? words[entry - 1] : std::string_view(), word);
+        }
+        return found != 0;
+    }
+
+    /// Returns the indices `[first, last)` of the words starting with a prefix.
+    constexpr std::pair<std::size_t, std::size_t> prefixRange(std::string_view prefix) const {
+        const auto first = std::lower_bound(words.begin(), words.end(), prefix);
+        const auto last = std::partition_point(first, words.end(), [prefix](std::string_view word) { return word.starts_with(prefix); });
+        return {static_cast<std::size_t>(first - words.begin()), static_cast<std::size_t>(last - words.begin())};
+    }
+
+private:
+    static constexpr std::size_t TableSize = std::bit_ceil(2 * Count);
+    static constexpr std::size_t mask = TableSize - 1;
+
+    /// 32-bit FNV-1a.
+    static constexpr std::size_t hash(std::string_view word) {
+        std::uint32_t hash = 0x811c9dc5;
+        for (const auto c : word) {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x01000193;
+        }
+        return hash;
+    }
+
+    /// Compares `word` to `candidate` over `maxLength` bytes, without an early exit.
+    constexpr std::uint8_t equal(std::string_view candidate, std::string_view word) const {
+        std::uint8_t diff = candidate.size() != word.size();
+        for (std::size_t i = 0; i < maxLength; ++i) {
+            const auto a = i < candidate.size() ? candidate[i] : 0;
+            const auto b = i < word.size() ? word[i] : 0;
+            diff |= static_cast<std::uint8_t>(a ^ b);
+        }
+        return diff == 0;
+    }
+
+    std::array<std::string_view, Count> words;
+    /// Index + 1 of the word in each slot, 0 if empty.
+    std::array<std::uint16_t, TableSize> table{};
+    std::size_t maxProbes = 0;
+    std::size_t maxLength = 0;
+};
+
+} // namespace TW
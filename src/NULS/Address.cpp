@@ -13,8 +13,8 @@ using namespace TW;
 
 namespace TW::NULS {
 
-std::string mainnetPrefix = std::string("NULSd");
-std::string testnetPrefix = std::string("tNULSe");
+const std::string mainnetPrefix = std::string("NULSd");
+const std::string testnetPrefix = std::string("tNULSe");
 
 bool Address::isValid(const std::string& addrStr) {
     if (addrStr.empty()) {
@@ -5,6 +5,7 @@
 #include "TransactionCompiler.h"
 
 #include "Coin.h"
+#include "WorkerPool.h"
 
 using namespace TW;
 
@@ -41,3 +42,59 @@ Data TransactionCompiler::compileWithSignaturesAndPubKeyType(TWCoinType coinType
     anyCoinCompileWithSignatures(coinType, txInputData, signatures, pubs, txOutput);
     return txOutput;
 }
+
+TransactionCompilerBatch::TransactionCompilerBatch(TWCoinType coinType, std::vector<Data> txInputs)
+    : coinType(coinType) {
+    items.reserve(txInputs.size());
+    for (auto& txInput : txInputs) {
+        items.push_back(Item{std::move(txInput), false, {}, {}});
+    }
+}
+
+void TransactionCompilerBatch::prepare() {
+    WorkerPool::shared()->parallelFor(items.size(), [this](std::size_t i) {
+        auto& item = items[i];
+        if (item.prepared) {
+            return;
+        }
+        try {
+            item.txInput = anyCoinPrepareCompileInput(coinType, item.txInput);
+        } catch (...) {} // keep the input as is
+        item.prepared = true;
+    });
+}
+
+std::vector<Data> TransactionCompilerBatch::preImageHashes() {
+    prepare();
+
+    std::vector<Data> outputs(items.size());
+    WorkerPool::shared()->parallelFor(items.size(), [this, &outputs](std::size_t i) {
+        try {
+            outputs[i] = TransactionCompiler::preImageHashes(coinType, items[i].txInput);
+        } catch (...) {} // return empty
+    });
+    return outputs;
+}
+
+bool TransactionCompilerBatch::setSignatures(std::size_t index, std::vector<Data> signatures, std::vector<Data> publicKeys) {
+    if (index >= items.size()) {
+        return false;
+    }
+    items[index].signatures = std::move(signatures);
+    items[index].publicKeys = std::move(publicKeys);
+    return true;
+}
+
+std::vector<Data> TransactionCompilerBatch::compile() {
+    // Compiling without obtaining the pre-image hashes first must give the same transactions.
+    prepare();
+
+    std::vector<Data> outputs(items.size());
+    WorkerPool::shared()->parallelFor(items.size(), [this, &outputs](std::size_t i) {
+        const auto& item = items[i];
+        try {
+            outputs[i] = TransactionCompiler::compileWithSignatures(coinType, item.txInput, item.signatures, item.publicKeys);
+        } catch (...) {} // return empty
+    });
+    return outputs;
+}
@@ -29,4 +29,40 @@ public:
 
 };
 
+/// Keeps many transactions of one coin between the pre-image hashing and the compiling phases of an external signing flow.
+/// Inputs are prepared once (see `CoinEntry::prepareCompileInput`), so compiling does not repeat the decisions
+/// taken while obtaining the pre-image hashes, e.g. UTXO selection. Both phases run on the shared worker pool.
+class TransactionCompilerBatch {
+public:
+    TransactionCompilerBatch(TWCoinType coinType, std::vector<Data> txInputs);
+
+    std::size_t size() const { return items.size(); }
+
+    /// Obtains the pre-image hashes of every transaction, in the order of the inputs.
+    /// An output is empty if the pre-image hashes of its input could not be obtained at all.
+    std::vector<Data> preImageHashes();
+
+    /// Sets the external signatures and public keys of the transaction at `index`.
+    /// Returns false if `index` is out of range.
+    bool setSignatures(std::size_t index, std::vector<Data> signatures, std::vector<Data> publicKeys);
+
+    /// Compiles every transaction with the signatures set before, in the order of the inputs.
+    /// An output is empty if its transaction could not be compiled at all.
+    std::vector<Data> compile();
+
+private:
+    struct Item {
+        Data txInput;
+        bool prepared = false;
+        std::vector<Data> signatures;
+        std::vector<Data> publicKeys;
+    };
+
+    /// Prepares the inputs that were not prepared yet.
+    void prepare();
+
+    TWCoinType coinType;
+    std::vector<Item> items;
+};
+
 } // namespace TW
@@ -7,7 +7,8 @@
 #include "../HexCoding.h"
 #include "../Result.h"
 #include <google/protobuf/any.pb.h>
-#include <unordered_set>
+#include <algorithm>
+#include <string_view>
 
 namespace TW::Tron {
 
@@ -18,13 +19,14 @@ using VoidResult = Result<void>;
 // Helper to parse a hex-encoded string field from JSON, returning an empty string if the field is missing.
 // Throws an exception if the field is not a string or an invalid hex string.
 std::string hexStringOrEmpty(const json& j, const std::string& key) {
-    if (!j.contains(key)) {
+    const auto it = j.find(key);
+    if (it == j.end()) {
         return {};
     }
-    if (!j[key].is_string()) {
+    if (!it->is_string()) {
         throw std::runtime_error("Expected hex string for field '" + key + "'");
     }
-    const auto bytesHex = j[key].get<std::string>();
+    const auto& bytesHex = it->get_ref<const std::string&>();
     if (bytesHex.empty()) {
         return {};
     }
@@ -56,10 +58,10 @@ std::string hexStringOrPlainText(const json& j, const std::string& key) {
     return raw;
 }
 
-VoidResult checkNoExtraFields(const json& value, const std::initializer_list<std::string>& allowed) {
-    const std::unordered_set<std::string> allowedSet(allowed);
+// The lists are a handful of names long, a linear search doesn't allocate unlike a set of strings.
+VoidResult checkNoExtraFields(const json& value, const std::initializer_list<std::string_view>& allowed) {
     for (const auto& [key, _] : value.items()) {
-        if (allowedSet.find(key) == allowedSet.end()) {
+        if (std::find(allowed.begin(), allowed.end(), key) == allowed.end()) {
             return VoidResult::failure("unexpected field '" + key + "' in contract value");
         }
     }
@@ -4,298 +4,335 @@
 
 #include "Serialization.h"
 #include "Constants.h"
-#include "../HexCoding.h"
-#include <sstream>
-#include <vector>
+
+#include <charconv>
+#include <string_view>
 
 namespace TW::Tron {
 
-using json = nlohmann::json;
+namespace {
+
+/// Writes compact JSON straight into a string. Object keys must be written in sorted order,
+/// which is how the node JSON has always been produced.
+class JSONWriter {
+  public:
+    explicit JSONWriter(std::string& out) : out(out) {}
+
+    void beginObject() {
+        out.push_back('{');
+    }
+
+    void endObject() {
+        out.push_back('}');
+    }
+
+    void beginArray(std::string_view name) {
+        key(name);
+        out.push_back('[');
+    }
+
+    void endArray() {
+        out.push_back(']');
+    }
+
+    void beginObject(std::string_view name) {
+        key(name);
+        out.push_back('{');
+    }
+
+    /// Opens an object as the next element of an array.
+    void beginElement() {
+        separate();
+        out.push_back('{');
+    }
+
+    /// The value must not need escaping, e.g. a protobuf enum name.
+    void string(std::string_view name, std::string_view value) {
+        key(name);
+        quoted(value);
+    }
+
+    void hex(std::string_view name, std::string_view bytes) {
+        key(name);
+        hexValue(bytes);
+    }
+
+    /// Writes `bytes` hex-encoded as the next element of an array.
+    void hexElement(std::string_view bytes) {
+        separate();
+        hexValue(bytes);
+    }
+
+    void number(std::string_view name, int64_t value) {
+        key(name);
+        char buffer[24];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void boolean(std::string_view name, bool value) {
+        key(name);
+        out.append(value ? "true" : "false");
+    }
+
+  private:
+    std::string& out;
+
+    /// Values never end with an opening bracket, so a comma is due unless a container has just been opened.
+    void separate() {
+        if (!out.empty() && out.back() != '{' && out.back() != '[') {
+            out.push_back(',');
+        }
+    }
+
+    void key(std::string_view name) {
+        separate();
+        quoted(name);
+        out.push_back(':');
+    }
+
+    void quoted(std::string_view value) {
+        out.push_back('"');
+        out.append(value);
+        out.push_back('"');
+    }
+
+    void hexValue(std::string_view bytes) {
+        static constexpr char digits[] = "0123456789abcdef";
+        out.push_back('"');
+        for (const auto byte : bytes) {
+            const auto b = static_cast<uint8_t>(byte);
+            out.push_back(digits[b >> 4]);
+            out.push_back(digits[b & 0x0f]);
+        }
+        out.push_back('"');
+    }
+};
+
+std::string_view toStringView(const Data& data) {
+    return {reinterpret_cast<const char*>(data.data()), data.size()};
+}
+
+} // namespace
 
 std::string typeName(const protocol::Transaction::Contract::ContractType type) {
     return protocol::Transaction::Contract::ContractType_Name(type);
 }
 
 std::string typeUrl(const protocol::Transaction::Contract::ContractType type) {
-    std::ostringstream stringStream;
-    stringStream << kFieldTypeUrlPrefix << "/protocol." << typeName(type);
-    return stringStream.str();
+    std::string url = kFieldTypeUrlPrefix;
+    url.append("/protocol.").append(typeName(type));
+    return url;
 }
 
-json valueJSON(const protocol::TransferContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldToAddress] = hex(contract.to_address());
-    valueJSON[kFieldAmount] = contract.amount();
-    return valueJSON;
-}
+// Fields of every value are written in alphabetical order.
 
-json valueJSON(const protocol::TransferAssetContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldAssetName] = hex(contract.asset_name());
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldToAddress] = hex(contract.to_address());
-    valueJSON[kFieldAmount] = contract.amount();
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::TransferContract& contract) {
+    writer.number(kFieldAmount, contract.amount());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldToAddress, contract.to_address());
 }
 
-json valueJSON(const protocol::VoteAssetContract& contract) {
-    json valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::TransferAssetContract& contract) {
+    writer.number(kFieldAmount, contract.amount());
+    writer.hex(kFieldAssetName, contract.asset_name());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldToAddress, contract.to_address());
+}
 
-    std::vector<std::string> vote_address;
+void valueJSON(JSONWriter& writer, const protocol::VoteAssetContract& contract) {
+    writer.number(kFieldCount, contract.count());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.boolean(kFieldSupport, contract.support());
+    writer.beginArray(kFieldVoteAddress);
     for (const std::string& addr : contract.vote_address()) {
-        vote_address.push_back(hex(addr));
+        writer.hexElement(addr);
     }
-
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldVoteAddress] = vote_address;
-    valueJSON[kFieldSupport] = contract.support();
-    valueJSON[kFieldCount] = contract.count();
-
-    return valueJSON;
+    writer.endArray();
 }
 
-json voteJSON(const protocol::VoteWitnessContract::Vote& vote) {
-    json voteJSON;
-    voteJSON[kFieldVoteAddress] = hex(vote.vote_address());
-    voteJSON[kFieldVoteCount] = vote.vote_count();
-    return voteJSON;
+void voteJSON(JSONWriter& writer, const protocol::VoteWitnessContract::Vote& vote) {
+    writer.beginElement();
+    writer.hex(kFieldVoteAddress, vote.vote_address());
+    writer.number(kFieldVoteCount, vote.vote_count());
+    writer.endObject();
 }
 
-json valueJSON(const protocol::VoteWitnessContract& contract) {
-    json valueJSON;
-
-    std::vector<json> votes;
+void valueJSON(JSONWriter& writer, const protocol::VoteWitnessContract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.boolean(kFieldSupport, contract.support());
+    writer.beginArray(kFieldVotes);
     for (const protocol::VoteWitnessContract::Vote& vote : contract.votes()) {
-        votes.push_back(voteJSON(vote));
+        voteJSON(writer, vote);
     }
-
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldVotes] = votes;
-    valueJSON[kFieldSupport] = contract.support();
-
-    return valueJSON;
+    writer.endArray();
 }
 
-json valueJSON(const protocol::FreezeBalanceContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldFrozenBalance] = contract.frozen_balance();
-    valueJSON[kFieldFrozenDuration] = contract.frozen_duration();
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON[kFieldReceiverAddress] = hex(contract.receiver_address());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::FreezeBalanceContract& contract) {
+    writer.number(kFieldFrozenBalance, contract.frozen_balance());
+    writer.number(kFieldFrozenDuration, contract.frozen_duration());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldReceiverAddress, contract.receiver_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
 }
 
-json valueJSON(const protocol::FreezeBalanceV2Contract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldFrozenBalance] = contract.frozen_balance();
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::FreezeBalanceV2Contract& contract) {
+    writer.number(kFieldFrozenBalance, contract.frozen_balance());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
 }
 
-json valueJSON(const protocol::UnfreezeBalanceContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON[kFieldReceiverAddress] = hex(contract.receiver_address());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::UnfreezeBalanceContract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldReceiverAddress, contract.receiver_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
 }
 
-json valueJSON(const protocol::UnfreezeBalanceV2Contract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON[kFieldUnfreezeBalance] = contract.unfreeze_balance();
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::UnfreezeBalanceV2Contract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
+    writer.number(kFieldUnfreezeBalance, contract.unfreeze_balance());
 }
 
-json valueJSON(const protocol::DelegateResourceContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldReceiverAddress] = hex(contract.receiver_address());
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON[kFieldBalance] = contract.balance();
-    valueJSON[kFieldLock] = contract.lock();
+void valueJSON(JSONWriter& writer, const protocol::DelegateResourceContract& contract) {
+    writer.number(kFieldBalance, contract.balance());
+    writer.boolean(kFieldLock, contract.lock());
     if (contract.lock_period() != 0) {
-        valueJSON[kFieldLockPeriod] = contract.lock_period();
+        writer.number(kFieldLockPeriod, contract.lock_period());
     }
-    return valueJSON;
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldReceiverAddress, contract.receiver_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
 }
 
-json valueJSON(const protocol::UnDelegateResourceContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldReceiverAddress] = hex(contract.receiver_address());
-    valueJSON[kFieldResource] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON[kFieldBalance] = contract.balance();
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::UnDelegateResourceContract& contract) {
+    writer.number(kFieldBalance, contract.balance());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
+    writer.hex(kFieldReceiverAddress, contract.receiver_address());
+    writer.string(kFieldResource, protocol::ResourceCode_Name(contract.resource()));
 }
 
-json valueJSON(const protocol::WithdrawExpireUnfreezeContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::WithdrawExpireUnfreezeContract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
 }
 
-json valueJSON(const protocol::WithdrawBalanceContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::WithdrawBalanceContract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
 }
 
-json valueJSON(const protocol::UnfreezeAssetContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    return valueJSON;
+void valueJSON(JSONWriter& writer, const protocol::UnfreezeAssetContract& contract) {
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
 }
 
-json valueJSON(const protocol::TriggerSmartContract& contract) {
-    json valueJSON;
-    valueJSON[kFieldOwnerAddress] = hex(contract.owner_address());
-    valueJSON[kFieldContractAddress] = hex(contract.contract_address());
-    valueJSON[kFieldData] = hex(contract.data());
-    if (contract.call_value() > 0) {
-        valueJSON[kFieldCallValue] = contract.call_value();
-    }
+void valueJSON(JSONWriter& writer, const protocol::TriggerSmartContract& contract) {
     if (contract.call_token_value() > 0) {
-        valueJSON[kFieldCallTokenValue] = contract.call_token_value();
+        writer.number(kFieldCallTokenValue, contract.call_token_value());
     }
+    if (contract.call_value() > 0) {
+        writer.number(kFieldCallValue, contract.call_value());
+    }
+    writer.hex(kFieldContractAddress, contract.contract_address());
+    writer.hex(kFieldData, contract.data());
+    writer.hex(kFieldOwnerAddress, contract.owner_address());
     if (contract.token_id() > 0) {
-        valueJSON[kFieldTokenId] = contract.token_id();
+        writer.number(kFieldTokenId, contract.token_id());
     }
+}
 
-    return valueJSON;
+template <typename Contract>
+void unpackedValueJSON(JSONWriter& writer, const google::protobuf::Any& parameter) {
+    Contract contract;
+    parameter.UnpackTo(&contract);
+    writer.beginObject(kFieldValue);
+    valueJSON(writer, contract);
+    writer.endObject();
 }
 
-json parameterJSON(const google::protobuf::Any& parameter, const protocol::Transaction::Contract::ContractType type) {
-    json paramJSON;
-    paramJSON[kFieldTypeUrl] = typeUrl(type);
+void parameterJSON(JSONWriter& writer, const google::protobuf::Any& parameter, const protocol::Transaction::Contract::ContractType type) {
+    writer.beginObject(kFieldParameter);
+    writer.string(kFieldTypeUrl, typeUrl(type));
 
     switch (type) {
-    case protocol::Transaction::Contract::TransferContract: {
-        protocol::TransferContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::TransferContract:
+        unpackedValueJSON<protocol::TransferContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::TransferAssetContract: {
-        protocol::TransferAssetContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::TransferAssetContract:
+        unpackedValueJSON<protocol::TransferAssetContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::VoteAssetContract: {
-        protocol::VoteAssetContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::VoteAssetContract:
+        unpackedValueJSON<protocol::VoteAssetContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::VoteWitnessContract: {
-        protocol::VoteWitnessContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::VoteWitnessContract:
+        unpackedValueJSON<protocol::VoteWitnessContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::FreezeBalanceContract: {
-        protocol::FreezeBalanceContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::FreezeBalanceContract:
+        unpackedValueJSON<protocol::FreezeBalanceContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::FreezeBalanceV2Contract: {
-        protocol::FreezeBalanceV2Contract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::FreezeBalanceV2Contract:
+        unpackedValueJSON<protocol::FreezeBalanceV2Contract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::UnfreezeBalanceContract: {
-        protocol::UnfreezeBalanceContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::UnfreezeBalanceContract:
+        unpackedValueJSON<protocol::UnfreezeBalanceContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::UnfreezeBalanceV2Contract: {
-        protocol::UnfreezeBalanceV2Contract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::UnfreezeBalanceV2Contract:
+        unpackedValueJSON<protocol::UnfreezeBalanceV2Contract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::WithdrawExpireUnfreezeContract: {
-        protocol::WithdrawExpireUnfreezeContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::WithdrawExpireUnfreezeContract:
+        unpackedValueJSON<protocol::WithdrawExpireUnfreezeContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::DelegateResourceContract: {
-        protocol::DelegateResourceContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::DelegateResourceContract:
+        unpackedValueJSON<protocol::DelegateResourceContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::UnDelegateResourceContract: {
-        protocol::UnDelegateResourceContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::UnDelegateResourceContract:
+        unpackedValueJSON<protocol::UnDelegateResourceContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::WithdrawBalanceContract: {
-        protocol::WithdrawBalanceContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::WithdrawBalanceContract:
+        unpackedValueJSON<protocol::WithdrawBalanceContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::UnfreezeAssetContract: {
-        protocol::UnfreezeAssetContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::UnfreezeAssetContract:
+        unpackedValueJSON<protocol::UnfreezeAssetContract>(writer, parameter);
         break;
-    }
-    case protocol::Transaction::Contract::TriggerSmartContract: {
-        protocol::TriggerSmartContract contract;
-        parameter.UnpackTo(&contract);
-        paramJSON[kFieldValue] = valueJSON(contract);
+    case protocol::Transaction::Contract::TriggerSmartContract:
+        unpackedValueJSON<protocol::TriggerSmartContract>(writer, parameter);
         break;
-    }
     case protocol::Transaction::Contract::AccountCreateContract:
     default:
         break;
     }
 
-    return paramJSON;
+    writer.endObject();
 }
 
-json contractJSON(const protocol::Transaction::Contract& contract) {
-    json contractJSON;
-    contractJSON[kFieldType] = typeName(contract.type());
-    contractJSON[kFieldParameter] = parameterJSON(contract.parameter(), contract.type());
-    return contractJSON;
+void contractJSON(JSONWriter& writer, const protocol::Transaction::Contract& contract) {
+    writer.beginElement();
+    parameterJSON(writer, contract.parameter(), contract.type());
+    writer.string(kFieldType, typeName(contract.type()));
+    writer.endObject();
 }
 
-json raw_dataJSON(const protocol::Transaction::raw& raw) {
-    json raw_dataJSON;
+void raw_dataJSON(JSONWriter& writer, const protocol::Transaction::raw& raw) {
+    writer.beginObject(kFieldRawData);
 
-    raw_dataJSON[kFieldRefBlockBytes] = hex(raw.ref_block_bytes());
-    raw_dataJSON[kFieldRefBlockHash] = hex(raw.ref_block_hash());
-    if (raw.ref_block_num() > 0) {
-        raw_dataJSON[kFieldRefBlockNum] = raw.ref_block_num();
-    }
-    if (raw.fee_limit() > 0) {
-        raw_dataJSON[kFieldFeeLimit] = raw.fee_limit();
+    writer.beginArray(kFieldContract);
+    for (const auto& contract : raw.contract()) {
+        contractJSON(writer, contract);
     }
-    raw_dataJSON[kFieldTimestamp] = raw.timestamp();
-    raw_dataJSON[kFieldExpiration] = raw.expiration();
+    writer.endArray();
     if (!raw.data().empty()) {
-        raw_dataJSON[kFieldData] = hex(raw.data());
+        writer.hex(kFieldData, raw.data());
     }
-    auto contracts = json::array();
-    for (const auto& contract : raw.contract()) {
-        contracts.push_back(contractJSON(contract));
+    writer.number(kFieldExpiration, raw.expiration());
+    if (raw.fee_limit() > 0) {
+        writer.number(kFieldFeeLimit, raw.fee_limit());
+    }
+    writer.hex(kFieldRefBlockBytes, raw.ref_block_bytes());
+    writer.hex(kFieldRefBlockHash, raw.ref_block_hash());
+    if (raw.ref_block_num() > 0) {
+        writer.number(kFieldRefBlockNum, raw.ref_block_num());
     }
-    raw_dataJSON[kFieldContract] = contracts;
+    writer.number(kFieldTimestamp, raw.timestamp());
 
-    return raw_dataJSON;
+    writer.endObject();
 }
 
 Data serializeTxRawData(const protocol::Transaction& tx) noexcept {
@@ -303,14 +340,22 @@ Data serializeTxRawData(const protocol::Transaction& tx) noexcept {
     return { serialized.begin(), serialized.end() };
 }
 
-json transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature) {
-    json transactionJSON;
-    transactionJSON[kFieldRawData] = raw_dataJSON(transaction.raw_data());
-    transactionJSON[kFieldRawDataHex] = hex(serializeTxRawData(transaction));
-    transactionJSON[kFieldTxID] = hex(txID);
-    transactionJSON[kFieldSignature] = json::array({hex(signature)});
-
-    return transactionJSON;
+std::string transactionJSON(const protocol::Transaction& transaction, const Data& rawData, const Data& txID, const Data& signature) {
+    // Every byte of `raw_data` appears at most twice hex-encoded: once in `raw_data_hex`, once in the fields of `raw_data`.
+    std::string json;
+    json.reserve(4 * rawData.size() + 2 * (txID.size() + signature.size()) + 512);
+
+    JSONWriter writer(json);
+    writer.beginObject();
+    raw_dataJSON(writer, transaction.raw_data());
+    writer.hex(kFieldRawDataHex, toStringView(rawData));
+    writer.beginArray(kFieldSignature);
+    writer.hexElement(toStringView(signature));
+    writer.endArray();
+    writer.hex(kFieldTxID, toStringView(txID));
+    writer.endObject();
+
+    return json;
 }
 
 } // namespace TW::Tron
@@ -6,12 +6,16 @@
 
 #include "./Protobuf/TronInternal.pb.h"
 #include "Data.h"
-#include <nlohmann/json.hpp>
+
+#include <string>
 
 namespace TW::Tron {
 
 Data serializeTxRawData(const protocol::Transaction& tx) noexcept;
 
-nlohmann::json transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature);
+/// Writes the signed transaction in the Tron node JSON format (compact, keys sorted).
+/// `rawData` must be `serializeTxRawData(transaction)`; it is taken as an argument so that callers
+/// which have already hashed it don't serialize the transaction twice.
+std::string transactionJSON(const protocol::Transaction& transaction, const Data& rawData, const Data& txID, const Data& signature);
 
 }
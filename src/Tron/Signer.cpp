@@ -454,16 +454,17 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) {
     output.set_ref_block_bytes(tx.raw_data().ref_block_bytes());
     output.set_ref_block_hash(tx.raw_data().ref_block_hash());
 
-    const auto hash = Hash::sha256(serializeTxRawData(tx));
+    const auto rawData = serializeTxRawData(tx);
+    const auto hash = Hash::sha256(rawData);
 
     const auto key = PrivateKey(input.private_key(), TWCurveSECP256k1);
     const auto signature = key.sign(hash);
 
-    const auto json = transactionJSON(tx, hash, signature).dump();
-
     output.set_id(hash.data(), hash.size());
     output.set_signature(signature.data(), signature.size());
-    output.set_json(json.data(), json.size());
+    if (!input.skip_json()) {
+        output.set_json(transactionJSON(tx, rawData, hash, signature));
+    }
 
     return output;
 }
@@ -475,14 +476,14 @@ Proto::SigningOutput errorOutput(const std::string& message, const Common::Proto
     return output;
 }
 
-Result<protocol::Transaction, Proto::SigningOutput> Signer::deserializeAndValidateRawJson(const std::string& rawJson) {
+/// Same as `Signer::deserializeAndValidateRawJson`, also handing out the parsed JSON so that it is parsed only once.
+static Result<protocol::Transaction, Proto::SigningOutput> deserializeAndValidateRawJson(const std::string& rawJson, nlohmann::json& parsed) {
     using R = Result<protocol::Transaction, Proto::SigningOutput>;
 
     if (rawJson.size() > MAX_JSON_SIZE) {
         return R::failure(errorOutput("raw JSON exceeds maximum allowed size 1 MB"));
     }
 
-    nlohmann::json parsed;
     try {
         parsed = nlohmann::json::parse(rawJson);
     } catch (const std::exception& e) {
@@ -507,7 +508,7 @@ Result<protocol::Transaction, Proto::SigningOutput> Signer::deserializeAndValida
         }
     }
 
-    const auto transaction = transactionFromJSON(rawJson);
+    const auto transaction = transactionFromJSONObject(parsed);
     if (transaction.isFailure()) {
         const auto errorMessage = "`raw_json` could not be parsed, or the transaction type is not supported: " + transaction.error();
         return R::failure(errorOutput(errorMessage, Common::Proto::Error_not_supported));
@@ -526,6 +527,11 @@ Result<protocol::Transaction, Proto::SigningOutput> Signer::deserializeAndValida
     return R::success(transaction.payload());
 }
 
+Result<protocol::Transaction, Proto::SigningOutput> Signer::deserializeAndValidateRawJson(const std::string& rawJson) {
+    nlohmann::json parsed;
+    return Tron::deserializeAndValidateRawJson(rawJson, parsed);
+}
+
 Proto::SigningOutput Signer::signRawJson(const Proto::SigningInput& input) {
     const auto result = deserializeAndValidateRawJson(input.raw_json());
     if (result.isFailure()) {
@@ -533,23 +539,26 @@ Proto::SigningOutput Signer::signRawJson(const Proto::SigningInput& input) {
     }
 
     const auto& transaction = result.payload();
-    const auto expectedTxID = Hash::sha256(serializeTxRawData(transaction));
+    const auto rawData = serializeTxRawData(transaction);
+    const auto expectedTxID = Hash::sha256(rawData);
     const auto key = PrivateKey(input.private_key(), TWCurveSECP256k1);
     const auto signature = key.sign(expectedTxID);
-    const auto json = transactionJSON(transaction, expectedTxID, signature).dump();
 
     Proto::SigningOutput output;
     output.set_ref_block_bytes(transaction.raw_data().ref_block_bytes());
     output.set_ref_block_hash(transaction.raw_data().ref_block_hash());
     output.set_id(expectedTxID.data(), expectedTxID.size());
     output.set_signature(signature.data(), signature.size());
-    output.set_json(json.data(), json.size());
+    if (!input.skip_json()) {
+        output.set_json(transactionJSON(transaction, rawData, expectedTxID, signature));
+    }
 
     return output;
 }
 
 Proto::SigningOutput Signer::compileRawJson(const std::string& rawJson, const Data& signature) {
-    const auto result = deserializeAndValidateRawJson(rawJson);
+    nlohmann::json parsed;
+    const auto result = Tron::deserializeAndValidateRawJson(rawJson, parsed);
     if (result.isFailure()) {
         return result.error();
     }
@@ -557,9 +566,7 @@ Proto::SigningOutput Signer::compileRawJson(const std::string& rawJson, const Da
     const auto& transaction = result.payload();
     const auto txID = Hash::sha256(serializeTxRawData(transaction));
 
-    // It's safe to parse the JSON because deserializeAndValidateRawJson already checks that the JSON can be parsed
-    // and that the txID matches the transaction data.
-    auto parsed = nlohmann::json::parse(rawJson);
+    // deserializeAndValidateRawJson has already checked that the txID matches the transaction data.
     // Add signature to JSON and set to output
     parsed["signature"] = nlohmann::json::array({hex(signature)});
 
@@ -593,9 +600,11 @@ Proto::SigningOutput Signer::compile(const Data& signature) const {
         return output;
     }
 
-    const auto hash = Hash::sha256(serializeTxRawData(transaction));
-    const auto json = transactionJSON(transaction, hash, signature).dump();
-    output.set_json(json.data(), json.size());
+    const auto rawData = serializeTxRawData(transaction);
+    const auto hash = Hash::sha256(rawData);
+    if (!input.skip_json()) {
+        output.set_json(transactionJSON(transaction, rawData, hash, signature));
+    }
     output.set_ref_block_bytes(transaction.raw_data().ref_block_bytes());
     output.set_ref_block_hash(transaction.raw_data().ref_block_hash());
     output.set_id(hash.data(), hash.size());
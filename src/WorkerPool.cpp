@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <utility>
+
+namespace TW {
+
+namespace {
+
+std::size_t defaultConcurrency() {
+#ifdef TW_WASM_THREAD_POOL_SIZE
+    // Wasm threads run on web workers; only the ones started with the module are available right away.
+    return TW_WASM_THREAD_POOL_SIZE;
+#else
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+#endif
+}
+
+std::mutex sharedPoolMutex;
+std::shared_ptr<WorkerPool> sharedPool;
+
+} // namespace
+
+WorkerPool::WorkerPool(std::size_t threads, std::size_t queueCapacity) {
+    threads = std::max<std::size_t>(1, threads);
+    capacity = queueCapacity == 0 ? 4 * threads : queueCapacity;
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        try {
+            workers.emplace_back([this] { run(); });
+        } catch (const std::system_error&) {
+            // No threads on this platform (e.g. Wasm without pthreads): callers of parallelFor do all the work.
+            break;
+        }
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::submit(Task task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    {
+        std::unique_lock lock(mutex);
+        notFull.wait(lock, [this] { return queue.size() < capacity; });
+        queue.push_back(std::move(task));
+    }
+    notEmpty.notify_one();
+}
+
+bool WorkerPool::trySubmit(const Task& task) {
+    {
+        std::lock_guard lock(mutex);
+        if (queue.size() >= capacity) {
+            return false;
+        }
+        queue.push_back(task);
+    }
+    notEmpty.notify_one();
+    return true;
+}
+
+void WorkerPool::run() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(mutex);
+            notEmpty.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                // Stopping and nothing left to do.
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        notFull.notify_one();
+        task();
+    }
+}
+
+void WorkerPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    // Lanes may start after the caller returned, so the state they share is reference-counted.
+    // `fn` is only referenced while `active > 0`, and the caller does not return before that drops to zero.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::size_t active = 0;
+        bool done = false;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+
+    auto lane = [state, &fn, count] {
+        {
+            std::lock_guard lock(state->mutex);
+            if (state->done) {
+                return;
+            }
+            ++state->active;
+        }
+        for (auto i = state->next++; i < count; i = state->next++) {
+            fn(i);
+        }
+        {
+            std::lock_guard lock(state->mutex);
+            --state->active;
+        }
+        state->finished.notify_all();
+    };
+
+    // The caller runs one lane itself, so one helper lane fewer than items is enough.
+    const auto helpers = std::min(size(), count - 1);
+    // Helpers are not waited for, so they are not worth blocking on a full queue: nested calls from workers
+    // would otherwise all block in `submit` with nobody left to drain the queue.
+    for (std::size_t i = 0; i < helpers; ++i) {
+        if (!trySubmit(lane)) {
+            break;
+        }
+    }
+    lane();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&state] { return state->active == 0; });
+    // Helper lanes that did not start yet have nothing left to do.
+    state->done = true;
+}
+
+std::shared_ptr<WorkerPool> WorkerPool::shared() {
+    std::lock_guard lock(sharedPoolMutex);
+    if (!sharedPool) {
+        sharedPool = std::make_shared<WorkerPool>(defaultConcurrency());
+    }
+    return sharedPool;
+}
+
+void WorkerPool::setSharedConcurrency(std::size_t threads) {
+    auto pool = std::make_shared<WorkerPool>(threads == 0 ? defaultConcurrency() : threads);
+    std::shared_ptr<WorkerPool> previous;
+    {
+        std::lock_guard lock(sharedPoolMutex);
+        previous = std::exchange(sharedPool, std::move(pool));
+    }
+    // `previous` is joined here, outside of the lock, unless a running batch still holds it.
+}
+
+} // namespace TW
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+/// A fixed set of worker threads fed through a bounded task queue.
+/// `submit` blocks while the queue is full, throttling producers (back-pressure).
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    /// Starts `threads` workers (at least one) with a queue holding at most `queueCapacity` pending tasks.
+    /// Where threads cannot be created, starts as many as possible, possibly none.
+    explicit WorkerPool(std::size_t threads, std::size_t queueCapacity = 0);
+
+    /// Runs all the pending tasks, then stops and joins the workers.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Number of worker threads.
+    std::size_t size() const { return workers.size(); }
+
+    /// Enqueues a task, blocking while the queue is full; runs it right away if there are no workers.
+    /// Tasks must not throw.
+    void submit(Task task);
+
+    /// Calls `fn(i)` for every `i` in `[0, count)` and waits for all of them to complete.
+    /// Indices are pulled one by one by the workers and the calling thread, so a slow item
+    /// does not hold back the others. `fn` must not throw.
+    /// Safe to call from a worker thread: the caller always makes progress on its own.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+    /// Returns the pool shared by the batch APIs, creating it on first use.
+    static std::shared_ptr<WorkerPool> shared();
+
+    /// Replaces the shared pool with one of `threads` workers; 0 means the number of hardware threads.
+    /// Batches already running keep using the previous pool until they complete.
+    static void setSharedConcurrency(std::size_t threads);
+
+private:
+    /// Enqueues a task unless the queue is full; returns whether it was enqueued.
+    bool trySubmit(const Task& task);
+
+    void run();
+
+    std::vector<std::thread> workers;
+    std::deque<Task> queue;
+    std::size_t capacity;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+};
+
+} // namespace TW
@@ -10,32 +10,32 @@ bool TexAddress::isValid(const std::string& addr) {
 }
 
 bool TexAddress::isValid(const std::string& addr, const std::string& hrp) {
-    try {
-        TexAddress address(addr);
-        return hrp.empty() || address.getHrp() == hrp;
-    } catch (...) {
-        return false;
-    }
+    std::string decodedHrp;
+    Data keyHash;
+    return decode(addr, decodedHrp, keyHash) && (hrp.empty() || decodedHrp == hrp);
 }
 
-TexAddress::TexAddress(const std::string& addr) {
+bool TexAddress::decode(const std::string& addr, std::string& hrpOut, Data& keyHashOut) {
     auto dec = Bech32::decode(addr);
-    if (std::get<1>(dec).empty()) {
-        throw std::invalid_argument("Tex address has invalid payload");
-    }
-    if (std::get<2>(dec) != Bech32::Bech32M) {
-        throw std::invalid_argument("Error decoding Tex address as bech32m");
+    if (std::get<1>(dec).empty() || std::get<2>(dec) != Bech32::Bech32M) {
+        return false;
     }
 
     Data conv;
     auto success = Bech32::convertBits<5, 8, false>(conv, std::get<1>(dec));
     if (!success || conv.size() != length) {
-        throw std::invalid_argument("Error decoding Tex address payload as bech32m");
+        return false;
     }
 
-    hrp = std::get<0>(dec);
-    keyHash = conv;
+    hrpOut = std::get<0>(dec);
+    keyHashOut = conv;
+    return true;
 }
 
+TexAddress::TexAddress(const std::string& addr) {
+    if (!decode(addr, hrp, keyHash)) {
+        throw std::invalid_argument("Invalid Tex address");
+    }
+}
 
 } // namespace TW::Zcash
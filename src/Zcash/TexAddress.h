@@ -19,6 +19,9 @@ class TexAddress {
     /// Public key hash.
     Data keyHash;
 
+    /// Decodes a Bech32m address with a 20-byte payload, without throwing.
+    static bool decode(const std::string& addr, std::string& hrpOut, Data& keyHashOut);
+
 public:
     static constexpr std::size_t length = 20;
 
@@ -6,6 +6,7 @@
 #include <TrustWalletCore/TWAnyAddress.h>
 #include <TrustWalletCore/TWPublicKey.h>
 
+#include "BinaryCoding.h"
 #include "Data.h"
 #include "Coin.h"
 #include "CoinEntry.h"
@@ -31,6 +32,17 @@ bool TWAnyAddressIsValidBech32(TWString* _Nonnull string, enum TWCoinType coin,
     return TW::validateAddress(coin, address, hrpStr.c_str());
 }
 
+TWData* _Nonnull TWAnyAddressDetectCoins(TWString* _Nonnull string) {
+    const auto& address = *reinterpret_cast<const std::string*>(string);
+    const auto coins = TW::detectCoins(address);
+    TW::Data result;
+    result.reserve(coins.size() * sizeof(uint32_t));
+    for (const auto coin : coins) {
+        TW::encode32LE(static_cast<uint32_t>(coin), result);
+    }
+    return TWDataCreateWithBytes(result.data(), result.size());
+}
+
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string,
                                                             enum TWCoinType coin) {
     const auto& address = *reinterpret_cast<const std::string*>(string);
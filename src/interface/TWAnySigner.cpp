@@ -5,6 +5,8 @@
 #include <TrustWalletCore/TWAnySigner.h>
 
 #include "Coin.h"
+#include "DataVector.h"
+#include "WorkerPool.h"
 
 using namespace TW;
 
@@ -15,6 +17,30 @@ TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
 }
 
+static struct TWDataVector* _Nonnull signBatch(const struct TWDataVector* _Nonnull inputs, const std::vector<TWCoinType>& coins) {
+    const auto outputs = TW::anyCoinSignBatch(coins, createFromTWDataVector(inputs));
+    auto* result = TWDataVectorCreate();
+    for (const auto& output : outputs) {
+        auto* item = TWDataCreateWithBytes(output.data(), output.size());
+        TWDataVectorAdd(result, item);
+        TWDataDelete(item);
+    }
+    return result;
+}
+
+struct TWDataVector* _Nonnull TWAnySignerSignBatch(const struct TWDataVector* _Nonnull inputs, enum TWCoinType coin) {
+    return signBatch(inputs, {coin});
+}
+
+struct TWDataVector* _Nonnull TWAnySignerSignBatchCoins(const struct TWDataVector* _Nonnull inputs, const enum TWCoinType* _Nonnull coins) {
+    const auto count = TWDataVectorSize(inputs);
+    return signBatch(inputs, std::vector<TWCoinType>(coins, coins + count));
+}
+
+void TWAnySignerSetBatchConcurrency(size_t threads) {
+    TW::WorkerPool::setSharedConcurrency(threads);
+}
+
 TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin) {
     const Data& keyData = *(reinterpret_cast<const Data*>(key));
     const std::string& jsonString = *(reinterpret_cast<const std::string*>(json));
@@ -153,20 +153,24 @@ bool TWStoredKeyIsMnemonic(struct TWStoredKey* _Nonnull key) {
 }
 
 size_t TWStoredKeyAccountCount(struct TWStoredKey* _Nonnull key) {
-    return key->impl.accounts.size();
+    return key->impl.accounts().size();
 }
 
 struct TWAccount* _Nullable TWStoredKeyAccount(struct TWStoredKey* _Nonnull key, size_t index) {
-    if (index >= key->impl.accounts.size()) {
+    if (index >= key->impl.accounts().size()) {
         return nullptr;
     }
 
-    return new TWAccount{ key->impl.accounts[index] };
+    return new TWAccount{ key->impl.accounts()[index] };
 }
 
 struct TWAccount* _Nullable TWStoredKeyAccountForCoin(struct TWStoredKey* _Nonnull key, enum TWCoinType coin, struct TWHDWallet* _Nullable wallet) {
     try {
-        const auto account = key->impl.account(coin, (wallet ? &wallet->impl : nullptr));
+        if (wallet == nullptr) {
+            const auto* account = key->impl.findAccount(coin);
+            return account == nullptr ? nullptr : new TWAccount{ *account };
+        }
+        const auto account = key->impl.account(coin, &wallet->impl);
         // Note: std::optional.value() is not available in XCode with target < iOS 12, using *
         return (!account.has_value()) ? nullptr : new TWAccount{ *account };
     } catch (...) {
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <TrustWalletCore/TWStoredKeyDirectory.h>
+
+#include "../Keystore/StoredKeyDirectory.h"
+
+namespace KeyStore = TW::Keystore;
+
+struct TWStoredKeyDirectory* _Nullable TWStoredKeyDirectoryCreate(TWString* _Nonnull path) {
+    try {
+        const auto& pathString = *reinterpret_cast<const std::string*>(path);
+        return new TWStoredKeyDirectory{ KeyStore::StoredKeyDirectory(pathString) };
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void TWStoredKeyDirectoryDelete(struct TWStoredKeyDirectory* _Nonnull directory) {
+    delete directory;
+}
+
+bool TWStoredKeyDirectoryRefresh(struct TWStoredKeyDirectory* _Nonnull directory) {
+    try {
+        return directory->impl.refresh();
+    } catch (...) {
+        return false;
+    }
+}
+
+size_t TWStoredKeyDirectoryKeyCount(struct TWStoredKeyDirectory* _Nonnull directory) {
+    return directory->impl.size();
+}
+
+TWString* _Nullable TWStoredKeyDirectoryIdentifier(struct TWStoredKeyDirectory* _Nonnull directory, size_t index) {
+    const auto id = directory->impl.identifier(index);
+    if (!id) {
+        return nullptr;
+    }
+    return TWStringCreateWithUTF8Bytes(id->c_str());
+}
+
+TWString* _Nullable TWStoredKeyDirectoryName(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier) {
+    const auto& id = *reinterpret_cast<const std::string*>(identifier);
+    const auto entry = directory->impl.entry(id);
+    if (!entry) {
+        return nullptr;
+    }
+    return TWStringCreateWithUTF8Bytes(entry->name.c_str());
+}
+
+TWString* _Nullable TWStoredKeyDirectoryFindKey(struct TWStoredKeyDirectory* _Nonnull directory, enum TWCoinType coin, TWString* _Nonnull address) {
+    const auto& addressString = *reinterpret_cast<const std::string*>(address);
+    const auto id = directory->impl.findKey(coin, addressString);
+    if (!id) {
+        return nullptr;
+    }
+    return TWStringCreateWithUTF8Bytes(id->c_str());
+}
+
+struct TWStoredKey* _Nullable TWStoredKeyDirectoryLoad(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier) {
+    const auto& id = *reinterpret_cast<const std::string*>(identifier);
+    auto key = directory->impl.load(id);
+    if (!key) {
+        return nullptr;
+    }
+    return new TWStoredKey{ std::move(*key) };
+}
+
+bool TWStoredKeyDirectoryStore(struct TWStoredKeyDirectory* _Nonnull directory, struct TWStoredKey* _Nonnull key) {
+    try {
+        directory->impl.store(key->impl);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool TWStoredKeyDirectoryRemove(struct TWStoredKeyDirectory* _Nonnull directory, TWString* _Nonnull identifier) {
+    try {
+        const auto& id = *reinterpret_cast<const std::string*>(identifier);
+        return directory->impl.remove(id);
+    } catch (...) {
+        return false;
+    }
+}
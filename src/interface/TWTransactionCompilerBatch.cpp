@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <TrustWalletCore/TWTransactionCompilerBatch.h>
+
+#include "TransactionCompiler.h"
+#include "DataVector.h"
+
+#include <cassert>
+
+using namespace TW;
+
+struct TWTransactionCompilerBatch {
+    TransactionCompilerBatch impl;
+};
+
+static struct TWDataVector* _Nonnull createTWDataVector(const std::vector<Data>& items) {
+    auto* result = TWDataVectorCreate();
+    for (const auto& item : items) {
+        auto* itemData = TWDataCreateWithBytes(item.data(), item.size());
+        TWDataVectorAdd(result, itemData);
+        TWDataDelete(itemData);
+    }
+    return result;
+}
+
+struct TWTransactionCompilerBatch* _Nonnull TWTransactionCompilerBatchCreate(enum TWCoinType coinType, const struct TWDataVector* _Nonnull txInputs) {
+    assert(txInputs != nullptr);
+    return new TWTransactionCompilerBatch{TransactionCompilerBatch(coinType, createFromTWDataVector(txInputs))};
+}
+
+void TWTransactionCompilerBatchDelete(struct TWTransactionCompilerBatch* _Nonnull batch) {
+    delete batch;
+}
+
+size_t TWTransactionCompilerBatchSize(struct TWTransactionCompilerBatch* _Nonnull batch) {
+    return batch->impl.size();
+}
+
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchPreImageHashes(struct TWTransactionCompilerBatch* _Nonnull batch) {
+    return createTWDataVector(batch->impl.preImageHashes());
+}
+
+bool TWTransactionCompilerBatchSetSignatures(struct TWTransactionCompilerBatch* _Nonnull batch, size_t index,
+                                             const struct TWDataVector* _Nonnull signatures, const struct TWDataVector* _Nonnull publicKeys) {
+    assert(signatures != nullptr);
+    assert(publicKeys != nullptr);
+    return batch->impl.setSignatures(index, createFromTWDataVector(signatures), createFromTWDataVector(publicKeys));
+}
+
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchCompile(struct TWTransactionCompilerBatch* _Nonnull batch) {
+    return createTWDataVector(batch->impl.compile());
+}
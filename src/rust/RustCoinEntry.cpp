@@ -20,9 +20,9 @@ bool RustCoinEntry::validateAddress(TWCoinType coin, const std::string &address,
         return Rust::tw_any_address_is_valid_bech32(addressStr.get(), static_cast<uint32_t>(coin), hrpStr.get());
     } else if (const auto* ss58Prefix = std::get_if<SS58Prefix>(&addressPrefix); ss58Prefix) {
         return Rust::tw_any_address_is_valid_ss58(addressStr.get(), static_cast<uint32_t>(coin), static_cast<uint16_t>(*ss58Prefix));
-    } else {
-        throw std::invalid_argument("`Rust::tw_any_address_create_with_public_key_filecoin_address_type` are not supported yet");
     }
+    // Other prefixes are not supported yet: no address is valid with them.
+    return false;
 }
 
 std::string RustCoinEntry::normalizeAddress(TWCoinType coin, const std::string& address) const {
@@ -96,32 +96,27 @@ Data RustCoinEntry::addressToData(TWCoinType coin, const std::string& address) c
 }
 
 void RustCoinEntry::sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const {
-    Rust::TWDataWrapper input = Rust::tw_data_create_with_bytes(dataIn.data(), dataIn.size());
-    Rust::TWDataWrapper output = Rust::tw_any_signer_sign(input.get(), static_cast<uint32_t>(coin));
-
-    dataOut = output.toDataOrDefault();
+    Rust::assignCByteArray(Rust::tw_any_signer_sign_bytes(dataIn.data(), dataIn.size(), static_cast<uint32_t>(coin)), dataOut);
 }
 
 Data RustCoinEntry::preImageHashes(TWCoinType coin, const Data& txInputData) const {
-    Rust::TWDataWrapper input = txInputData;
-    Rust::TWDataWrapper output = Rust::tw_transaction_compiler_pre_image_hashes(static_cast<uint32_t>(coin), input.get());
-
-    return output.toDataOrDefault();
+    Rust::CByteArrayWrapper output = Rust::tw_transaction_compiler_pre_image_hashes_bytes(static_cast<uint32_t>(coin), txInputData.data(), txInputData.size());
+    return std::move(output.data);
 }
 
 void RustCoinEntry::compile(TWCoinType coin, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& dataOut) const {
-    Rust::TWDataWrapper input = txInputData;
-
-    std::vector<Data> publicKeysData;
+    const auto signaturesRefs = Rust::byteArrayRefs(signatures);
+    std::vector<Rust::CByteArrayRef> publicKeysRefs;
+    publicKeysRefs.reserve(publicKeys.size());
     for (const auto& publicKey : publicKeys) {
-        publicKeysData.push_back(publicKey.bytes);
+        publicKeysRefs.push_back(Rust::byteArrayRef(publicKey.bytes));
     }
 
-    Rust::TWDataVectorWrapper signaturesVec = signatures;
-    Rust::TWDataVectorWrapper publicKeysVec = publicKeysData;
-
-    Rust::TWDataWrapper output = Rust::tw_transaction_compiler_compile(static_cast<uint32_t>(coin), input.get(), signaturesVec.get(), publicKeysVec.get());
-    dataOut = output.toDataOrDefault();
+    const auto output = Rust::tw_transaction_compiler_compile_bytes(static_cast<uint32_t>(coin),
+                                                                    txInputData.data(), txInputData.size(),
+                                                                    signaturesRefs.data(), signaturesRefs.size(),
+                                                                    publicKeysRefs.data(), publicKeysRefs.size());
+    Rust::assignCByteArray(output, dataOut);
 }
 
 } // namespace TW::Rust
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "../Data.h"
 #include "bindgen/WalletCoreRSBindgen.h"
@@ -132,6 +133,23 @@ struct TWStringWrapper {
     std::shared_ptr<TWString> ptr;
 };
 
+/// Borrows the given bytes as an FFI argument, without copying them.
+/// The result must not outlive `bytes`.
+inline CByteArrayRef byteArrayRef(const Data& bytes) {
+    return CByteArrayRef{bytes.data(), bytes.size()};
+}
+
+/// Borrows each item of the given vector as an FFI argument, without copying the items.
+/// The result must not outlive `items`.
+inline std::vector<CByteArrayRef> byteArrayRefs(const std::vector<Data>& items) {
+    std::vector<CByteArrayRef> refs;
+    refs.reserve(items.size());
+    for (const auto& item : items) {
+        refs.push_back(byteArrayRef(item));
+    }
+    return refs;
+}
+
 struct CByteArrayWrapper {
     CByteArrayWrapper() = default;
 
@@ -153,6 +171,17 @@ struct CByteArrayWrapper {
     Data data;
 };
 
+/// Copies the given Rust-owned bytes into `out`, reusing its capacity, and releases them.
+/// Unlike `CByteArrayWrapper`, no intermediate `Data` is allocated.
+inline void assignCByteArray(CByteArray rawArray, Data& out) {
+    if (rawArray.data == nullptr || rawArray.size == 0) {
+        out.clear();
+        return;
+    }
+    out.assign(rawArray.data, rawArray.data + rawArray.size);
+    free_c_byte_array(&rawArray);
+}
+
 struct CStringWrapper {
     /// Implicit move constructor.
     CStringWrapper(const char* c_str) {
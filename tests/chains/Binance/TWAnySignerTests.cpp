@@ -6,7 +6,9 @@
 #include "Binance/Address.h"
 #include "proto/Binance.pb.h"
 #include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWDataVector.h>
 #include "Coin.h"
+#include "Defer.h"
 
 #include "TestUtilities.h"
 #include <gtest/gtest.h>
@@ -14,7 +16,7 @@
 
 namespace TW::Binance {
 
-Proto::SigningOutput SignTest() {
+Proto::SigningInput SignTestInput() {
     auto input = Proto::SigningInput();
     input.set_chain_id("Binance-Chain-Tigris");
     input.set_account_number(0);
@@ -51,6 +53,11 @@ Proto::SigningOutput SignTest() {
         outputCoin->set_amount(1);
     }
 
+    return input;
+}
+
+Proto::SigningOutput SignTest() {
+    const auto input = SignTestInput();
     Proto::SigningOutput output;
     ANY_SIGN(input, TWCoinTypeBinance);
     return output;
@@ -88,4 +95,50 @@ TEST(TWAnySignerBinance, MultithreadedSigning) {
     th3.join();
 }
 
+TEST(TWAnySignerBinance, SignBatch) {
+    const auto inputData = data(SignTestInput().SerializeAsString());
+    auto inputs = WRAP(TWDataVector, TWDataVectorCreate());
+    const size_t count = 20;
+    for (size_t i = 0; i < count; ++i) {
+        auto input = WRAPD(TWDataCreateWithBytes(inputData.data(), inputData.size()));
+        TWDataVectorAdd(inputs.get(), input.get());
+    }
+    // Invalid input in the middle of the batch.
+    auto invalid = DATA("ff");
+    TWDataVectorAdd(inputs.get(), invalid.get());
+
+    TWAnySignerSetBatchConcurrency(4);
+    // Restore the default pool even when an assertion below returns early.
+    defer { TWAnySignerSetBatchConcurrency(0); };
+    auto outputs = WRAP(TWDataVector, TWAnySignerSignBatch(inputs.get(), TWCoinTypeBinance));
+    ASSERT_EQ(TWDataVectorSize(outputs.get()), count + 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto outputData = WRAPD(TWDataVectorGet(outputs.get(), i));
+        Proto::SigningOutput output;
+        ASSERT_TRUE(output.ParseFromArray(TWDataBytes(outputData.get()), static_cast<int>(TWDataSize(outputData.get()))));
+        EXPECT_EQ(hex(output.encoded()), "b801f0625dee0a462a2c87fa0a1f0a1440c2979694bbc961023d1d27be6fc4d21a9febe612070a03424e421001121f0a14bffe47abfaede50419c577f1074fee6dd1535cd112070a03424e421001126a0a26eb5ae98721026a35920088d98c3888ca68c53dfc93f4564602606cbb87f0fe5ee533db38e50212409073e581e1ea4fdf11242fe30a732f96d20799c638354bcf7a242161ac015b9321fbbed93e85b0ef9b5de58fba74dff54ecb1e379ef26e1023be8996003f4899");
+    }
+
+    auto invalidOutputData = WRAPD(TWDataVectorGet(outputs.get(), count));
+    Proto::SigningOutput invalidOutput;
+    ASSERT_TRUE(invalidOutput.ParseFromArray(TWDataBytes(invalidOutputData.get()), static_cast<int>(TWDataSize(invalidOutputData.get()))));
+    EXPECT_TRUE(invalidOutput.encoded().empty());
+}
+
+TEST(TWAnySignerBinance, SignBatchCoins) {
+    const auto inputData = data(SignTestInput().SerializeAsString());
+    auto input = WRAPD(TWDataCreateWithBytes(inputData.data(), inputData.size()));
+    auto inputs = WRAP(TWDataVector, TWDataVectorCreateWithData(input.get()));
+    TWDataVectorAdd(inputs.get(), input.get());
+    const TWCoinType coins[] = {TWCoinTypeBinance, TWCoinTypeBinance};
+
+    auto outputs = WRAP(TWDataVector, TWAnySignerSignBatchCoins(inputs.get(), coins));
+    ASSERT_EQ(TWDataVectorSize(outputs.get()), 2ul);
+    auto first = WRAPD(TWDataVectorGet(outputs.get(), 0));
+    auto second = WRAPD(TWDataVectorGet(outputs.get(), 1));
+    EXPECT_TRUE(TWDataEqual(first.get(), second.get()));
+    EXPECT_GT(TWDataSize(first.get()), 0ul);
+}
+
 } // namespace TW::Binance
@@ -293,6 +293,29 @@ TEST(BitcoinCompiler, CompileWithSignatures) {
         EXPECT_EQ(output.encoded().size(), 0ul);
         EXPECT_EQ(output.error(), Common::Proto::Error_signing);
     }
+    { // Batch: without a plan in the input, UTXOs are selected once and reused when compiling
+        auto unplannedInput = signingInput;
+        unplannedInput.clear_plan();
+        TransactionCompilerBatch batch(coin, {data(unplannedInput.SerializeAsString()), txInputData});
+        ASSERT_EQ(batch.size(), 2ul);
+
+        const auto batchPreImageHashes = batch.preImageHashes();
+        ASSERT_EQ(batchPreImageHashes.size(), 2ul);
+        EXPECT_EQ(hex(batchPreImageHashes[0]), hex(preImageHashes));
+        EXPECT_EQ(hex(batchPreImageHashes[1]), hex(preImageHashes));
+
+        EXPECT_TRUE(batch.setSignatures(0, signatureVec, pubkeyVec));
+        EXPECT_TRUE(batch.setSignatures(1, signatureVec, pubkeyVec));
+        EXPECT_FALSE(batch.setSignatures(2, signatureVec, pubkeyVec));
+
+        const auto outputs = batch.compile();
+        ASSERT_EQ(outputs.size(), 2ul);
+        for (const auto& outputData : outputs) {
+            Bitcoin::Proto::SigningOutput output;
+            ASSERT_TRUE(output.ParseFromArray(outputData.data(), (int)outputData.size()));
+            EXPECT_EQ(hex(output.encoded()), ExpectedTx);
+        }
+    }
 }
 
 TEST(BitcoinCompiler, CompileWithSignaturesV2) {
@@ -63,6 +63,76 @@ TEST(CardanoSigning, SelectInputs) {
     }
 }
 
+TEST(CardanoSigning, SelectInputsWithTokens) {
+    const auto cuby = TokenAmount(sundaeTokenPolicy, data("CUBY"), 0).key();
+    const auto sundae = TokenAmount(sundaeTokenPolicy, data("SUNDAE"), 0).key();
+    const auto inputs = std::vector<TxInput>({
+        TxInput{{parse_hex("0001"), 0}, "ad01", 700, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 10)})},
+        TxInput{{parse_hex("0002"), 1}, "ad02", 900, {}},
+        TxInput{{parse_hex("0003"), 2}, "ad03", 300, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 30), TokenAmount(sundaeTokenPolicy, data("SUNDAE"), 5)})},
+        TxInput{{parse_hex("0004"), 3}, "ad04", 600, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 20)})},
+    });
+
+    { // tokens already covered by the ADA selection
+        const auto s1 = Signer::selectInputsWithTokens(inputs, 1500, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 10)}));
+        ASSERT_EQ(s1.size(), 2ul);
+        EXPECT_EQ(s1[0].amount, 900ul);
+        EXPECT_EQ(s1[1].amount, 700ul);
+    }
+    { // largest token holders are added, counting the tokens already selected
+        const auto s1 = Signer::selectInputsWithTokens(inputs, 1500, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 40)}));
+        ASSERT_EQ(s1.size(), 3ul);
+        EXPECT_EQ(s1[2].amount, 300ul);
+    }
+    { // ADA amounts do not count towards token amounts
+        const auto s1 = Signer::selectInputsWithTokens(inputs, 500, TokenBundle({TokenAmount(sundaeTokenPolicy, data("CUBY"), 45)}));
+        ASSERT_EQ(s1.size(), 3ul);
+        EXPECT_EQ(s1[0].amount, 900ul);
+        EXPECT_EQ(s1[1].amount, 300ul);
+        EXPECT_EQ(s1[2].amount, 600ul);
+    }
+    { // inputs without the token are not added, even if not enough
+        const auto s1 = Signer::selectInputsWithTokens(inputs, 500, TokenBundle({TokenAmount(sundaeTokenPolicy, data("SUNDAE"), 100)}));
+        ASSERT_EQ(s1.size(), 2ul);
+        EXPECT_EQ(s1[1].tokenBundle.getAmount(sundae), 5);
+        EXPECT_EQ(s1[1].tokenBundle.getAmount(cuby), 30);
+    }
+}
+
+TEST(CardanoSigning, SelectInputsManyTokens) {
+    // 10k UTXOs, each holding 10 of 100 different tokens
+    constexpr auto utxoCount = 10'000ul;
+    constexpr auto tokenCount = 100ul;
+    std::vector<TxInput> inputs;
+    inputs.reserve(utxoCount);
+    for (auto i = 0ul; i < utxoCount; ++i) {
+        auto bundle = TokenBundle();
+        for (auto t = 0ul; t < 10; ++t) {
+            bundle.add(TokenAmount(sundaeTokenPolicy, data("TOKEN" + std::to_string((i + t * 10) % tokenCount)), uint256_t(i + 1)));
+        }
+        inputs.emplace_back(TxInput{{parse_hex("0001"), i}, "ad01", 1'000'000 + (i * 7919) % utxoCount, bundle});
+    }
+    const auto key = TokenAmount(sundaeTokenPolicy, data("TOKEN42"), 0).key();
+
+    // The largest holders of TOKEN42 hold 9993, 9983, 9973...
+    const auto selected = Signer::selectInputsWithTokens(inputs, 3'000'000, TokenBundle({TokenAmount(sundaeTokenPolicy, data("TOKEN42"), 50'000)}));
+    ASSERT_GE(selected.size(), 3ul);
+    uint64_t selectedAda = 0;
+    uint256_t selectedTokens = 0;
+    for (const auto& input : selected) {
+        selectedAda += input.amount;
+        selectedTokens += input.tokenBundle.getAmount(key);
+    }
+    EXPECT_GE(selectedAda, 3'000'000ul);
+    EXPECT_GE(selectedTokens, 50'000);
+    // No input is selected twice
+    for (auto i = 0ul; i < selected.size(); ++i) {
+        for (auto j = i + 1; j < selected.size(); ++j) {
+            EXPECT_FALSE(selected[i] == selected[j]);
+        }
+    }
+}
+
 Proto::SigningInput createSampleInput(uint64_t amount, int utxoCount = 10,
                                       const std::string& alternateToAddress = "", bool omitPrivateKey = false) {
     const std::string toAddress = (alternateToAddress.length() > 0) ? alternateToAddress : "addr1q92cmkgzv9h4e5q7mnrzsuxtgayvg4qr7y3gyx97ukmz3dfx7r9fu73vqn25377ke6r0xk97zw07dqr9y5myxlgadl2s0dgke5";
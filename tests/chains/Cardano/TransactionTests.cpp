@@ -45,6 +45,41 @@ TEST(CardanoTransaction, Encode) {
     }
 }
 
+TEST(CardanoTransaction, EncodedSize) {
+    Transaction tx = createTx();
+    EXPECT_EQ(tx.encodedSize(), tx.encode().size());
+
+    tx.outputs[1].tokenBundle.add(TokenAmount("9a9693a9a37912a5097918f97918d15240c92ab729a0b7c4aa144d77", data("CUBY"), 3000000));
+    tx.outputs[1].tokenBundle.add(TokenAmount("9a9693a9a37912a5097918f97918d15240c92ab729a0b7c4aa144d77", data("SUNDAE"), 80996569));
+    tx.outputs[1].tokenBundle.add(TokenAmount("219820e6cb04316f41a337fea356480f412e7acc147d28f175f21b5e", data("coolcatssociety4567"), 1));
+    tx.certificates.emplace_back(Certificate{Certificate::SkatingKeyRegistration, {CertificateKey::AddressKeyHash, Data(28, 1)}, Data(), std::nullopt});
+    tx.certificates.emplace_back(Certificate{Certificate::Delegation, {CertificateKey::AddressKeyHash, Data(28, 1)}, Data(28, 2), std::nullopt});
+    tx.certificates.emplace_back(Certificate{Certificate::VoteDelegation, {CertificateKey::AddressKeyHash, Data(28, 1)}, Data(), DRepKey{DRepKey::DRepAlwaysAbstain, {}}});
+    tx.withdrawals.emplace_back(Withdrawal{Data(29, 1), 1000000});
+    tx.auxiliaryDataHash = Data(32, 3);
+    EXPECT_EQ(tx.encodedSize(), tx.encode().size());
+}
+
+TEST(CardanoTransaction, TransactionSize) {
+    const Transaction full = createTx();
+    Transaction tx = full;
+    tx.inputs.clear();
+    tx.outputs.clear();
+    tx.fee = 0;
+
+    EXPECT_EQ(TransactionSize(tx).size(), tx.encode().size());
+    for (const auto& input : full.inputs) {
+        tx.inputs.push_back(input);
+        EXPECT_EQ(TransactionSize(tx).size(), tx.encode().size());
+    }
+    for (const auto& output : full.outputs) {
+        tx.outputs.push_back(output);
+        EXPECT_EQ(TransactionSize(tx).size(), tx.encode().size());
+    }
+    tx.fee = full.fee;
+    EXPECT_EQ(TransactionSize(tx).size(), tx.encode().size());
+}
+
 TEST(CardanoTransaction, GetId) {
     const Transaction tx = createTx();
 
@@ -99,4 +99,79 @@ TEST(EverscaleCell, InvalidCell) {
     ASSERT_THROW(Cell::fromBase64("te6ccgEBAQEAAgABAAE="), std::runtime_error);
 }
 
+TEST(EverscaleCell, DeserializeSharesIdenticalCells) {
+    // Root with two references to distinct, but identical cells
+    const auto boc = parse_hex("b5ee9c720101030100" "0a00" "02000102" "0002ab" "0002ab");
+    const auto cell = Cell::deserialize(boc.data(), boc.size());
+    ASSERT_EQ(cell->refCount, 2);
+    ASSERT_EQ(cell->references[0], cell->references[1]);
+    ASSERT_EQ(hex(cell->references[0]->data), "ab");
+
+    Data data;
+    cell->serialize(data);
+    const auto decoded = Cell::deserialize(data.data(), data.size());
+    ASSERT_EQ(hex(decoded->hash), hex(cell->hash));
+    // stored once: cell count in the header
+    ASSERT_EQ(hex(subData(data, 6, 2)), "0002");
+}
+
+TEST(EverscaleCell, FinalizeAndSerializeDeepTree) {
+    constexpr uint16_t depth = 2000;
+    auto cell = std::make_shared<Cell>();
+    for (auto i = 0; i < depth; ++i) {
+        Cell::Refs refs{cell};
+        cell = std::make_shared<Cell>(8, Data{0xab}, 1, std::move(refs));
+    }
+    // Children are not finalized yet
+    cell->finalize();
+    ASSERT_EQ(cell->depth, depth);
+
+    Data data;
+    cell->serialize(data);
+    const auto decoded = Cell::deserialize(data.data(), data.size());
+    ASSERT_EQ(hex(decoded->hash), hex(cell->hash));
+    ASSERT_EQ(decoded->depth, depth);
+}
+
+TEST(EverscaleCell, SerializeWideTreeWithoutFinalize) {
+    // 4-ary tree with 1024 distinct leaves, large enough for its levels to be hashed in parallel
+    const auto buildTree = [](bool finalizeEach) {
+        std::vector<Cell::Ref> level;
+        for (uint16_t i = 0; i < 1024; ++i) {
+            level.push_back(std::make_shared<Cell>(16, Data{static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)}, 0, Cell::Refs{}));
+            if (finalizeEach) {
+                level.back()->finalize();
+            }
+        }
+        while (level.size() > 1) {
+            std::vector<Cell::Ref> next;
+            for (size_t i = 0; i < level.size(); i += 4) {
+                Cell::Refs refs{level[i], level[i + 1], level[i + 2], level[i + 3]};
+                next.push_back(std::make_shared<Cell>(8, Data{0xab}, 4, std::move(refs)));
+                if (finalizeEach) {
+                    next.back()->finalize();
+                }
+            }
+            level = std::move(next);
+        }
+        return level.front();
+    };
+
+    const auto expected = buildTree(true);
+    Data expectedData;
+    expected->serialize(expectedData);
+
+    // Hashes are computed while serializing
+    const auto cell = buildTree(false);
+    Data data;
+    cell->serialize(data);
+    ASSERT_TRUE(cell->finalized);
+    ASSERT_EQ(hex(cell->hash), hex(expected->hash));
+    ASSERT_EQ(hex(data), hex(expectedData));
+
+    const auto decoded = Cell::deserialize(data.data(), data.size());
+    ASSERT_EQ(hex(decoded->hash), hex(expected->hash));
+    ASSERT_EQ(decoded->depth, 5);
+}
+
 } // namespace TW::Everscale
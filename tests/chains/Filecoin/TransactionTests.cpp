@@ -37,7 +37,7 @@ TEST(FilecoinTransaction, Serialize) {
                    /*method*/ Transaction::MethodType::SEND,
                    /*params*/ Data());
 
-    ASSERT_EQ(hex(tx.message().encoded()),
+    ASSERT_EQ(hex(tx.message()),
               "8a0055013d403ac3911e9f806228326fa68619d36a4641d455013d413d4c3fe3d89f99495a48c6046224"
               "a71f0cd71b0000001234567890430003e81ac6aea1554400a98ac744000516150040");
     ASSERT_EQ(hex(tx.cid()),
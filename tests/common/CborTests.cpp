@@ -63,6 +63,14 @@ TEST(Cbor, EncUInt) {
     EXPECT_EQ("1bffffffffffffffff", hex(Encode::uint(0xffffffffffffffff).encoded()));
 }
 
+TEST(Cbor, HeadSize) {
+    for (const uint64_t value : {0ull, 23ull, 24ull, 0xffull, 0x100ull, 0xffffull, 0x10000ull, 0xffffffffull, 0x100000000ull, 0xffffffffffffffffull}) {
+        EXPECT_EQ(Encode::headSize(value), Encode::uint(value).encoded().size());
+    }
+    EXPECT_EQ(Encode::headSize(3) + 3, Encode::string("abc").encoded().size());
+    EXPECT_EQ(Encode::headSize(300) + 300, Encode::bytes(Data(300)).encoded().size());
+}
+
 TEST(Cbor, EncNegInt) {
     EXPECT_EQ("20", hex(Encode::negInt(1).encoded())); // -1
     EXPECT_EQ("00", hex(Encode::negInt(0).encoded())); // 0
@@ -591,5 +599,192 @@ TEST(Cbor, StringValidUtf8) {
     EXPECT_EQ("\"hello\"", Decode(validUtf8).dumpToString());
 }
 
+TEST(Cbor, WriterSample1) {
+    Writer writer;
+    writer.arrayHead(2).uint(5);
+    writer.beginMap();
+    writer.key().string("x").value().uint(100);
+    writer.key().string("y").value().negInt(50);
+    writer.endMap();
+    EXPECT_EQ("8205a26178186461793831", hex(writer.encoded()));
+}
+
+TEST(Cbor, WriterSameAsEncode) {
+    Writer writer;
+    writer.arrayHead(8)
+        .uint(0x876543210fedcba9)
+        .negInt(0)
+        .negInt(1000)
+        .string("abc")
+        .bytes(parse_hex("0102"))
+        .tag(5).null()
+        .version(21)
+        .raw(Encode::array({Encode::uint(1)}).encoded());
+    EXPECT_EQ(hex(writer.encoded()), hex(Encode::array({
+        Encode::uint(0x876543210fedcba9),
+        Encode::negInt(0),
+        Encode::negInt(1000),
+        Encode::string("abc"),
+        Encode::bytes(parse_hex("0102")),
+        Encode::tag(5, Encode::null()),
+        Encode::version(21),
+        Encode::array({Encode::uint(1)}),
+    }).encoded()));
+}
+
+TEST(Cbor, WriterMapSortedByKey) {
+    // Keys written out of order, and a duplicate key: the first value is kept, like with Encode::map
+    Writer writer;
+    writer.beginMap();
+    writer.key().string("bb").value().uint(1);
+    writer.key().uint(300).value().beginMap();
+    writer.key().bytes(parse_hex("02")).value().uint(2);
+    writer.key().bytes(parse_hex("01")).value().uint(1);
+    writer.endMap();
+    writer.key().uint(7).value().string("seven");
+    writer.key().string("bb").value().uint(2);
+    writer.key().string("a").value().arrayHead(0);
+    writer.endMap();
+
+    const auto expected = Encode::map({
+        make_pair(Encode::string("bb"), Encode::uint(1)),
+        make_pair(Encode::uint(300), Encode::map({
+            make_pair(Encode::bytes(parse_hex("02")), Encode::uint(2)),
+            make_pair(Encode::bytes(parse_hex("01")), Encode::uint(1)),
+        })),
+        make_pair(Encode::uint(7), Encode::string("seven")),
+        make_pair(Encode::string("a"), Encode::array({})),
+    }).encoded();
+    EXPECT_EQ(hex(writer.encoded()), hex(expected));
+    EXPECT_EQ(Decode(writer.encoded()).dumpToString(), "{7: \"seven\", 300: {h\"01\": 1, h\"02\": 2}, \"a\": [], \"bb\": 1}");
+
+    const auto released = writer.release();
+    EXPECT_EQ(hex(released), hex(expected));
+}
+
+TEST(Cbor, WriterEmptyMap) {
+    Writer writer;
+    writer.beginMap().endMap();
+    EXPECT_EQ(hex(writer.encoded()), hex(Encode::map({}).encoded()));
+}
+
+TEST(Cbor, WriterInvalid) {
+    {
+        Writer writer;
+        writer.beginMap();
+        EXPECT_THROW(writer.encoded(), invalid_argument);
+    }
+    {
+        Writer writer;
+        EXPECT_THROW(writer.key(), invalid_argument);
+        EXPECT_THROW(writer.endMap(), invalid_argument);
+    }
+    {
+        Writer writer;
+        writer.beginMap();
+        EXPECT_THROW(writer.value(), invalid_argument);
+    }
+    {
+        // content not preceded by key()
+        Writer writer;
+        writer.beginMap().uint(1);
+        EXPECT_THROW(writer.endMap(), invalid_argument);
+    }
+    {
+        Writer writer;
+        EXPECT_THROW(writer.raw(parse_hex("5b99999999999999991234")), invalid_argument);
+    }
+}
+
+TEST(Cbor, ReaderViewsIntoInput) {
+    const Data cbor = parse_hex("83436162636364656601");
+    const Reader reader(cbor);
+    EXPECT_TRUE(reader.isValid());
+    EXPECT_EQ(reader.getMajorType(), Decode::MT_array);
+    EXPECT_EQ(reader.getTotalLen(), cbor.size());
+
+    std::vector<Reader> elems;
+    for (const auto& elem : reader.elements()) {
+        elems.emplace_back(elem);
+    }
+    ASSERT_EQ(elems.size(), 3ul);
+    const auto bytes = elems[0].getBytes();
+    EXPECT_EQ(hex(bytes), "616263");
+    EXPECT_EQ(bytes.data(), cbor.data() + 2);
+    EXPECT_EQ(elems[1].getString(), "def");
+    EXPECT_EQ(elems[1].getString().data(), reinterpret_cast<const char*>(cbor.data() + 6));
+    EXPECT_EQ(elems[2].getValue(), 1ul);
+    EXPECT_EQ(elems[2].span().data(), cbor.data() + 9);
+    EXPECT_EQ(elems[2].span().size(), 1ul);
+}
+
+TEST(Cbor, ReaderMapElements) {
+    // {_ "a": [1, [2]], "b": tag 24 h"00"}
+    const Data cbor = parse_hex("bf6161820181026162d8184100ff");
+    const Reader reader(cbor);
+    EXPECT_EQ(reader.dumpToString(), Decode(cbor).dumpToString());
+    EXPECT_EQ(reader.getTotalLen(), cbor.size());
+
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    auto isKey = true;
+    for (auto it = reader.elements().begin(); it != std::default_sentinel; ++it) {
+        (isKey ? keys : values).emplace_back(hex(it->encoded()));
+        isKey = !isKey;
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"6161", "6162"}));
+    EXPECT_EQ(values, (std::vector<std::string>{"82018102", "d8184100"}));
+}
+
+TEST(Cbor, ReaderTrailingBytes) {
+    // The data item at the start is read, what follows it is not part of it
+    const Data cbor = parse_hex("8201020304");
+    const Reader reader(cbor);
+    EXPECT_TRUE(reader.isValid());
+    EXPECT_EQ(reader.getTotalLen(), 3ul);
+    EXPECT_EQ(hex(reader.encoded()), "820102");
+}
+
+TEST(Cbor, ReaderSameAsDecode) {
+    const std::vector<std::string> samples = {
+        "00", "3903e7", "4401020304", "6568656c6c6f", "83010203", "9f0102ff", "a201020304",
+        "bf6161016162820203ff", "d8184100", "f6", "f7", "5f", "a301020304", "8301", "9bffffffffffffffff",
+        "bb8000000000000000", "7b0000000100000000", "1c", "bf01ff", "8200",
+    };
+    for (const auto& sample : samples) {
+        const auto cbor = parse_hex(sample);
+        const Reader reader(cbor);
+        const Decode decode(cbor);
+        EXPECT_EQ(reader.isValid(), decode.isValid()) << sample;
+        std::string readerDump = "throws";
+        std::string decodeDump = "throws";
+        try { readerDump = reader.dumpToString(); } catch (const invalid_argument&) {}
+        try { decodeDump = decode.dumpToString(); } catch (const invalid_argument&) {}
+        EXPECT_EQ(readerDump, decodeDump) << sample;
+    }
+}
+
+TEST(Cbor, ReaderInvalid) {
+    EXPECT_FALSE(Reader().isValid());
+    EXPECT_THROW(Reader().head(), invalid_argument);
+    // count larger than the data
+    EXPECT_FALSE(Reader(parse_hex("9bffffffffffffffff")).isValid());
+    EXPECT_THROW(Reader(parse_hex("bb8000000000000000")).getTotalLen(), invalid_argument);
+    // string longer than the data
+    EXPECT_THROW(Reader(parse_hex("6568656c6c")).getString(), invalid_argument);
+    // wrong types
+    const auto uint = parse_hex("01");
+    EXPECT_THROW(Reader(uint).elements(), invalid_argument);
+    EXPECT_THROW(Reader(uint).getBytes(), invalid_argument);
+    EXPECT_THROW(Reader(uint).getTagValue(), invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("6161")).getValue(), invalid_argument);
+}
+
+TEST(Cbor, DecodeFromTemporary) {
+    const auto decode = Decode(parse_hex("8301820203820405"));
+    EXPECT_EQ(decode.dumpToString(), "[1, [2, 3], [4, 5]]");
+    EXPECT_EQ(hex(decode.getArrayElements()[2].encoded()), "820405");
+}
+
 // clang-format on
 } // namespace TW::Cbor::tests
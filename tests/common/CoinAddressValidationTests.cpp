@@ -6,6 +6,7 @@
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 
 namespace TW {
 
@@ -422,4 +423,53 @@ TEST(Coin, ValidateAddressTheOpenNetwork) {
     ASSERT_EQ(normalizeAddress(TWCoinTypeTON, "0:8a8627861a5dd96c9db3ce0807b122da5ed473934ce7568a5b4b1c361cbb28ae"), "UQCKhieGGl3ZbJ2zzggHsSLaXtRzk0znVopbSxw2HLsorhqg");
 }
 
+TEST(Coin, DetectCoins) {
+    const std::vector<std::string> addresses = {
+        "0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89",
+        "0xa0d5b10ee59fb918f7c7d0ba96387e4b1539fa8c7466625c39efdac2286cdfa1",
+        "bc1q2ddhp55sq2l4xnqhpdv0xazg02v9dr7uu8c2p2",
+        "1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2",
+        "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy",
+        "BC1Q2DDHP55SQ2L4XNQHPDV0XAZG02V9DR7UU8C2P2",
+        "ltc1q0dvup9kzplv6yulzgzzxkge8d35axkq4n45hum",
+        "DLSSSUS3ex7YNDACJDxMER1ZMW579Vy8Zy",
+        "DsUoWCAxprdGNtKQqambFbTcSBgH1SHn9Gp",
+        "EXXQe1Xhay75BzoFFhXgpqNTtLomdBKSfyMZ",
+        "bitcoincash:qruxj7zq6yzpdx8dld0e9hfvt7u47zrw9gfr5hy0vh",
+        "t1aQ1JEFMqciA58XU6CR8CNohAYzESm8c1L",
+        "tex1auz6gx89x2wcku6gswdvaz2nf9x3seex6px6v0",
+        "grs1qw4teyraux2s77nhjdwh9ar8rl9dt7zww8r6lne",
+        "cosmos1hkfq3zahaqkkzx5mjnamwjsfpq2jk7z0emlrvp",
+        "COSMOS1HKFQ3ZAHAQKKZX5MJNAMWJSFPQ2JK7Z0EMLRVP",
+        "zil1j8xae6lggm8y63m3y2r7aefu797ze7mhzulnqg",
+        "addr1q8043m5heeaydnvtmmkyuhe6qv5havvhsf0d26q3jygsspxlyfpyk6yqkw0yhtyvtr0flekj84u64az82cufmqn65zdsylzk23",
+        "Ae2tdPwUPEZ6RUCnjGHFqi59k5WZLiv3HoCCNGCW8SYc5H9srdTzn1bec4W",
+        "2gVkYWexTHR5Hb2aLeQN3tnngvWzisFKXDUPrgMHpdST",
+        "TQLCsShbQNXMTVCjprY64qZmEA4rBarpQp",
+        "",
+        "1",
+        "cosmos1",
+        "not an address",
+    };
+
+    // Same as validating the address for every coin.
+    for (const auto& address : addresses) {
+        std::vector<TWCoinType> expected;
+        for (const auto coin : getCoinTypes()) {
+            if (validateAddress(coin, address)) {
+                expected.push_back(coin);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(detectCoins(address), expected) << address;
+    }
+
+    const auto evm = detectCoins("0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89");
+    EXPECT_NE(std::find(evm.begin(), evm.end(), TWCoinTypeEthereum), evm.end());
+    EXPECT_NE(std::find(evm.begin(), evm.end(), TWCoinTypeSmartChain), evm.end());
+    EXPECT_EQ(std::find(evm.begin(), evm.end(), TWCoinTypeBitcoin), evm.end());
+    EXPECT_EQ(detectCoins("cosmos1hkfq3zahaqkkzx5mjnamwjsfpq2jk7z0emlrvp"), std::vector<TWCoinType>{TWCoinTypeCosmos});
+    EXPECT_TRUE(detectCoins("not an address").empty());
+}
+
 } // namespace TW
@@ -654,4 +654,28 @@ TEST(HDWallet, IoTexKeys) {
     // io1qmkv62pvg56qkashkwauhhjv3gtjhcm889r8dc
 }
 
+TEST(HDWallet, DeriveKeys) {
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    const std::vector<HDWallet<>::KeyRequest> requests = {
+        {TWCoinTypeBitcoin, DerivationPath("m/84'/0'/0'/0/0"), TWHDVersionZPUB},
+        {TWCoinTypeBitcoin, DerivationPath("m/44'/0'/0'/0/0"), TWHDVersionXPUB},
+        {TWCoinTypeBitcoin, DerivationPath("m/44'/0'/0'/0/1")},
+        {TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/0"), TWHDVersionXPUB},
+        {TWCoinTypeSolana, DerivationPath("m/44'/501'/0'")},
+        {TWCoinTypeCardano, DerivationPath("m/1852'/1815'/0'/0/0")},
+        {TWCoinTypeBitcoin, DerivationPath("m/84'/0'/0'/0/0"), TWHDVersionZPUB},
+    };
+
+    const auto keys = wallet.deriveKeys(requests);
+
+    ASSERT_EQ(keys.size(), requests.size());
+    for (auto i = 0ul; i < requests.size(); ++i) {
+        const auto& request = requests[i];
+        EXPECT_EQ(hex(keys[i].privateKey.bytes), hex(wallet.getKey(request.coin, request.derivationPath).bytes));
+        EXPECT_EQ(keys[i].extendedPublicKey, wallet.getExtendedPublicKey(request.derivationPath.purpose(), request.coin, request.extendedPublicKeyVersion));
+    }
+    EXPECT_EQ(keys[0].extendedPublicKey, "zpub6rNUNtxSa9Gxvm4Bdxf1MPMwrvkzwDx6vP96Hkzw3jiQKdg3fhXBStxjn12YixQB8h88B3RMSRscRstf9AEVaYr3MAqVBEWBDuEJU4PGaT9");
+    EXPECT_TRUE(keys[2].extendedPublicKey.empty());
+}
+
 } // namespace TW::HDWalletTests
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Keystore/StoredKeyDirectory.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+extern std::string TESTS_ROOT;
+
+namespace TW::Keystore::tests {
+
+namespace fs = std::filesystem;
+
+const auto gKeyId = "e13b209c-3b2f-4327-bab0-3bef2e51630d";
+const auto gKeyAddress = "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b";
+const auto gWalletId = "e0fe53d0-7a3d-4f65-88b1-9bb4e245a169";
+
+class StoredKeyDirectoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = fs::temp_directory_path() / ("StoredKeyDirectory-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+        copyTestKey("key.json");
+        copyTestKey("wallet.json");
+        std::ofstream(directory / "notes.txt") << "not a key";
+    }
+
+    void TearDown() override {
+        fs::remove_all(directory);
+    }
+
+    void copyTestKey(const std::string& fileName) {
+        fs::copy_file(TESTS_ROOT + "/common/Keystore/Data/" + fileName, directory / fileName);
+    }
+
+    fs::path directory;
+};
+
+TEST_F(StoredKeyDirectoryTest, Index) {
+    const StoredKeyDirectory keys(directory.string());
+
+    EXPECT_EQ(keys.size(), 2ul);
+    EXPECT_EQ(keys.identifiers(), std::vector<std::string>({gWalletId, gKeyId}));
+    EXPECT_EQ(keys.identifier(1), gKeyId);
+    EXPECT_FALSE(keys.identifier(2).has_value());
+
+    const auto entry = keys.entry(gKeyId);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->name, "Test Account");
+    EXPECT_EQ(entry->type, StoredKeyType::privateKey);
+    EXPECT_EQ(entry->fileName, "key.json");
+    EXPECT_EQ(keys.entry(gWalletId)->type, StoredKeyType::mnemonicPhrase);
+    EXPECT_FALSE(keys.entry("notes.txt").has_value());
+
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), gKeyId);
+    EXPECT_FALSE(keys.findKey(TWCoinTypeBitcoin, gKeyAddress).has_value());
+
+    const auto key = keys.load(gKeyId);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key->id, gKeyId);
+    EXPECT_EQ(key->accounts()[0].address, gKeyAddress);
+    EXPECT_TRUE(fs::exists(directory / StoredKeyDirectory::indexFileName));
+}
+
+TEST_F(StoredKeyDirectoryTest, ReopenUsesIndex) {
+    { const StoredKeyDirectory keys(directory.string()); }
+
+    // Damage a key file in place without changing its size or modification time:
+    // only the index can tell what it contained.
+    const auto path = directory / "key.json";
+    const auto size = fs::file_size(path);
+    const auto modified = fs::last_write_time(path);
+    {
+        std::fstream stream(path, std::ios::in | std::ios::out);
+        stream << "{}";
+    }
+    fs::last_write_time(path, modified);
+    ASSERT_EQ(fs::file_size(path), size);
+
+    StoredKeyDirectory keys(directory.string());
+    EXPECT_EQ(keys.size(), 2ul);
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), gKeyId);
+    EXPECT_FALSE(keys.refresh());
+}
+
+TEST_F(StoredKeyDirectoryTest, DamagedIndex) {
+    std::ofstream(directory / StoredKeyDirectory::indexFileName) << R"({"version":1,"files":{"key.json":{"size":"x"}}})";
+
+    const StoredKeyDirectory keys(directory.string());
+    EXPECT_EQ(keys.size(), 2ul);
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), gKeyId);
+}
+
+TEST_F(StoredKeyDirectoryTest, Refresh) {
+    StoredKeyDirectory keys(directory.string());
+    EXPECT_FALSE(keys.refresh());
+
+    fs::remove(directory / "key.json");
+    EXPECT_TRUE(keys.refresh());
+    EXPECT_EQ(keys.size(), 1ul);
+    EXPECT_FALSE(keys.findKey(TWCoinTypeEthereum, gKeyAddress).has_value());
+    EXPECT_FALSE(keys.load(gKeyId).has_value());
+
+    copyTestKey("key.json");
+    EXPECT_TRUE(keys.refresh());
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), gKeyId);
+}
+
+TEST_F(StoredKeyDirectoryTest, StoreAndRemove) {
+    StoredKeyDirectory keys(directory.string());
+    auto key = *keys.load(gKeyId);
+
+    // Replaces the file of the key.
+    key.name = "Renamed";
+    keys.store(key);
+    EXPECT_EQ(keys.size(), 2ul);
+    EXPECT_EQ(keys.entry(gKeyId)->name, "Renamed");
+    EXPECT_EQ(keys.load(gKeyId)->name, "Renamed");
+    EXPECT_FALSE(keys.refresh());
+
+    // A new key is stored in a file named after its identifier.
+    key.id = "0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e";
+    auto account = key.accounts()[0];
+    account.address = "0x0000000000000000000000000000000000000001";
+    key.replaceAccount(0, account);
+    keys.store(key);
+    EXPECT_EQ(keys.size(), 3ul);
+    EXPECT_TRUE(fs::exists(directory / "0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e.json"));
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, "0x0000000000000000000000000000000000000001"), "0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e");
+
+    key.id = "../escape";
+    EXPECT_THROW(keys.store(key), std::invalid_argument);
+
+    EXPECT_TRUE(keys.remove(gKeyId));
+    EXPECT_FALSE(keys.remove(gKeyId));
+    EXPECT_FALSE(fs::exists(directory / "key.json"));
+    EXPECT_FALSE(keys.findKey(TWCoinTypeEthereum, gKeyAddress).has_value());
+
+    const StoredKeyDirectory reopened(directory.string());
+    EXPECT_EQ(reopened.identifiers(), std::vector<std::string>({"0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e", gWalletId}));
+}
+
+TEST_F(StoredKeyDirectoryTest, SharedLookups) {
+    // The same key in two files, and another key with the same account.
+    fs::copy_file(directory / "key.json", directory / "copy.json");
+    StoredKeyDirectory keys(directory.string());
+    auto other = *keys.load(gKeyId);
+    other.id = "0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e";
+    keys.store(other);
+    EXPECT_EQ(keys.size(), 3ul);
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), gKeyId);
+
+    // Removing the file of the key leaves the other copy.
+    const auto fileName = keys.entry(gKeyId)->fileName;
+    const auto otherFileName = fileName == "key.json" ? "copy.json" : "key.json";
+    fs::remove(directory / fileName);
+    EXPECT_TRUE(keys.refresh());
+    EXPECT_EQ(keys.size(), 3ul);
+    EXPECT_EQ(keys.entry(gKeyId)->fileName, otherFileName);
+    EXPECT_TRUE(keys.load(gKeyId).has_value());
+    EXPECT_TRUE(keys.findKey(TWCoinTypeEthereum, gKeyAddress).has_value());
+
+    // Removing the last copy leaves the other key with the same account.
+    EXPECT_TRUE(keys.remove(gKeyId));
+    EXPECT_FALSE(keys.load(gKeyId).has_value());
+    EXPECT_EQ(keys.findKey(TWCoinTypeEthereum, gKeyAddress), "0d9b9d44-0c7b-4c3d-8bd4-1b4d7a4a0b7e");
+}
+
+} // namespace TW::Keystore::tests
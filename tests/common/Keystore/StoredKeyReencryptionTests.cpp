@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Keystore/StoredKeyReencryption.h"
+#include "Keystore/StoredKey.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+namespace TW::Keystore::tests {
+
+namespace fs = std::filesystem;
+
+const auto gOldPassword = TW::data("old password");
+const auto gNewPassword = TW::data("new password");
+const auto gMnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+const auto gMnemonicData = TW::data(gMnemonic);
+
+class StoredKeyReencryptionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = fs::temp_directory_path() / ("StoredKeyReencryption-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+    }
+
+    void TearDown() override {
+        fs::remove_all(directory);
+    }
+
+    std::string storeKey(const std::string& fileName, TWStoredKeyEncryptionLevel encryptionLevel) {
+        const auto path = (directory / fileName).string();
+        StoredKey::createWithMnemonic(fileName, gOldPassword, gMnemonic, encryptionLevel).store(path);
+        return path;
+    }
+
+    fs::path directory;
+};
+
+TEST_F(StoredKeyReencryptionTest, RotatePassword) {
+    std::vector<ReencryptionJob> jobs;
+    for (auto i = 0; i < 6; ++i) {
+        jobs.push_back({storeKey("key" + std::to_string(i) + ".json", TWStoredKeyEncryptionLevelMinimal), gOldPassword, gNewPassword});
+    }
+    jobs.push_back({storeKey("wrong.json", TWStoredKeyEncryptionLevelMinimal), gNewPassword, gNewPassword});
+    jobs.push_back({(directory / "missing.json").string(), gOldPassword, gNewPassword});
+
+    // A tiny budget runs the key derivations one at a time.
+    ReencryptionOptions options;
+    options.memoryBudget = 1;
+    const auto results = reencryptKeyFiles(jobs, options);
+
+    ASSERT_EQ(results.size(), jobs.size());
+    for (auto i = 0; i < 6; ++i) {
+        EXPECT_EQ(results[i].status, ReencryptionStatus::reencrypted);
+        const auto key = StoredKey::load(jobs[i].path);
+        EXPECT_EQ(key.payload.decrypt(gNewPassword), gMnemonicData);
+        EXPECT_EQ(std::get<ScryptParameters>(key.payload.params.kdfParams).n, 4096ul);
+    }
+    // Same password without an encryption level: nothing to do.
+    EXPECT_EQ(results[6].status, ReencryptionStatus::unchanged);
+    EXPECT_EQ(results[7].status, ReencryptionStatus::failed);
+    EXPECT_FALSE(results[7].error.empty());
+
+    // No temporary file is left behind.
+    EXPECT_EQ(std::distance(fs::directory_iterator(directory), fs::directory_iterator()), 7);
+}
+
+TEST_F(StoredKeyReencryptionTest, InvalidPassword) {
+    const auto path = storeKey("key.json", TWStoredKeyEncryptionLevelMinimal);
+    const auto before = StoredKey::load(path).json();
+
+    const auto results = reencryptKeyFiles({{path, gNewPassword, gOldPassword}});
+
+    ASSERT_EQ(results.size(), 1ul);
+    EXPECT_EQ(results[0].status, ReencryptionStatus::invalidPassword);
+    EXPECT_EQ(StoredKey::load(path).json(), before);
+}
+
+TEST_F(StoredKeyReencryptionTest, UpgradeEncryptionLevel) {
+    const auto weak = storeKey("weak.json", TWStoredKeyEncryptionLevelMinimal);
+    const auto upgraded = storeKey("upgraded.json", TWStoredKeyEncryptionLevelWeak);
+
+    ReencryptionOptions options;
+    options.encryptionLevel = TWStoredKeyEncryptionLevelWeak;
+    const auto results = reencryptKeyFiles({{weak, gOldPassword, gOldPassword}, {upgraded, gOldPassword, gOldPassword}}, options);
+
+    EXPECT_EQ(results[0].status, ReencryptionStatus::reencrypted);
+    EXPECT_EQ(results[1].status, ReencryptionStatus::unchanged);
+    const auto key = StoredKey::load(weak);
+    EXPECT_EQ(std::get<ScryptParameters>(key.payload.params.kdfParams).n, 16384ul);
+    EXPECT_EQ(std::get<ScryptParameters>(key.payload.params.kdfParams).p, 4ul);
+    EXPECT_EQ(key.payload.decrypt(gOldPassword), gMnemonicData);
+}
+
+TEST_F(StoredKeyReencryptionTest, ResumeFromCheckpoint) {
+    const auto first = storeKey("first.json", TWStoredKeyEncryptionLevelMinimal);
+    const auto second = storeKey("second.json", TWStoredKeyEncryptionLevelMinimal);
+    ReencryptionOptions options;
+    options.checkpointPath = (directory / ".checkpoint").string();
+
+    // The second key fails to re-encrypt, e.g. it was given the wrong password.
+    auto results = reencryptKeyFiles({{first, gOldPassword, gNewPassword}, {second, TW::data("wrong password"), gNewPassword}}, options);
+    EXPECT_EQ(results[0].status, ReencryptionStatus::reencrypted);
+    EXPECT_EQ(results[1].status, ReencryptionStatus::invalidPassword);
+
+    std::ifstream checkpoint(options.checkpointPath);
+    std::string line;
+    ASSERT_TRUE(std::getline(checkpoint, line));
+    EXPECT_EQ(line, first);
+    EXPECT_FALSE(std::getline(checkpoint, line));
+
+    // Run again: the first key is not re-encrypted with its old password.
+    results = reencryptKeyFiles({{first, gOldPassword, gNewPassword}, {second, gOldPassword, gNewPassword}}, options);
+    EXPECT_EQ(results[0].status, ReencryptionStatus::checkpointed);
+    EXPECT_EQ(results[1].status, ReencryptionStatus::reencrypted);
+    EXPECT_EQ(StoredKey::load(first).payload.decrypt(gNewPassword), gMnemonicData);
+    EXPECT_EQ(StoredKey::load(second).payload.decrypt(gNewPassword), gMnemonicData);
+}
+
+TEST_F(StoredKeyReencryptionTest, ResumeAfterReplacedFile) {
+    const auto path = storeKey("key.json", TWStoredKeyEncryptionLevelMinimal);
+    ReencryptionOptions options;
+    options.checkpointPath = (directory / ".checkpoint").string();
+
+    // The file was replaced, but the batch was interrupted before adding it to the checkpoint.
+    auto key = StoredKey::load(path);
+    key.reencrypt(gOldPassword, gNewPassword);
+    key.store(path);
+
+    auto results = reencryptKeyFiles({{path, gOldPassword, gNewPassword}}, options);
+    EXPECT_EQ(results[0].status, ReencryptionStatus::unchanged);
+    EXPECT_EQ(StoredKey::load(path).json(), key.json());
+
+    results = reencryptKeyFiles({{path, gOldPassword, gNewPassword}}, options);
+    EXPECT_EQ(results[0].status, ReencryptionStatus::checkpointed);
+
+    // Without a checkpoint file, the current password is required.
+    results = reencryptKeyFiles({{path, gOldPassword, gNewPassword}});
+    EXPECT_EQ(results[0].status, ReencryptionStatus::invalidPassword);
+}
+
+} // namespace TW::Keystore::tests
@@ -3,6 +3,7 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "Keystore/StoredKey.h"
+#include "Keystore/StoredKeyCodec.h"
 
 #include "Bitcoin/Address.h"
 #include "Coin.h"
@@ -13,6 +14,8 @@
 
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <stdexcept>
 
 extern std::string TESTS_ROOT;
@@ -39,7 +42,7 @@ TEST(StoredKey, CreateWithMnemonic) {
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
 
     const auto json = key.json();
@@ -67,7 +70,7 @@ TEST(StoredKey, CreateWithMnemonicRandom) {
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_TRUE(mnemo2Data.size() >= 36);
     EXPECT_TRUE(Mnemonic::isValid(string(mnemo2Data.begin(), mnemo2Data.end())));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 }
 
 TEST(StoredKey, CreateWithMnemonicAddDefaultAddress) {
@@ -77,11 +80,11 @@ TEST(StoredKey, CreateWithMnemonicAddDefaultAddress) {
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
 
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
-    EXPECT_EQ(key.accounts[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
-    EXPECT_EQ(key.accounts[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(key.accounts()[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
+    EXPECT_EQ(key.accounts()[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), "d2568511baea8dc347f14c4e0479eb8ebe29eb5f664ed796e755896250ffd11f");
 }
 
@@ -93,11 +96,11 @@ TEST(StoredKey, CreateWithMnemonicAddDefaultAddressAes192Ctr) {
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
 
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
-    EXPECT_EQ(key.accounts[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
-    EXPECT_EQ(key.accounts[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(key.accounts()[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
+    EXPECT_EQ(key.accounts()[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), "d2568511baea8dc347f14c4e0479eb8ebe29eb5f664ed796e755896250ffd11f");
 }
 
@@ -109,11 +112,11 @@ TEST(StoredKey, CreateWithMnemonicAddDefaultAddressAes256Ctr) {
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
 
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
-    EXPECT_EQ(key.accounts[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
-    EXPECT_EQ(key.accounts[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(key.accounts()[0].publicKey, "02df6fc590ab3101bbe0bb5765cbaeab9b5dcfe09ac9315d707047cbd13bc7e006");
+    EXPECT_EQ(key.accounts()[0].extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), "d2568511baea8dc347f14c4e0479eb8ebe29eb5f664ed796e755896250ffd11f");
 }
 
@@ -121,9 +124,9 @@ TEST(StoredKey, CreateWithPrivateKeyAddDefaultAddress) {
     const auto privateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
     auto key = StoredKey::createWithPrivateKeyAddDefaultAddress("name", gPassword, coinTypeBc, privateKey);
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), hex(privateKey));
 
     const auto json = key.json();
@@ -138,9 +141,9 @@ TEST(StoredKey, CreateWithPrivateKeyAddDefaultAddressAes192Ctr) {
     auto header = key.payload;
     EXPECT_EQ(header.params.cipher(), "aes-192-ctr");
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), hex(privateKey));
 
     const auto json = key.json();
@@ -155,9 +158,9 @@ TEST(StoredKey, CreateWithPrivateKeyAddDefaultAddressAes256Ctr) {
     auto header = key.payload;
     EXPECT_EQ(header.params.cipher(), "aes-256-ctr");
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
     EXPECT_EQ(hex(key.privateKey(coinTypeBc, gPassword).bytes), hex(privateKey));
 
     const auto json = key.json();
@@ -179,46 +182,46 @@ TEST(StoredKey, CreateWithPrivateKeyAddDefaultAddressInvalid) {
 
 TEST(StoredKey, AccountGetCreate) {
     auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     // not exists
     EXPECT_FALSE(key.account(coinTypeBc).has_value());
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     auto wallet = key.wallet(gPassword);
     // not exists, wallet null, not create
     EXPECT_FALSE(key.account(coinTypeBc, nullptr).has_value());
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     // not exists, wallet nonnull, create
     std::optional<Account> acc3 = key.account(coinTypeBc, &wallet);
     EXPECT_TRUE(acc3.has_value());
     EXPECT_EQ(acc3->coin, coinTypeBc);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
 
     // exists
     std::optional<Account> acc4 = key.account(coinTypeBc);
     EXPECT_TRUE(acc4.has_value());
     EXPECT_EQ(acc4->coin, coinTypeBc);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
 
     // exists, wallet nonnull, not create
     std::optional<Account> acc5 = key.account(coinTypeBc, &wallet);
     EXPECT_TRUE(acc5.has_value());
     EXPECT_EQ(acc5->coin, coinTypeBc);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
 
     // exists, wallet null, not create
     std::optional<Account> acc6 = key.account(coinTypeBc, nullptr);
     EXPECT_TRUE(acc6.has_value());
     EXPECT_EQ(acc6->coin, coinTypeBc);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
 }
 
 TEST(StoredKey, AccountGetDoesntChange) {
     auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
     auto wallet = key.wallet(gPassword);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     vector<TWCoinType> coins = {coinTypeBc, coinTypeEth, coinTypeBnb};
     // retrieve multiple accounts, which will be created
@@ -241,24 +244,24 @@ TEST(StoredKey, AccountGetDoesntChange) {
 
 TEST(StoredKey, AddRemoveAccount) {
     auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     {
         const auto derivationPath = DerivationPath("m/84'/0'/0'/0/0");
         key.addAccount("bc1qaucw06s3agez8tyyk4zj9kt0q2934e3mcewdpf", coinTypeBc, TWDerivationDefault, derivationPath, "", "zpub6rxtad3SPT1C5GUDjPiKQ5oJN5DBeMbdUR7LrdYt12VbU7TBSpGUkdLvfVYGuj1N5edkDoZ3bu1fdN1HprQYfCBdsSH5CaAAygHGsanwtTe");
-        EXPECT_EQ(key.accounts.size(), 1ul);
+        EXPECT_EQ(key.accounts().size(), 1ul);
     }
     {
         const auto derivationPath = DerivationPath("m/714'/0'/0'/0/0");
         key.addAccount("bnb1utrnnjym7ustgw7pgyvtmnxay4qmt3ahh276nu", coinTypeBnb, TWDerivationDefault, derivationPath, "", "");
         key.addAccount("0x23b02dC8f67eD6cF8DCa47935791954286ffe7c9", coinTypeBsc, TWDerivationDefault, derivationPath, "", "");
-        EXPECT_EQ(key.accounts.size(), 3ul);
+        EXPECT_EQ(key.accounts().size(), 3ul);
     }
     {
         const auto derivationPath = DerivationPath("m/60'/0'/0'/0/0");
         key.addAccount("0xC0d97f61A84A0708225F15d54978D628Fe2C5E62", coinTypeEth, TWDerivationDefault, derivationPath, "", "");
         key.addAccount("0xC0d97f61A84A0708225F15d54978D628Fe2C5E62", coinTypeBscLegacy, TWDerivationDefault, derivationPath, "", "");
-        EXPECT_EQ(key.accounts.size(), 5ul);
+        EXPECT_EQ(key.accounts().size(), 5ul);
     }
 
     key.removeAccount(coinTypeBc);
@@ -266,56 +269,115 @@ TEST(StoredKey, AddRemoveAccount) {
     key.removeAccount(coinTypeBsc);
     key.removeAccount(coinTypeEth);
     key.removeAccount(coinTypeBscLegacy);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 }
 
 TEST(StoredKey, AddRemoveAccountDerivation) {
     auto key = StoredKey::createWithMnemonic("name", Data(), gMnemonic, TWStoredKeyEncryptionLevelDefault);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     const auto derivationPath = DerivationPath("m/84'/0'/0'/0/0");
     {
         key.addAccount("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", coinTypeBc, TWDerivationDefault, derivationPath, "", "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
-        EXPECT_EQ(key.accounts.size(), 1ul);
+        EXPECT_EQ(key.accounts().size(), 1ul);
     }
     {
         key.addAccount("1NyRyFewhZcWMa9XCj3bBxSXPXyoSg8dKz", coinTypeBc, TWDerivationBitcoinLegacy, derivationPath, "", "xpub6CR52eaUuVb4kXAVyHC2i5ZuqJ37oWNPZFtjXaazFPXZD45DwWBYEBLdrF7fmCR9pgBuCA9Q57zZfyJjDUBDNtWkhWuGHNYKLgDHpqrHsxV");
-        EXPECT_EQ(key.accounts.size(), 2ul);
+        EXPECT_EQ(key.accounts().size(), 2ul);
     }
 
     key.removeAccount(coinTypeBc, TWDerivationDefault);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
     key.removeAccount(coinTypeBc, TWDerivationDefault); // try 2nd time
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
     key.removeAccount(coinTypeBc, TWDerivationBitcoinLegacy);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     key.removeAccount(coinTypeBc, TWDerivationBitcoinLegacy); // try 2nd time
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 }
 
 TEST(StoredKey, AddRemoveAccountDerivationPath) {
     auto key = StoredKey::createWithMnemonic("name", Data(), gMnemonic, TWStoredKeyEncryptionLevelDefault);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     const auto derivationPath0 = DerivationPath("m/84'/0'/0'/0/0");
     {
         key.addAccount("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", coinTypeBc, TWDerivationDefault, derivationPath0, "", "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
-        EXPECT_EQ(key.accounts.size(), 1ul);
+        EXPECT_EQ(key.accounts().size(), 1ul);
     }
     const auto derivationPath1 = DerivationPath("m/84'/0'/0'/1/0");
     {
         key.addAccount("bc1qumuzptwdr6jlsqum8jnzz80rdg8nx6x29m2qpu", coinTypeBc, TWDerivationDefault, derivationPath1, "", "zpub6rxtad3SPT1C5GUDjPiKQ5oJN5DBeMbdUR7LrdYt12VbU7TBSpGUkdLvfVYGuj1N5edkDoZ3bu1fdN1HprQYfCBdsSH5CaAAygHGsanwtTe");
-        EXPECT_EQ(key.accounts.size(), 2ul);
+        EXPECT_EQ(key.accounts().size(), 2ul);
     }
 
     key.removeAccount(coinTypeBc, derivationPath0);
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
     key.removeAccount(coinTypeBc, derivationPath0); // try 2nd time
-    EXPECT_EQ(key.accounts.size(), 1ul);
+    EXPECT_EQ(key.accounts().size(), 1ul);
     key.removeAccount(coinTypeBc, derivationPath1);
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     key.removeAccount(coinTypeBc, derivationPath1); // try 2nd time
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
+}
+
+TEST(StoredKey, FindAccount) {
+    auto key = StoredKey::load(testDataPath("key.json"));
+    const auto ethAddress = "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b";
+    const auto derivationPath = DerivationPath("m/84'/0'/0'/0/0");
+    key.addAccount(ethAddress, coinTypeBsc, TWDerivationDefault, derivationPath, "", "");
+    key.addAccount("1NyRyFewhZcWMa9XCj3bBxSXPXyoSg8dKz", coinTypeBc, TWDerivationBitcoinLegacy, derivationPath, "", "");
+    key.addAccount("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", coinTypeBc, TWDerivationDefault, derivationPath, "", "");
+    key.addAccount("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", coinTypeBc, TWDerivationDefault, derivationPath, "", ""); // already present
+    ASSERT_EQ(key.accounts().size(), 4ul);
+
+    // Same address for several coins
+    EXPECT_EQ(key.findAccount(coinTypeEth, ethAddress), &key.accounts()[0]);
+    EXPECT_EQ(key.findAccount(coinTypeBsc, ethAddress), &key.accounts()[1]);
+    EXPECT_EQ(key.findAccount(coinTypeBnb, ethAddress), nullptr);
+    EXPECT_EQ(key.findAccount(coinTypeBc, "bc1qumuzptwdr6jlsqum8jnzz80rdg8nx6x29m2qpu"), nullptr);
+
+    // Default derivation is preferred
+    EXPECT_EQ(key.findAccount(coinTypeBc), &key.accounts()[3]);
+    EXPECT_EQ(key.findAccount(coinTypeBc, TWDerivationBitcoinLegacy), &key.accounts()[2]);
+    EXPECT_EQ(key.findAccount(coinTypeBc, TWDerivationSolanaSolana), nullptr);
+    EXPECT_EQ(key.findAccount(coinTypeBnb), nullptr);
+    EXPECT_EQ(key.getAccounts(coinTypeBc).size(), 2ul);
+    EXPECT_EQ(key.account(coinTypeBc)->address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+
+    key.removeAccount(coinTypeEth);
+    ASSERT_EQ(key.accounts().size(), 3ul);
+    EXPECT_EQ(key.findAccount(coinTypeEth, ethAddress), nullptr);
+    EXPECT_EQ(key.findAccount(coinTypeBsc, ethAddress), &key.accounts()[0]);
+    EXPECT_EQ(key.findAccount(coinTypeBc), &key.accounts()[2]);
+
+    key.addAccount("bnb1utrnnjym7ustgw7pgyvtmnxay4qmt3ahh276nu", coinTypeBnb, TWDerivationDefault, derivationPath, "", "");
+    EXPECT_EQ(key.findAccount(coinTypeBnb), &key.accounts()[3]);
+    EXPECT_EQ(key.findAccount(coinTypeBnb, "bnb1utrnnjym7ustgw7pgyvtmnxay4qmt3ahh276nu"), &key.accounts()[3]);
+
+    // Replacing an account keeps the index up to date, also for the same number of accounts
+    auto replaced = key.accounts()[0];
+    replaced.address = "0x23b02dC8f67eD6cF8DCa47935791954286ffe7c9";
+    key.replaceAccount(0, replaced);
+    EXPECT_EQ(key.findAccount(coinTypeBsc, "0x23b02dC8f67eD6cF8DCa47935791954286ffe7c9"), &key.accounts()[0]);
+    EXPECT_EQ(key.findAccount(coinTypeBsc, ethAddress), nullptr);
+
+    replaced.coin = coinTypeEth;
+    key.replaceAccount(0, replaced);
+    EXPECT_EQ(key.findAccount(coinTypeBsc), nullptr);
+    EXPECT_EQ(key.findAccount(coinTypeEth), &key.accounts()[0]);
+    EXPECT_THROW(key.replaceAccount(4, replaced), std::out_of_range);
+
+    auto accounts = key.accounts();
+    std::swap(accounts[0], accounts[3]);
+    key.setAccounts(accounts);
+    EXPECT_EQ(key.findAccount(coinTypeEth), &key.accounts()[3]);
+    EXPECT_EQ(key.findAccount(coinTypeBnb), &key.accounts()[0]);
+
+    // The index is not persisted
+    const auto reloaded = StoredKey::createWithJson(key.json());
+    EXPECT_EQ(reloaded.json(), key.json());
+    EXPECT_EQ(reloaded.findAccount(coinTypeBnb), &reloaded.accounts()[0]);
 }
 
 TEST(StoredKey, FixAddress) {
@@ -350,7 +412,7 @@ TEST(StoredKey, LoadLegacyPrivateKey) {
     const auto key = StoredKey::load(testDataPath("legacy-private-key.json"));
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
     EXPECT_EQ(key.id, "3051ca7d-3d36-4a4a-acc2-09e9083732b0");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeEthereum);
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeEthereum);
     EXPECT_EQ(hex(key.payload.decrypt(TW::data("testpassword"))), "7a28b5ba57c53603b0b07b56bba752f7784bf506fa95edc395f5cf6c7514fe9d");
 }
 
@@ -358,7 +420,7 @@ TEST(StoredKey, LoadLivepeerKey) {
     const auto key = StoredKey::load(testDataPath("livepeer.json"));
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
     EXPECT_EQ(key.id, "70ea3601-ee21-4e94-a7e4-66255a987d22");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeEthereum);
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeEthereum);
     EXPECT_EQ(hex(key.payload.decrypt(TW::data("Radchenko"))), "09b4379d9a41a71d94ee36357bccb4d77b45e7fd9307e2c0f673dd54c0558c73");
 }
 
@@ -394,13 +456,13 @@ TEST(StoredKey, LoadLegacyMnemonic) {
     const auto mnemonic = string(reinterpret_cast<const char*>(data.data()));
     EXPECT_EQ(mnemonic, "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn back");
 
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeEthereum);
-    EXPECT_EQ(key.accounts[0].derivationPath.string(), "m/44'/60'/0'/0/0");
-    EXPECT_EQ(key.accounts[0].address, "");
-    EXPECT_EQ(key.accounts[1].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[1].derivationPath.string(), "m/84'/0'/0'/0/0");
-    EXPECT_EQ(key.accounts[1].address, "");
-    EXPECT_EQ(key.accounts[1].extendedPublicKey, "zpub6r97AegwVxVbJeuDAWP5KQgX5y4Q6KyFUrsFQRn8yzSXrnmpwg1ZKHSWwECR1Kiqgr4h93WN5kdS48KC6hVFniuZHqVFXjULZZkCwurqyPn");
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeEthereum);
+    EXPECT_EQ(key.accounts()[0].derivationPath.string(), "m/44'/60'/0'/0/0");
+    EXPECT_EQ(key.accounts()[0].address, "");
+    EXPECT_EQ(key.accounts()[1].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[1].derivationPath.string(), "m/84'/0'/0'/0/0");
+    EXPECT_EQ(key.accounts()[1].address, "");
+    EXPECT_EQ(key.accounts()[1].extendedPublicKey, "zpub6r97AegwVxVbJeuDAWP5KQgX5y4Q6KyFUrsFQRn8yzSXrnmpwg1ZKHSWwECR1Kiqgr4h93WN5kdS48KC6hVFniuZHqVFXjULZZkCwurqyPn");
 }
 
 TEST(StoredKey, LoadFromWeb3j) {
@@ -506,21 +568,21 @@ TEST(StoredKey, CreateAccountsAes256) {
 TEST(StoredKey, DecodingEthereumAddress) {
     const auto key = StoredKey::load(testDataPath("key.json"));
 
-    EXPECT_EQ(key.accounts[0].address, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
+    EXPECT_EQ(key.accounts()[0].address, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
 }
 
 TEST(StoredKey, DecodingBitcoinAddress) {
     const auto key = StoredKey::load(testDataPath("key_bitcoin.json"));
 
-    EXPECT_EQ(key.accounts[0].address, "3PWazDi9n1Hfyq9gXFxDxzADNL8RNYyK2y");
+    EXPECT_EQ(key.accounts()[0].address, "3PWazDi9n1Hfyq9gXFxDxzADNL8RNYyK2y");
 }
 
 TEST(StoredKey, RemoveAccount) {
     auto key = StoredKey::load(testDataPath("legacy-mnemonic.json"));
-    EXPECT_EQ(key.accounts.size(), 2ul);
+    EXPECT_EQ(key.accounts().size(), 2ul);
     key.removeAccount(TWCoinTypeEthereum);
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
 }
 
 TEST(StoredKey, FixScryptWithEmptySaltAes256Ctr) {
@@ -531,9 +593,9 @@ TEST(StoredKey, FixScryptWithEmptySaltAes256Ctr) {
     EXPECT_EQ(key.id.value(), "a1357f23-333f-4efb-99ab-ec212c275810");
     EXPECT_EQ(key.name, "name");
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].address, "TMdz5HbKCqU1y5M9o5KW9yf1SZCLsLzHiU");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeTron);
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].address, "TMdz5HbKCqU1y5M9o5KW9yf1SZCLsLzHiU");
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeTron);
 
     const auto jsonBefore = key.json();
     EXPECT_EQ(jsonBefore["crypto"]["cipher"], "aes-256-ctr");
@@ -550,9 +612,9 @@ TEST(StoredKey, FixScryptWithEmptySaltAes256Ctr) {
     EXPECT_EQ(key.id.value(), "a1357f23-333f-4efb-99ab-ec212c275810");
     EXPECT_EQ(key.name, "name");
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].address, "TMdz5HbKCqU1y5M9o5KW9yf1SZCLsLzHiU");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeTron);
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].address, "TMdz5HbKCqU1y5M9o5KW9yf1SZCLsLzHiU");
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeTron);
     const auto jsonAfter = key.json();
     EXPECT_EQ(jsonAfter["crypto"]["cipher"], "aes-256-ctr");
 
@@ -586,9 +648,9 @@ TEST(StoredKey, FixScryptWithEmptySaltWithEncodedPrivateKey) {
     EXPECT_EQ(key.id.value(), "125a7e09-6671-4c15-8691-46e9095a78d6");
     EXPECT_EQ(key.name, "name");
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeBitcoin);
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeBitcoin);
 
     const auto jsonBefore = key.json();
     EXPECT_EQ(jsonBefore["crypto"]["cipher"], "aes-128-ctr");
@@ -613,9 +675,9 @@ TEST(StoredKey, FixScryptWithEmptySaltWithEncodedPrivateKey) {
     EXPECT_EQ(key.id.value(), "125a7e09-6671-4c15-8691-46e9095a78d6");
     EXPECT_EQ(key.name, "name");
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeBitcoin);
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeBitcoin);
 
     const auto jsonAfter = key.json();
     EXPECT_EQ(jsonAfter["crypto"]["cipher"], "aes-128-ctr");
@@ -680,9 +742,9 @@ TEST(StoredKey, FixPBKDF2WithEmptySalt) {
     EXPECT_FALSE(key.id.has_value());
     EXPECT_EQ(key.name, "name");
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, TWCoinTypeSmartChain);
-    EXPECT_EQ(key.accounts[0].derivationPath.string(), "m/44'/60'/0'/0/0");
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, TWCoinTypeSmartChain);
+    EXPECT_EQ(key.accounts()[0].derivationPath.string(), "m/44'/60'/0'/0/0");
 
     const auto jsonBefore = key.json();
     EXPECT_EQ(jsonBefore["crypto"]["kdfparams"]["salt"].get<std::string>(), "");
@@ -702,6 +764,46 @@ TEST(StoredKey, FixPBKDF2WithEmptySalt) {
     EXPECT_EQ(mnemonicAfter, mnemonicBefore);
 }
 
+TEST(StoredKey, ReencryptWithNewPassword) {
+    const auto privateKeyHex = "3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266";
+    const auto newPassword = TW::data("new password");
+    auto key = StoredKey::load(testDataPath("scrypt-empty-salt-encoded-private-key.json"));
+    const auto jsonBefore = key.json();
+
+    // Wrong password: the key is left unchanged.
+    EXPECT_THROW(key.reencrypt(newPassword, newPassword), DecryptionError);
+    EXPECT_EQ(key.json(), jsonBefore);
+
+    key.reencrypt(gPassword, newPassword);
+
+    EXPECT_EQ(key.id, "125a7e09-6671-4c15-8691-46e9095a78d6");
+    EXPECT_EQ(hex(key.payload.decrypt(newPassword)), privateKeyHex);
+    ASSERT_TRUE(key.encodedPayload.has_value());
+    EXPECT_NO_THROW(key.encodedPayload->decrypt(newPassword));
+    EXPECT_THROW(key.payload.decrypt(gPassword), DecryptionError);
+
+    // The Scrypt parameters are kept, with a new salt and IV.
+    const auto jsonAfter = key.json();
+    for (const auto* crypto : {"crypto", "encodedCrypto"}) {
+        EXPECT_EQ(jsonAfter[crypto]["cipher"], jsonBefore[crypto]["cipher"]);
+        EXPECT_EQ(jsonAfter[crypto]["kdfparams"]["n"], jsonBefore[crypto]["kdfparams"]["n"]);
+        EXPECT_EQ(jsonAfter[crypto]["kdfparams"]["salt"].get<std::string>().size(), 64ul);
+        EXPECT_NE(jsonAfter[crypto]["cipherparams"]["iv"], jsonBefore[crypto]["cipherparams"]["iv"]);
+    }
+}
+
+TEST(StoredKey, ReencryptPBKDF2WithEncryptionLevel) {
+    auto key = StoredKey::load(testDataPath("pbkdf2.json"));
+
+    key.reencrypt(TW::data("testpassword"), gPassword, TWStoredKeyEncryptionLevelMinimal);
+
+    const auto* scryptParams = std::get_if<ScryptParameters>(&key.payload.params.kdfParams);
+    ASSERT_NE(scryptParams, nullptr);
+    EXPECT_EQ(scryptParams->n, 4096ul);
+    EXPECT_EQ(scryptParams->p, 6ul);
+    EXPECT_EQ(hex(key.payload.decrypt(gPassword)), "7a28b5ba57c53603b0b07b56bba752f7784bf506fa95edc395f5cf6c7514fe9d");
+}
+
 TEST(StoredKey, MissingAddressFix) {
     auto key = StoredKey::load(testDataPath("missing-address.json"));
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
@@ -755,7 +857,7 @@ TEST(StoredKey, CreateMinimalEncryptionParameters) {
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
 
     const auto json = key.json();
@@ -774,7 +876,7 @@ TEST(StoredKey, CreateWeakEncryptionParameters) {
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
 
     const auto json = key.json();
@@ -793,7 +895,7 @@ TEST(StoredKey, CreateStandardEncryptionParameters) {
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
 
     const auto json = key.json();
@@ -823,7 +925,7 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
     const Data& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
-    EXPECT_EQ(key.accounts.size(), 0ul);
+    EXPECT_EQ(key.accounts().size(), 0ul);
 
     const auto expectedBtc1 = "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny";
     const auto expectedBtc2 = "1NyRyFewhZcWMa9XCj3bBxSXPXyoSg8dKz";
@@ -840,8 +942,8 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
         EXPECT_EQ(btc1->address, expectedBtc1);
         EXPECT_EQ(btc1->derivationPath.string(), "m/84'/0'/0'/0/0");
         EXPECT_EQ(btc1->extendedPublicKey, "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn");
-        EXPECT_EQ(key.accounts.size(), ++expectedAccounts);
-        EXPECT_EQ(key.accounts[expectedAccounts - 1].address, expectedBtc1);
+        EXPECT_EQ(key.accounts().size(), ++expectedAccounts);
+        EXPECT_EQ(key.accounts()[expectedAccounts - 1].address, expectedBtc1);
         EXPECT_EQ(key.account(coin)->address, expectedBtc1);
         EXPECT_EQ(key.getAccounts(coin).size(), 1ul);
         EXPECT_EQ(key.getAccounts(coin)[0].address, expectedBtc1);
@@ -854,8 +956,8 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
         EXPECT_TRUE(sol1.has_value());
         EXPECT_EQ(sol1->address, expectedSol1);
         EXPECT_EQ(sol1->derivationPath.string(), "m/44'/501'/0'");
-        EXPECT_EQ(key.accounts.size(), ++expectedAccounts);
-        EXPECT_EQ(key.accounts[expectedAccounts - 1].address, expectedSol1);
+        EXPECT_EQ(key.accounts().size(), ++expectedAccounts);
+        EXPECT_EQ(key.accounts()[expectedAccounts - 1].address, expectedSol1);
         EXPECT_EQ(key.account(coin)->address, expectedSol1);
         EXPECT_EQ(key.getAccounts(coin).size(), 1ul);
         EXPECT_EQ(key.getAccounts(coin)[0].address, expectedSol1);
@@ -868,8 +970,8 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
         EXPECT_EQ(btc2.address, expectedBtc2);
         EXPECT_EQ(btc2.derivationPath.string(), "m/44'/0'/0'/0/0");
         EXPECT_EQ(btc2.extendedPublicKey, "xpub6CR52eaUuVb4kXAVyHC2i5ZuqJ37oWNPZFtjXaazFPXZD45DwWBYEBLdrF7fmCR9pgBuCA9Q57zZfyJjDUBDNtWkhWuGHNYKLgDHpqrHsxV");
-        EXPECT_EQ(key.accounts.size(), ++expectedAccounts);
-        EXPECT_EQ(key.accounts[expectedAccounts - 1].address, expectedBtc2);
+        EXPECT_EQ(key.accounts().size(), ++expectedAccounts);
+        EXPECT_EQ(key.accounts()[expectedAccounts - 1].address, expectedBtc2);
         EXPECT_EQ(key.account(coin)->address, expectedBtc1);
         EXPECT_EQ(key.account(coin, TWDerivationBitcoinLegacy, wallet).address, expectedBtc2);
         EXPECT_EQ(key.getAccounts(coin).size(), 2ul);
@@ -884,8 +986,8 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
         const auto expectedSol2 = "CgWJeEWkiYqosy1ba7a3wn9HAQuHyK48xs3LM4SSDc1C";
         EXPECT_EQ(sol2.address, expectedSol2);
         EXPECT_EQ(sol2.derivationPath.string(), "m/44'/501'/0'/0'");
-        EXPECT_EQ(key.accounts.size(), ++expectedAccounts);
-        EXPECT_EQ(key.accounts[expectedAccounts - 1].address, expectedSol2);
+        EXPECT_EQ(key.accounts().size(), ++expectedAccounts);
+        EXPECT_EQ(key.accounts()[expectedAccounts - 1].address, expectedSol2);
         // Now we have 2 Solana addresses, 1st is returned here
         EXPECT_EQ(key.account(coin)->address, expectedSol1);
         EXPECT_EQ(key.account(coin, TWDerivationSolanaSolana, wallet).address, expectedSol2);
@@ -907,8 +1009,8 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
 
         key.addAccount(p2pkhBtcAddress, coin, TWDerivationCustom, customPath, hex(btcPublicKey.bytes), extendedPublicKey);
 
-        EXPECT_EQ(key.accounts.size(), ++expectedAccounts);
-        EXPECT_EQ(key.accounts[expectedAccounts - 1].address, expectedBtc3);
+        EXPECT_EQ(key.accounts().size(), ++expectedAccounts);
+        EXPECT_EQ(key.accounts()[expectedAccounts - 1].address, expectedBtc3);
         // Now we have 2 Bitcoin addresses, 1st is returned here
         EXPECT_EQ(key.account(coin)->address, expectedBtc1);
         EXPECT_EQ(key.getAccounts(coin).size(), 3ul);
@@ -934,7 +1036,7 @@ TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts from the same wallet
         EXPECT_EQ(pactusTestnet.derivationPath.string(), "m/44'/21777'/3'/0'");
 
         expectedAccounts += 2;
-        EXPECT_EQ(key.accounts.size(), expectedAccounts);
+        EXPECT_EQ(key.accounts().size(), expectedAccounts);
 
         EXPECT_EQ(key.account(coin)->address, expectedMainnetAddr);
         EXPECT_EQ(key.account(coin, TWDerivationPactusMainnet, wallet).address, expectedMainnetAddr);
@@ -950,9 +1052,9 @@ TEST(StoredKey, CreateWithEncodedPrivateKeyAddDefaultAddress) {
     auto key = StoredKey::createWithEncodedPrivateKeyAddDefaultAddress("name", gPassword, coinTypeBc, privateKeyHex);
 
     EXPECT_EQ(key.type, StoredKeyType::privateKey);
-    EXPECT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coinTypeBc);
-    EXPECT_EQ(key.accounts[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
+    EXPECT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coinTypeBc);
+    EXPECT_EQ(key.accounts()[0].address, "bc1q375sq4kl2nv0mlmup3vm8znn4eqwu7mt6hkwhr");
 
     // Verify that the raw private key bytes can be decrypted from `payload`
     const Data& decryptedKey = key.payload.decrypt(gPassword);
@@ -993,21 +1095,21 @@ TEST(StoredKey, CreateWithMnemonicAlternativeDerivation) {
     auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", gPassword, gMnemonic, coin);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
 
-    ASSERT_EQ(key.accounts.size(), 1ul);
-    EXPECT_EQ(key.accounts[0].coin, coin);
-    EXPECT_EQ(key.accounts[0].address, "HiipoCKL8hX2RVmJTz3vaLy34hS2zLhWWMkUWtw85TmZ");
-    EXPECT_EQ(key.accounts[0].publicKey, "f86b18399096c8134dd185f1e72dd7e26528772a2a998abfd81c5f8c547223d0");
+    ASSERT_EQ(key.accounts().size(), 1ul);
+    EXPECT_EQ(key.accounts()[0].coin, coin);
+    EXPECT_EQ(key.accounts()[0].address, "HiipoCKL8hX2RVmJTz3vaLy34hS2zLhWWMkUWtw85TmZ");
+    EXPECT_EQ(key.accounts()[0].publicKey, "f86b18399096c8134dd185f1e72dd7e26528772a2a998abfd81c5f8c547223d0");
     EXPECT_EQ(hex(key.privateKey(coin, gPassword).bytes), "d81b5c525979e487736b69cb84ed8331559de17294f38491b304555c26687e83");
     EXPECT_EQ(hex(key.privateKey(coin, TWDerivationDefault, gPassword).bytes), "d81b5c525979e487736b69cb84ed8331559de17294f38491b304555c26687e83");
-    ASSERT_EQ(key.accounts.size(), 1ul);
+    ASSERT_EQ(key.accounts().size(), 1ul);
 
     // alternative derivation, different keys
     EXPECT_EQ(hex(key.privateKey(coin, TWDerivationSolanaSolana, gPassword).bytes), "d49a5fa7f77593534c7afd2ba8dc8e9d8b007bc6ec65fe8df25ffe6fafc57151");
 
-    ASSERT_EQ(key.accounts.size(), 2ul);
-    EXPECT_EQ(key.accounts[1].coin, coin);
-    EXPECT_EQ(key.accounts[1].address, "CgWJeEWkiYqosy1ba7a3wn9HAQuHyK48xs3LM4SSDc1C");
-    EXPECT_EQ(key.accounts[1].publicKey, "ad8f57924dce62f9040f93b4f6ce3c3d39afde7e29bcb4013dad59db7913c4c7");
+    ASSERT_EQ(key.accounts().size(), 2ul);
+    EXPECT_EQ(key.accounts()[1].coin, coin);
+    EXPECT_EQ(key.accounts()[1].address, "CgWJeEWkiYqosy1ba7a3wn9HAQuHyK48xs3LM4SSDc1C");
+    EXPECT_EQ(key.accounts()[1].publicKey, "ad8f57924dce62f9040f93b4f6ce3c3d39afde7e29bcb4013dad59db7913c4c7");
     EXPECT_EQ(hex(key.privateKey(coin, TWDerivationSolanaSolana, gPassword).bytes), "d49a5fa7f77593534c7afd2ba8dc8e9d8b007bc6ec65fe8df25ffe6fafc57151");
 }
 
@@ -1125,4 +1227,84 @@ TEST(StoredKey, ParseMissingFields) {
     }
 }
 
+TEST(StoredKey, LoadFromBufferSameAsJson) {
+    const auto directory = std::filesystem::path(testDataPath(""));
+    for (const auto& path : {directory, directory / "BackwardCompatibility"}) {
+        for (const auto& file : std::filesystem::directory_iterator(path)) {
+            if (!file.is_regular_file()) {
+                continue;
+            }
+            SCOPED_TRACE(file.path().string());
+            std::ifstream stream(file.path());
+            std::stringstream contents;
+            contents << stream.rdbuf();
+            const auto buffer = contents.str();
+
+            std::optional<nlohmann::json> expected;
+            try {
+                expected = StoredKey::createWithJson(nlohmann::json::parse(buffer)).json();
+            } catch (...) {
+            }
+            if (!expected) {
+                EXPECT_ANY_THROW(StoredKey::loadFromBuffer(buffer));
+                continue;
+            }
+            const auto key = StoredKey::loadFromBuffer(buffer);
+            EXPECT_EQ(key.json(), *expected);
+            EXPECT_EQ(StoredKey::load(file.path().string()).json(), *expected);
+        }
+    }
+}
+
+TEST(StoredKey, LoadFromBufferStandardFormat) {
+    for (const auto* name : {"key.json", "wallet.json", "pbkdf2.json", "scrypt-without-salt.json", "myetherwallet.uu"}) {
+        SCOPED_TRACE(name);
+        std::ifstream stream(testDataPath(name));
+        std::stringstream contents;
+        contents << stream.rdbuf();
+        auto key = StoredKey::load(testDataPath("key.json"));
+        EXPECT_TRUE(readStoredKeyJson(contents.str(), key));
+    }
+
+    const auto buffer = StoredKey::load(testDataPath("wallet.json")).json().dump();
+    // Left to the JSON document: legacy derivation path, duplicate keys, unexpected types, malformed JSON
+    for (const auto& json : {
+             std::string(R"({"crypto":{},"activeAccounts":[{"derivationPath":{"indices":[]}}]})"),
+             buffer.substr(0, buffer.size() - 1) + R"(,"name":"again"})",
+             buffer.substr(0, buffer.size() - 1) + R"(,"name":1})",
+             buffer.substr(0, buffer.size() - 1),
+         }) {
+        auto key = StoredKey::load(testDataPath("key.json"));
+        EXPECT_FALSE(readStoredKeyJson(json, key));
+    }
+
+    // Duplicate keys: the last one wins, like in the JSON document
+    EXPECT_EQ(StoredKey::loadFromBuffer(buffer.substr(0, buffer.size() - 1) + R"(,"name":"again"})").name, "again");
+    // Content after the JSON is ignored, like when reading a file stream
+    EXPECT_EQ(StoredKey::loadFromBuffer(buffer + "\n}").json().dump(), buffer);
+    EXPECT_THROW(StoredKey::loadFromBuffer(buffer.substr(0, buffer.size() - 1)), nlohmann::json::parse_error);
+    EXPECT_THROW(StoredKey::loadFromBuffer(R"({"name":"no crypto"})"), DecryptionError);
+}
+
+TEST(StoredKey, StoreToBufferSameAsJson) {
+    auto key = StoredKey::load(testDataPath("scrypt-empty-salt-encoded-private-key.json"));
+    key.name = "quote \" backslash \\ control \b\f\n\r\t\x01\x1f\x7f unicode \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+    key.addAccount("address", TWCoinTypeBitcoin, TWDerivationBitcoinLegacy, DerivationPath("m/44'/0'/0'/0/0"), "", "xpub");
+
+    std::string buffer = "previous contents";
+    key.storeToBuffer(buffer);
+    EXPECT_EQ(buffer, key.json().dump());
+    EXPECT_EQ(StoredKey::loadFromBuffer(buffer).json(), key.json());
+
+    const auto pbkdf2 = StoredKey::load(testDataPath("pbkdf2.json"));
+    pbkdf2.storeToBuffer(buffer);
+    EXPECT_EQ(buffer, pbkdf2.json().dump());
+
+    for (const auto* invalid : {"\xc3", "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff"}) {
+        key.name = invalid;
+        EXPECT_THROW(key.json().dump(), nlohmann::json::type_error);
+        EXPECT_THROW(key.storeToBuffer(buffer), nlohmann::json::type_error);
+    }
+}
+
 } // namespace TW::Keystore
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Keystore/WalletFactory.h"
+#include "Mnemonic.h"
+#include "TestUtilities.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <set>
+
+namespace TW::Keystore::tests {
+
+const auto gName = "name";
+const auto gPassword = TW::data("password");
+
+WalletFactory::Options minimalOptions() {
+    WalletFactory::Options options;
+    options.name = gName;
+    options.password = gPassword;
+    options.encryptionLevel = TWStoredKeyEncryptionLevelMinimal;
+    return options;
+}
+
+TEST(WalletFactory, Generate) {
+    const std::vector<TWCoinType> coins = {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeBitcoin, TWCoinTypeSolana};
+    const std::vector<TWDerivation> derivations = {TWDerivationDefault, TWDerivationDefault, TWDerivationBitcoinLegacy, TWDerivationDefault};
+    std::vector<std::optional<StoredKey>> keys(8);
+
+    WalletFactory::generate(keys.size(), coins, derivations, minimalOptions(), [&keys](std::size_t index, StoredKey&& key) {
+        keys.at(index) = std::move(key);
+    });
+
+    std::set<std::string> mnemonics;
+    for (auto& key : keys) {
+        ASSERT_TRUE(key.has_value());
+        EXPECT_EQ(key->name, gName);
+        EXPECT_EQ(key->type, StoredKeyType::mnemonicPhrase);
+        EXPECT_EQ(std::get<ScryptParameters>(key->payload.params.kdfParams).n, 4096ul);
+
+        const auto wallet = key->wallet(gPassword);
+        EXPECT_TRUE(Mnemonic::isValid(wallet.getMnemonic()));
+        mnemonics.insert(wallet.getMnemonic());
+
+        auto reference = StoredKey::createWithMnemonic(gName, gPassword, wallet.getMnemonic(), TWStoredKeyEncryptionLevelMinimal);
+        ASSERT_EQ(key->accounts().size(), coins.size());
+        for (auto i = 0ul; i < coins.size(); ++i) {
+            const auto& account = key->accounts()[i];
+            const auto expected = reference.account(coins[i], derivations[i], wallet);
+            EXPECT_EQ(account.coin, expected.coin);
+            EXPECT_EQ(account.derivation, expected.derivation);
+            EXPECT_EQ(account.derivationPath.string(), expected.derivationPath.string());
+            EXPECT_EQ(account.address, expected.address);
+            EXPECT_EQ(account.publicKey, expected.publicKey);
+            EXPECT_EQ(account.extendedPublicKey, expected.extendedPublicKey);
+        }
+    }
+    EXPECT_EQ(mnemonics.size(), keys.size());
+}
+
+TEST(WalletFactory, GenerateDefaultDerivations) {
+    auto options = minimalOptions();
+    options.strength = 256;
+    // A tiny budget encrypts the mnemonics one at a time.
+    options.memoryBudget = 1;
+    std::size_t count = 0;
+
+    WalletFactory::generate(2, {TWCoinTypeBitcoin}, {}, options, [&count](std::size_t, StoredKey&& key) {
+        ++count;
+        EXPECT_EQ(key.wallet(gPassword).getEntropy().size(), 32ul);
+        ASSERT_EQ(key.accounts().size(), 1ul);
+        EXPECT_EQ(key.accounts()[0].derivation, TWDerivationDefault);
+        EXPECT_EQ(key.accounts()[0].derivationPath.string(), "m/84'/0'/0'/0/0");
+    });
+
+    EXPECT_EQ(count, 2ul);
+}
+
+TEST(WalletFactory, GenerateInvalid) {
+    const auto sink = [](std::size_t, StoredKey&&) { FAIL(); };
+    auto options = minimalOptions();
+    options.strength = 129;
+    EXPECT_EXCEPTION(WalletFactory::generate(1, {TWCoinTypeBitcoin}, {}, options, sink), "Invalid strength");
+    EXPECT_EXCEPTION(WalletFactory::generate(1, {TWCoinTypeBitcoin}, {TWDerivationDefault, TWDerivationDefault}, minimalOptions(), sink),
+                     "Derivations do not match coins");
+}
+
+TEST(WalletFactory, SinkException) {
+    std::size_t count = 0;
+    EXPECT_EXCEPTION(WalletFactory::generate(64, {TWCoinTypeEthereum}, {}, minimalOptions(), [&count](std::size_t, StoredKey&&) {
+        ++count;
+        throw std::runtime_error("Sink failed");
+    }), "Sink failed");
+    EXPECT_EQ(count, 1ul);
+}
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=WalletFactory.DISABLED_Benchmark
+TEST(WalletFactory, DISABLED_Benchmark) {
+    const std::vector<TWCoinType> coins = {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeSolana};
+    const std::size_t count = 10000;
+    std::size_t generated = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    WalletFactory::generate(count, coins, {}, minimalOptions(), [&generated](std::size_t, StoredKey&&) { ++generated; });
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(generated, count);
+    std::cout << count << " wallets in " << elapsed << " s, " << count / elapsed << " wallets/s" << std::endl;
+}
+
+} // namespace TW::Keystore::tests
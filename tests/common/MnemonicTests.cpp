@@ -3,6 +3,9 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "Mnemonic.h"
+#include "MnemonicWordlist.h"
+
+#include <TrezorCrypto/bip39.h>
 
 #include <gtest/gtest.h>
 
@@ -94,4 +97,42 @@ TEST(Mnemonic, suggest) {
     EXPECT_EQ(Mnemonic::suggest("program"), "program");
 }
 
+TEST(MnemonicWordlist, English) {
+    constexpr MnemonicWordlist<BIP39_WORD_COUNT> english({
+#include <TrezorCrypto/bip39_english_words.inc>
+    });
+    static_assert(english.find("abandon") == 0);
+    static_assert(english.find("zoo") == 2047);
+
+    for (auto index = 0; index < BIP39_WORD_COUNT; ++index) {
+        const auto word = english[index];
+        EXPECT_EQ(word, mnemonic_get_word(index));
+        EXPECT_EQ(english.find(word), index);
+        EXPECT_TRUE(english.contains(word));
+    }
+    for (const auto word : {"", "a", "abando", "abandons", "CREDIT", "credit ", "zooo", "hybridous"}) {
+        EXPECT_EQ(english.find(word), -1) << word;
+        EXPECT_FALSE(english.contains(word)) << word;
+    }
+
+    EXPECT_EQ(english.prefixRange("rob"), std::make_pair(std::size_t(1497), std::size_t(1499)));
+    EXPECT_EQ(english.prefixRange("zoo"), std::make_pair(std::size_t(2047), std::size_t(2048)));
+    EXPECT_EQ(english.prefixRange("saos").first, english.prefixRange("saos").second);
+    EXPECT_EQ(english.prefixRange(""), std::make_pair(std::size_t(0), std::size_t(2048)));
+}
+
+TEST(MnemonicWordlist, Custom) {
+    constexpr MnemonicWordlist<4> wordlist({"alpha", "beta", "betamax", "gamma"});
+    static_assert(wordlist.find("betamax") == 2);
+
+    EXPECT_TRUE(wordlist.contains("beta"));
+    EXPECT_FALSE(wordlist.contains("delta"));
+    EXPECT_EQ(wordlist.prefixRange("bet"), std::make_pair(std::size_t(1), std::size_t(3)));
+
+    using Wordlist = MnemonicWordlist<3>;
+    EXPECT_THROW(Wordlist({"beta", "alpha", "gamma"}), std::invalid_argument);
+    EXPECT_THROW(Wordlist({"alpha", "alpha", "gamma"}), std::invalid_argument);
+    EXPECT_THROW(Wordlist({"alpha", "beta"}), std::invalid_argument);
+}
+
 } // namespace
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "WorkerPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+
+namespace TW::tests {
+
+TEST(WorkerPool, ParallelForVisitsEveryIndexOnce) {
+    WorkerPool pool(4);
+    std::vector<int> visits(1000, 0);
+    pool.parallelFor(visits.size(), [&](std::size_t i) { visits[i] += 1; });
+    EXPECT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 1000);
+    for (const auto visit : visits) {
+        EXPECT_EQ(visit, 1);
+    }
+}
+
+TEST(WorkerPool, ParallelForEmptyAndSingle) {
+    WorkerPool pool(2);
+    std::atomic<int> calls{0};
+    pool.parallelFor(0, [&](std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+    pool.parallelFor(1, [&](std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(WorkerPool, NestedParallelFor) {
+    WorkerPool pool(2);
+    std::atomic<int> calls{0};
+    pool.parallelFor(8, [&](std::size_t) {
+        pool.parallelFor(8, [&](std::size_t) { ++calls; });
+    });
+    EXPECT_EQ(calls, 64);
+}
+
+TEST(WorkerPool, SubmitBlocksOnFullQueue) {
+    std::atomic<int> calls{0};
+    {
+        WorkerPool pool(1, 1);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] { ++calls; });
+        }
+        // Pending tasks are drained on destruction.
+    }
+    EXPECT_EQ(calls, 100);
+}
+
+TEST(WorkerPool, SharedConcurrency) {
+    WorkerPool::setSharedConcurrency(3);
+    EXPECT_EQ(WorkerPool::shared()->size(), 3ul);
+    WorkerPool::setSharedConcurrency(0);
+    EXPECT_GE(WorkerPool::shared()->size(), 1ul);
+}
+
+} // namespace TW::tests
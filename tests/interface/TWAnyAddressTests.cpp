@@ -23,6 +23,17 @@ TEST(TWAnyAddress, InvalidString) {
     ASSERT_EQ(TWAnyAddressCoin(ethAaddress.get()), TWCoinTypeEthereum);
 }
 
+TEST(TWAnyAddress, DetectCoins) {
+    const auto cosmos = WRAPD(TWAnyAddressDetectCoins(STRING("cosmos1hkfq3zahaqkkzx5mjnamwjsfpq2jk7z0emlrvp").get()));
+    assertHexEqual(cosmos, "76000000");
+
+    const auto bitcoin = WRAPD(TWAnyAddressDetectCoins(STRING("bc1q2ddhp55sq2l4xnqhpdv0xazg02v9dr7uu8c2p2").get()));
+    assertHexEqual(bitcoin, "00000000");
+
+    const auto none = WRAPD(TWAnyAddressDetectCoins(STRING("not an address").get()));
+    assertHexEqual(none, "");
+}
+
 TEST(TWAnyAddress, Data) {
     // ethereum
     {
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "TestUtilities.h"
+
+#include <TrustWalletCore/TWStoredKey.h>
+#include <TrustWalletCore/TWStoredKeyDirectory.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+extern std::string TESTS_ROOT;
+
+namespace fs = std::filesystem;
+
+TEST(TWStoredKeyDirectory, StoreFindLoadRemove) {
+    const auto directory = fs::temp_directory_path() / "TWStoredKeyDirectoryTests";
+    fs::remove_all(directory);
+
+    const auto keys = WRAP(TWStoredKeyDirectory, TWStoredKeyDirectoryCreate(STRING(directory.string().c_str()).get()));
+    ASSERT_NE(keys, nullptr);
+    EXPECT_EQ(TWStoredKeyDirectoryKeyCount(keys.get()), 0ul);
+    EXPECT_EQ(TWStoredKeyDirectoryIdentifier(keys.get(), 0), nullptr);
+
+    const auto key = WRAP(TWStoredKey, TWStoredKeyLoad(STRING((TESTS_ROOT + "/common/Keystore/Data/key.json").c_str()).get()));
+    ASSERT_NE(key, nullptr);
+    EXPECT_TRUE(TWStoredKeyDirectoryStore(keys.get(), key.get()));
+    EXPECT_EQ(TWStoredKeyDirectoryKeyCount(keys.get()), 1ul);
+
+    const auto id = WRAPS(TWStoredKeyDirectoryIdentifier(keys.get(), 0));
+    assertStringsEqual(id, "e13b209c-3b2f-4327-bab0-3bef2e51630d");
+    assertStringsEqual(WRAPS(TWStoredKeyDirectoryName(keys.get(), id.get())), "Test Account");
+    assertStringsEqual(WRAPS(TWStoredKeyDirectoryFindKey(keys.get(), TWCoinTypeEthereum, STRING("0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b").get())), "e13b209c-3b2f-4327-bab0-3bef2e51630d");
+    EXPECT_EQ(TWStoredKeyDirectoryFindKey(keys.get(), TWCoinTypeEthereum, STRING("0x0000000000000000000000000000000000000000").get()), nullptr);
+
+    const auto loaded = WRAP(TWStoredKey, TWStoredKeyDirectoryLoad(keys.get(), id.get()));
+    ASSERT_NE(loaded, nullptr);
+    assertStringsEqual(WRAPS(TWStoredKeyIdentifier(loaded.get())), "e13b209c-3b2f-4327-bab0-3bef2e51630d");
+
+    // Another process adds a key file.
+    fs::copy_file(TESTS_ROOT + "/common/Keystore/Data/wallet.json", directory / "wallet.json");
+    EXPECT_TRUE(TWStoredKeyDirectoryRefresh(keys.get()));
+    EXPECT_EQ(TWStoredKeyDirectoryKeyCount(keys.get()), 2ul);
+    EXPECT_FALSE(TWStoredKeyDirectoryRefresh(keys.get()));
+
+    EXPECT_TRUE(TWStoredKeyDirectoryRemove(keys.get(), id.get()));
+    EXPECT_FALSE(TWStoredKeyDirectoryRemove(keys.get(), id.get()));
+    EXPECT_EQ(TWStoredKeyDirectoryLoad(keys.get(), id.get()), nullptr);
+    EXPECT_EQ(TWStoredKeyDirectoryKeyCount(keys.get()), 1ul);
+
+    fs::remove_all(directory);
+}
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+// Concurrent stress tests for the C interface.
+// Every thread repeats the same calls and compares the results with ones computed up front on a single thread.
+// Build with `-DTW_CLANG_TSAN=ON` (see `tools/tsan-test`) to have data races reported.
+
+#include "TestUtilities.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Binance.pb.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWAnyAddress.h>
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWHDWallet.h>
+#include <TrustWalletCore/TWMnemonic.h>
+#include <TrustWalletCore/TWPrivateKey.h>
+#include <TrustWalletCore/TWPublicKey.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace TW::ThreadSafetyTests {
+
+constexpr std::size_t gThreads = 8;
+constexpr std::size_t gIterations = 20;
+
+const auto gMnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+const std::vector<TWCoinType> gCoins = {
+    TWCoinTypeBitcoin,
+    TWCoinTypeEthereum,
+    TWCoinTypeBinance,
+    TWCoinTypeCosmos,
+    TWCoinTypeSolana,
+    TWCoinTypeCardano,
+    TWCoinTypePolkadot,
+    TWCoinTypeTron,
+    TWCoinTypeTON,
+    TWCoinTypeAptos,
+};
+
+/// Runs `fn` on `gThreads` threads at once, `gIterations` times each, and returns the number of failed calls.
+std::size_t runConcurrently(const std::function<bool()>& fn) {
+    std::atomic<std::size_t> failures{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(gThreads);
+    for (std::size_t t = 0; t < gThreads; ++t) {
+        threads.emplace_back([&] {
+            while (!start) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < gIterations; ++i) {
+                if (!fn()) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    start = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failures;
+}
+
+std::string addressForCoin(TWHDWallet* wallet, TWCoinType coin) {
+    const auto address = WRAPS(TWHDWalletGetAddressForCoin(wallet, coin));
+    return TWStringUTF8Bytes(address.get());
+}
+
+Data ethereumSigningInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    auto& transfer = *input.mutable_transaction()->mutable_transfer();
+    transfer.set_amount(amount.data(), amount.size());
+    return data(input.SerializeAsString());
+}
+
+Data binanceSigningInput() {
+    Binance::Proto::SigningInput input;
+    input.set_chain_id("chain-bnb");
+    input.set_account_number(19);
+    input.set_sequence(23);
+    input.set_memo("test");
+    const auto key = parse_hex("95949f757db1f57ca94a5dff23314accbe7abee89597bf6a3c7382c84d7eb832");
+    input.set_private_key(key.data(), key.size());
+
+    const auto fromAddress = parse_hex("40c2979694bbc961023d1d27be6fc4d21a9febe6");
+    const auto toAddress = parse_hex("88b37d5e05f3699e2a1406468e5d87cb9dcceb95");
+    auto& order = *input.mutable_send_order();
+    auto& orderInput = *order.add_inputs();
+    orderInput.set_address(fromAddress.data(), fromAddress.size());
+    auto& inputCoin = *orderInput.add_coins();
+    inputCoin.set_denom("BNB");
+    inputCoin.set_amount(1'001'000'000);
+    auto& orderOutput = *order.add_outputs();
+    orderOutput.set_address(toAddress.data(), toAddress.size());
+    auto& outputCoin = *orderOutput.add_coins();
+    outputCoin.set_denom("BNB");
+    outputCoin.set_amount(1'001'000'000);
+    return data(input.SerializeAsString());
+}
+
+Data anySign(const Data& input, TWCoinType coin) {
+    const auto inputData = WRAPD(TWDataCreateWithBytes(input.data(), input.size()));
+    const auto output = WRAPD(TWAnySignerSign(inputData.get(), coin));
+    return data(TWDataBytes(output.get()), TWDataSize(output.get()));
+}
+
+TEST(ThreadSafety, DeriveAddressesFromSharedWallet) {
+    const auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get()));
+    std::map<TWCoinType, std::string> expected;
+    for (const auto coin : gCoins) {
+        expected[coin] = addressForCoin(wallet.get(), coin);
+    }
+
+    const auto failures = runConcurrently([&] {
+        bool ok = true;
+        for (const auto coin : gCoins) {
+            ok = ok && addressForCoin(wallet.get(), coin) == expected[coin];
+        }
+        return ok;
+    });
+    EXPECT_EQ(failures, 0ul);
+}
+
+TEST(ThreadSafety, WalletPerThread) {
+    const auto reference = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get()));
+    const auto expected = addressForCoin(reference.get(), TWCoinTypeEthereum);
+
+    const auto failures = runConcurrently([&] {
+        const auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get()));
+        return TWMnemonicIsValid(STRING(gMnemonic).get()) && addressForCoin(wallet.get(), TWCoinTypeEthereum) == expected;
+    });
+    EXPECT_EQ(failures, 0ul);
+}
+
+TEST(ThreadSafety, ValidateAndParseAddresses) {
+    const auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get()));
+    std::map<TWCoinType, std::string> addresses;
+    for (const auto coin : gCoins) {
+        addresses[coin] = addressForCoin(wallet.get(), coin);
+    }
+
+    const auto failures = runConcurrently([&] {
+        bool ok = true;
+        for (const auto& [coin, address] : addresses) {
+            const auto string = STRING(address.c_str());
+            ok = ok && TWAnyAddressIsValid(string.get(), coin);
+            const auto anyAddress = WRAP(TWAnyAddress, TWAnyAddressCreateWithString(string.get(), coin));
+            ok = ok && anyAddress && TWStringUTF8Bytes(WRAPS(TWAnyAddressDescription(anyAddress.get())).get()) == address;
+        }
+        return ok;
+    });
+    EXPECT_EQ(failures, 0ul);
+}
+
+TEST(ThreadSafety, AnySignerSign) {
+    // Ethereum is signed in Rust, Binance in C++.
+    const auto ethereumInput = ethereumSigningInput();
+    const auto binanceInput = binanceSigningInput();
+    const auto ethereumOutput = anySign(ethereumInput, TWCoinTypeEthereum);
+    const auto binanceOutput = anySign(binanceInput, TWCoinTypeBinance);
+    ASSERT_FALSE(ethereumOutput.empty());
+    ASSERT_FALSE(binanceOutput.empty());
+
+    const auto failures = runConcurrently([&] {
+        return anySign(ethereumInput, TWCoinTypeEthereum) == ethereumOutput &&
+               anySign(binanceInput, TWCoinTypeBinance) == binanceOutput;
+    });
+    EXPECT_EQ(failures, 0ul);
+}
+
+TEST(ThreadSafety, GenerateKeysAndSign) {
+    const auto digest = DATA("0000000000000000000000000000000000000000000000000000000000000001");
+
+    const auto failures = runConcurrently([&] {
+        // Uses the system random source from every thread.
+        const auto privateKey = WRAP(TWPrivateKey, TWPrivateKeyCreate());
+        const auto publicKey = WRAP(TWPublicKey, TWPrivateKeyGetPublicKeySecp256k1(privateKey.get(), true));
+        const auto signature = WRAPD(TWPrivateKeySign(privateKey.get(), digest.get(), TWCurveSECP256k1));
+        return signature && TWPublicKeyVerify(publicKey.get(), signature.get(), digest.get());
+    });
+    EXPECT_EQ(failures, 0ul);
+}
+
+} // namespace TW::ThreadSafetyTests
@@ -12,6 +12,7 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWData.h>
 #include <TrustWalletCore/TWTransactionCompiler.h>
+#include <TrustWalletCore/TWTransactionCompilerBatch.h>
 
 #include "Bitcoin/Script.h"
 #include "Bitcoin/SegwitAddress.h"
@@ -791,3 +792,70 @@ TEST(TWTransactionCompiler, ExternalSignatureSignNULSToken) {
         ASSERT_EQ(output.encoded(), ExpectedTx);
     }
 }
+
+TEST(TWTransactionCompiler, BatchBinance) {
+    const auto coin = TWCoinTypeBinance;
+    const auto fromAddressData = parse_hex("40c2979694bbc961023d1d27be6fc4d21a9febe6");
+    const auto toAddressData = parse_hex("bffe47abfaede50419c577f1074fee6dd1535cd1");
+
+    Binance::Proto::SigningInput txInput;
+    txInput.set_chain_id("Binance-Chain-Nile");
+    auto& sendOrder = *txInput.mutable_send_order();
+    auto& input1 = *sendOrder.add_inputs();
+    input1.set_address(fromAddressData.data(), fromAddressData.size());
+    auto& input1Coin = *input1.add_coins();
+    input1Coin.set_amount(1);
+    input1Coin.set_denom("BNB");
+    auto& output1 = *sendOrder.add_outputs();
+    output1.set_address(toAddressData.data(), toAddressData.size());
+    auto& output1Coin = *output1.add_coins();
+    output1Coin.set_amount(1);
+    output1Coin.set_denom("BNB");
+
+    const auto txInputData = data(txInput.SerializeAsString());
+    auto txInputDataPtr = WRAPD(TWDataCreateWithBytes(txInputData.data(), txInputData.size()));
+    auto txInputs = WRAP(TWDataVector, TWDataVectorCreateWithData(txInputDataPtr.get()));
+    TWDataVectorAdd(txInputs.get(), txInputDataPtr.get());
+
+    auto batch = WRAP(TWTransactionCompilerBatch, TWTransactionCompilerBatchCreate(coin, txInputs.get()));
+    ASSERT_EQ(TWTransactionCompilerBatchSize(batch.get()), 2ul);
+
+    auto preImageHashes = WRAP(TWDataVector, TWTransactionCompilerBatchPreImageHashes(batch.get()));
+    ASSERT_EQ(TWDataVectorSize(preImageHashes.get()), 2ul);
+    for (size_t i = 0; i < 2; ++i) {
+        auto preImageHash = WRAPD(TWDataVectorGet(preImageHashes.get(), i));
+        TxCompiler::Proto::PreSigningOutput preSigningOutput;
+        ASSERT_TRUE(preSigningOutput.ParseFromArray(TWDataBytes(preImageHash.get()), int(TWDataSize(preImageHash.get()))));
+        ASSERT_EQ(preSigningOutput.error(), Common::Proto::OK);
+        EXPECT_EQ(hex(preSigningOutput.data_hash()), "3f3fece9059e714d303a9a1496ddade8f2c38fa78fc4cc2e505c5dbb0ea678d1");
+    }
+
+    const auto publicKeyData = DATA("026a35920088d98c3888ca68c53dfc93f4564602606cbb87f0fe5ee533db38e502");
+    const auto signature = DATA("1b1181faec30b60a2ddaa2804c253cf264c69180ec31814929b5de62088c0c5a45e8a816d1208fc5366bb8b041781a6771248550d04094c3d7a504f9e8310679");
+    auto signatures = WRAP(TWDataVector, TWDataVectorCreateWithData(signature.get()));
+    auto publicKeys = WRAP(TWDataVector, TWDataVectorCreateWithData(publicKeyData.get()));
+    EXPECT_TRUE(TWTransactionCompilerBatchSetSignatures(batch.get(), 0, signatures.get(), publicKeys.get()));
+    EXPECT_FALSE(TWTransactionCompilerBatchSetSignatures(batch.get(), 2, signatures.get(), publicKeys.get()));
+
+    auto outputs = WRAP(TWDataVector, TWTransactionCompilerBatchCompile(batch.get()));
+    ASSERT_EQ(TWDataVectorSize(outputs.get()), 2ul);
+    {
+        auto outputData = WRAPD(TWDataVectorGet(outputs.get(), 0));
+        Binance::Proto::SigningOutput output;
+        ASSERT_TRUE(output.ParseFromArray(TWDataBytes(outputData.get()), (int)TWDataSize(outputData.get())));
+        EXPECT_EQ(hex(output.encoded()),
+                  "b801f0625dee0a462a2c87fa0a1f0a1440c2979694bbc961023d1d27be6fc4d21a9febe612070a03424e421001"
+                  "121f0a14bffe47abfaede50419c577f1074fee6dd1535cd112070a03424e421001126a0a26eb5ae98721026a35"
+                  "920088d98c3888ca68c53dfc93f4564602606cbb87f0fe5ee533db38e50212401b1181faec30b60a2ddaa2804c"
+                  "253cf264c69180ec31814929b5de62088c0c5a45e8a816d1208fc5366bb8b041781a6771248550d04094c3d7a5"
+                  "04f9e8310679");
+    }
+    {
+        // No signatures were set for the second transaction.
+        auto outputData = WRAPD(TWDataVectorGet(outputs.get(), 1));
+        Binance::Proto::SigningOutput output;
+        ASSERT_TRUE(output.ParseFromArray(TWDataBytes(outputData.get()), (int)TWDataSize(outputData.get())));
+        EXPECT_TRUE(output.encoded().empty());
+        EXPECT_NE(output.error(), Common::Proto::OK);
+    }
+}
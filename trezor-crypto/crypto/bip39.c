@@ -148,21 +148,17 @@ int mnemonic_to_bits(const char *mnemonic, uint8_t *bits) {
     if (mnemonic[i] != 0) {
       i++;
     }
-    k = 0;
-    for (;;) {
-      if (!wordlist[k]) {  // word not found
-        return 0;
-      }
-      if (strcmp(current_word, wordlist[k]) == 0) {  // word found on index k
-        for (ki = 0; ki < 11; ki++) {
-          if (k & (1 << (10 - ki))) {
-            result[bi / 8] |= 1 << (7 - (bi % 8));
-          }
-          bi++;
-        }
-        break;
+    // [wallet-core] binary search instead of a linear scan of the wordlist
+    int index = mnemonic_find_word(current_word);
+    if (index < 0) {  // word not found
+      return 0;
+    }
+    k = (uint32_t)index;
+    for (ki = 0; ki < 11; ki++) {
+      if (k & (1 << (10 - ki))) {
+        result[bi / 8] |= 1 << (7 - (bi % 8));
       }
-      k++;
+      bi++;
     }
   }
   if (bi != n * 11) {
@@ -21,39 +21,166 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <TrezorCrypto/rand.h>
 
+#include <TrezorCrypto/chacha_drbg.h>
+#include <TrezorCrypto/memzero.h>
+
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <sys/random.h>
+#endif
+
 // [wallet-core]
-uint32_t __attribute__((weak)) random32(void) {
-    int randomData = open("/dev/urandom", O_RDONLY);
-    if (randomData < 0) {
-        abort();  // Critical: cannot proceed without random source
+// Random bytes are drawn from a ChaCha20 DRBG (see chacha_drbg.h) per thread,
+// seeded from the operating system, instead of reading /dev/urandom on every
+// call. Output is generated in blocks of RANDOM_BLOCK_SIZE bytes, and bytes
+// are wiped from the block as they are handed out. The DRBG is reseeded every
+// RANDOM_RESEED_INTERVAL blocks, and after fork() in the child, which must
+// not repeat the output of its parent.
+
+#define RANDOM_BLOCK_SIZE 256
+#define RANDOM_RESEED_INTERVAL 1024
+// Requests at least this long are generated directly into the output, in
+// chunks of at most RANDOM_MAX_CHUNK bytes (chacha_drbg_generate supports
+// less than 65536).
+#define RANDOM_MAX_CHUNK 4096
+#define RANDOM_SEED_LENGTH CHACHA_DRBG_OPTIMAL_RESEED_LENGTH(1)
+
+typedef struct {
+  CHACHA_DRBG_CTX drbg;
+  uint8_t block[RANDOM_BLOCK_SIZE];
+  // Number of unused bytes at the end of block.
+  size_t available;
+  int seeded;
+} random_state;
+
+static _Thread_local random_state state;
+static pthread_once_t random_once = PTHREAD_ONCE_INIT;
+static pthread_key_t random_key;
+
+// Reads entropy from the operating system, aborting if it is not available.
+static void random_entropy(uint8_t *buf, size_t len) {
+#if defined(__linux__)
+  while (len > 0) {
+    long result = syscall(SYS_getrandom, buf, len, 0);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      break;  // e.g. ENOSYS on kernels older than 3.17
+    }
+    buf += result;
+    len -= (size_t)result;
+  }
+#elif defined(__APPLE__)
+  while (len > 0) {
+    size_t chunk = len < 256 ? len : 256;
+    if (getentropy(buf, chunk) != 0) {
+      abort();  // Critical: cannot proceed without random source
     }
+    buf += chunk;
+    len -= chunk;
+  }
+#endif
+  if (len == 0) {
+    return;
+  }
 
-    uint32_t result;
-    ssize_t readLen = read(randomData, &result, sizeof(result));
-    close(randomData);
-    if (readLen != sizeof(result)) {
-        abort();  // Critical: failed to read random data
+  int randomData = open("/dev/urandom", O_RDONLY);
+  if (randomData < 0) {
+    abort();  // Critical: cannot proceed without random source
+  }
+  while (len > 0) {
+    ssize_t readLen = read(randomData, buf, len);
+    if (readLen < 0 && errno == EINTR) {
+      continue;
+    }
+    if (readLen <= 0) {
+      abort();  // Critical: failed to read random data
     }
+    buf += readLen;
+    len -= (size_t)readLen;
+  }
+  close(randomData);
+}
 
-    return result;
+// The child of fork() runs on a copy of the calling thread's state: drop it.
+static void random_after_fork(void) { memzero(&state, sizeof(state)); }
+
+static void random_thread_exit(void *value) {
+  memzero(value, sizeof(random_state));
+}
+
+static void random_init_once(void) {
+  if (pthread_atfork(NULL, NULL, random_after_fork) != 0 ||
+      pthread_key_create(&random_key, random_thread_exit) != 0) {
+    abort();
+  }
+}
+
+static void random_seed(void) {
+  uint8_t seed[RANDOM_SEED_LENGTH];
+  random_entropy(seed, sizeof(seed));
+  if (!state.seeded) {
+    pthread_once(&random_once, random_init_once);
+    // Wipes the state when the thread exits.
+    pthread_setspecific(random_key, &state);
+    chacha_drbg_init(&state.drbg, seed, sizeof(seed), NULL, 0);
+    state.seeded = 1;
+  } else {
+    chacha_drbg_reseed(&state.drbg, seed, sizeof(seed), NULL, 0);
+  }
+  memzero(seed, sizeof(seed));
+}
+
+static void random_generate(uint8_t *buf, size_t len) {
+  if (!state.seeded || state.drbg.reseed_counter > RANDOM_RESEED_INTERVAL) {
+    random_seed();
+  }
+  chacha_drbg_generate(&state.drbg, buf, len);
+}
+
+uint32_t __attribute__((weak)) random32(void) {
+  uint32_t result;
+  random_buffer((uint8_t *)&result, sizeof(result));
+  return result;
 }
 
 void __attribute__((weak)) random_buffer(uint8_t *buf, size_t len) {
-    int randomData = open("/dev/urandom", O_RDONLY);
-    if (randomData < 0) {
-        abort();  // Critical: cannot proceed without random source
-    }
-    ssize_t readLen = read(randomData, buf, len);
-    close(randomData);
-    if (readLen != (ssize_t)len) {
-        abort();  // Critical: failed to read random data
+  while (len > 0) {
+    if (state.available == 0) {
+      if (len >= RANDOM_BLOCK_SIZE) {
+        size_t chunk = len < RANDOM_MAX_CHUNK ? len : RANDOM_MAX_CHUNK;
+        random_generate(buf, chunk);
+        buf += chunk;
+        len -= chunk;
+        continue;
+      }
+      random_generate(state.block, sizeof(state.block));
+      state.available = sizeof(state.block);
     }
+
+    uint8_t *block = state.block + sizeof(state.block) - state.available;
+    size_t chunk = len < state.available ? len : state.available;
+    memcpy(buf, block, chunk);
+    memzero(block, chunk);
+    state.available -= chunk;
+    buf += chunk;
+    len -= chunk;
+  }
 }
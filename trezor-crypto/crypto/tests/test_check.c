@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <TrezorCrypto/check_mem.h>
 
@@ -5009,6 +5011,45 @@ START_TEST(test_chacha_drbg) {
 }
 END_TEST
 
+START_TEST(test_random_buffer) {
+  uint8_t null_bytes[5000] = {0};
+  uint8_t first[5000], second[5000];
+
+  // Sizes served from the block, across blocks, and generated directly.
+  size_t sizes[] = {1, 31, 255, 256, 300, 5000};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    memset(first, 0, sizeof(first));
+    memset(second, 0, sizeof(second));
+    random_buffer(first, sizes[i]);
+    random_buffer(second, sizes[i]);
+    ck_assert_mem_eq(first + sizes[i], null_bytes, sizeof(first) - sizes[i]);
+    if (sizes[i] >= 16) {
+      ck_assert_int_ne(memcmp(first, null_bytes, sizes[i]), 0);
+      ck_assert_int_ne(memcmp(first, second, sizes[i]), 0);
+    }
+  }
+  ck_assert_uint_ne(random32() | ((uint64_t)random32() << 32), 0);
+
+  // The child of fork() must not repeat the output of its parent.
+  int fds[2];
+  ck_assert_int_eq(pipe(fds), 0);
+  pid_t pid = fork();
+  ck_assert_int_ge(pid, 0);
+  if (pid == 0) {
+    random_buffer(first, 32);
+    _exit(write(fds[1], first, 32) == 32 ? 0 : 1);
+  }
+  random_buffer(second, 32);
+  ck_assert_int_eq(read(fds[0], first, 32), 32);
+  int status = 0;
+  ck_assert_int_eq(waitpid(pid, &status, 0), pid);
+  ck_assert_int_eq(status, 0);
+  ck_assert_int_ne(memcmp(first, second, 32), 0);
+  close(fds[0]);
+  close(fds[1]);
+}
+END_TEST
+
 START_TEST(test_pbkdf2_hmac_sha256) {
   uint8_t k[64];
 
@@ -9218,6 +9259,7 @@ Suite *test_suite(void) {
 
   tc = tcase_create("chacha_drbg");
   tcase_add_test(tc, test_chacha_drbg);
+  tcase_add_test(tc, test_random_buffer);
   suite_add_tcase(s, tc);
 
   tc = tcase_create("pbkdf2");
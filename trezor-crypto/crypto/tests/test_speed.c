@@ -9,6 +9,7 @@
 #include <TrezorCrypto/ed25519.h"
 #include "hasher.h"
 #include "nist256p1.h"
+#include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/secp256k1.h>
 
 static uint8_t msg[256];
@@ -197,6 +198,20 @@ void bench_ckd_optimized(int iterations) {
   }
 }
 
+void bench_random_buffer_32(int iterations) {
+  uint8_t buf[32];
+  for (int i = 0; i < iterations; i++) {
+    random_buffer(buf, sizeof(buf));
+  }
+}
+
+void bench_random_buffer_4096(int iterations) {
+  uint8_t buf[4096];
+  for (int i = 0; i < iterations; i++) {
+    random_buffer(buf, sizeof(buf));
+  }
+}
+
 void bench(void (*func)(int), const char *name, int iterations) {
   clock_t t = clock();
   func(iterations);
@@ -227,5 +242,8 @@ int main(void) {
   BENCH(bench_ckd_normal, 1000);
   BENCH(bench_ckd_optimized, 1000);
 
+  BENCH(bench_random_buffer_32, 1000000);
+  BENCH(bench_random_buffer_4096, 10000);
+
   return 0;
 }
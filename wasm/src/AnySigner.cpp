@@ -8,6 +8,7 @@
 
 #include "WasmData.h"
 #include "Coin.h"
+#include "WorkerPool.h"
 
 using namespace emscripten;
 
@@ -30,13 +31,84 @@ class AnySigner {
         TW::anyCoinPlan(coin, TW::data(string), out);
         return DataToVal(out);
     }
+
+    /// Signs an array of inputs on the worker pool (with TW_WASM_THREADS, sequentially otherwise);
+    /// an input that fails to sign gets an empty output.
+    static auto signBatch(const val& inputs, TWCoinType coin) {
+        const auto count = inputs["length"].as<std::size_t>();
+        std::vector<Data> datas;
+        datas.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            datas.push_back(convertJSArrayToNumberVector<byte>(inputs[i]));
+        }
+        auto outputs = val::array();
+        for (const auto& output : TW::anyCoinSignBatch({coin}, datas)) {
+            outputs.call<void>("push", DataToVal(output));
+        }
+        return outputs;
+    }
+
+    static void setBatchConcurrency(std::size_t threads) {
+        TW::WorkerPool::setSharedConcurrency(threads);
+    }
+};
+
+/// Input and output regions kept in the module heap, to sign without marshalling messages on every call:
+/// the input is serialized straight into `input(size)`, and the output decoded straight from `output()`.
+/// Entries write the output into `out` in place (Rust entries copy it from the Rust heap, see `Rust::assignCByteArray`),
+/// so the regions only grow and are allocated once for a given message size.
+/// Views are invalidated by the next call on the same buffer.
+class AnySignerBuffer {
+  public:
+    explicit AnySignerBuffer(std::size_t capacity) {
+        in.reserve(capacity);
+        out.reserve(capacity);
+    }
+
+    /// Returns a view of `size` bytes in the heap, to be filled with the input.
+    auto input(std::size_t size) {
+        in.resize(size);
+        return val(typed_memory_view(in.size(), in.data()));
+    }
+
+    /// Returns a view of the output of the last call in the heap.
+    auto output() const {
+        return val(typed_memory_view(out.size(), out.data()));
+    }
+
+    /// Signs the input, returning the size of the output.
+    auto sign(TWCoinType coin) {
+        out.clear();
+        TW::anyCoinSign(coin, in, out);
+        return out.size();
+    }
+
+    /// Plans the input, returning the size of the output.
+    auto plan(TWCoinType coin) {
+        out.clear();
+        TW::anyCoinPlan(coin, in, out);
+        return out.size();
+    }
+
+  private:
+    Data in;
+    Data out;
 };
 
 EMSCRIPTEN_BINDINGS(Wasm_TWAnySigner) {
     class_<AnySigner>("AnySigner")
         .class_function("sign", &AnySigner::sign)
         .class_function("plan", &AnySigner::plan)
-        .class_function("supportsJSON", &AnySigner::supportsJSON);
+        .class_function("supportsJSON", &AnySigner::supportsJSON)
+        .class_function("signBatch", &AnySigner::signBatch)
+        .class_function("setBatchConcurrency", &AnySigner::setBatchConcurrency);
+
+    class_<AnySignerBuffer>("AnySignerBuffer")
+        .constructor<std::size_t>()
+        .function("input", &AnySignerBuffer::input)
+        .function("output", &AnySignerBuffer::output)
+        .function("sign", &AnySignerBuffer::sign)
+        .function("plan", &AnySignerBuffer::plan);
 }
 
 } // namespace TW::Wasm
@@ -2,4 +2,14 @@ export class AnySigner {
     static sign(data: Uint8Array | Buffer, coin: CoinType): Uint8Array;
     static plan(data: Uint8Array | Buffer, coin: CoinType): Uint8Array;
     static supportsJSON(coin: CoinType): boolean;
+    static signBatch(inputs: (Uint8Array | Buffer)[], coin: CoinType): Uint8Array[];
+    static setBatchConcurrency(threads: number): void;
+}
+export class AnySignerBuffer {
+    constructor(capacity: number);
+    input(size: number): Uint8Array;
+    output(): Uint8Array;
+    sign(coin: CoinType): number;
+    plan(coin: CoinType): number;
+    delete(): void;
 }
@@ -96,6 +96,43 @@ describe("Ethereum", () => {
     );
   });
 
+  it("test signing in heap buffers and in batches", () => {
+    const { HexCoding, AnySigner, AnySignerBuffer, CoinType } = globalThis.core;
+    const encoded = TW.Ethereum.Proto.SigningInput.encode(TW.Ethereum.Proto.SigningInput.create({
+      toAddress: "0x3535353535353535353535353535353535353535",
+      chainId: Buffer.from("01", "hex"),
+      nonce: Buffer.from("09", "hex"),
+      gasPrice: Buffer.from("04a817c800", "hex"),
+      gasLimit: Buffer.from("5208", "hex"),
+      transaction: TW.Ethereum.Proto.Transaction.create({
+        transfer: TW.Ethereum.Proto.Transaction.Transfer.create({
+          amount: Buffer.from("0de0b6b3a7640000", "hex"),
+        }),
+      }),
+      privateKey: HexCoding.decode(
+        "4646464646464646464646464646464646464646464646464646464646464646"
+      ),
+    })).finish();
+    const expected = "0xf86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83";
+
+    // Smaller than the input, so the regions have to grow
+    const buffer = new AnySignerBuffer(16);
+    for (let i = 0; i < 2; i++) {
+      buffer.input(encoded.length).set(encoded);
+      const size = buffer.sign(CoinType.ethereum);
+      const output = TW.Ethereum.Proto.SigningOutput.decode(buffer.output());
+      assert.equal(buffer.output().length, size);
+      assert.equal(HexCoding.encode(output.encoded), expected);
+    }
+    buffer.delete();
+
+    const outputs = AnySigner.signBatch([encoded, encoded, encoded], CoinType.ethereum);
+    assert.equal(outputs.length, 3);
+    for (const output of outputs) {
+      assert.equal(HexCoding.encode(TW.Ethereum.Proto.SigningOutput.decode(output).encoded), expected);
+    }
+  });
+
   it("test signing personal message", () => {
     const { HexCoding, Hash, PrivateKey, Curve } = globalThis.core;
     const message = Buffer.from("Some data");
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+// Compares the ways of signing from Node, on Ethereum transactions carrying contract data of several sizes:
+// - AnySigner.sign, which copies the input into the heap and the output out of it on every call;
+// - AnySignerBuffer, which reuses input and output regions in the heap and decodes the output in place;
+// - AnySigner.signBatch, which signs on the worker pool of a TW_WASM_THREADS build.
+//
+// Run with `npm run bench` after `npm run build`.
+
+import { Buffer } from "buffer";
+import { initWasm, TW } from "../../dist";
+
+const payloadSizes = [1024, 64 * 1024, 1024 * 1024];
+const batchSize = 64;
+const minDurationMs = 2000;
+
+function signingInput(payloadSize: number, nonce: number): Uint8Array {
+  const payload = new Uint8Array(payloadSize);
+  for (let i = 0; i < payloadSize; i++) {
+    payload[i] = i & 0xff;
+  }
+  return TW.Ethereum.Proto.SigningInput.encode(TW.Ethereum.Proto.SigningInput.create({
+    toAddress: "0x3535353535353535353535353535353535353535",
+    chainId: Buffer.from("01", "hex"),
+    nonce: Buffer.from([nonce]),
+    gasPrice: Buffer.from("04a817c800", "hex"),
+    gasLimit: Buffer.from("5208", "hex"),
+    transaction: TW.Ethereum.Proto.Transaction.create({
+      contractGeneric: TW.Ethereum.Proto.Transaction.ContractGeneric.create({
+        amount: Buffer.from("00", "hex"),
+        data: payload,
+      }),
+    }),
+    privateKey: Buffer.from("4646464646464646464646464646464646464646464646464646464646464646", "hex"),
+  })).finish();
+}
+
+/// Runs `fn`, which signs `count` transactions, until `minDurationMs` elapsed; returns the transactions per second.
+function measure(count: number, fn: () => void): number {
+  fn(); // warm up
+  let signed = 0;
+  const start = process.hrtime.bigint();
+  let elapsedMs = 0;
+  while (elapsedMs < minDurationMs) {
+    fn();
+    signed += count;
+    elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+  }
+  return (signed * 1000) / elapsedMs;
+}
+
+async function main() {
+  const core = await initWasm();
+  const { AnySigner, AnySignerBuffer, CoinType } = core;
+
+  for (const payloadSize of payloadSizes) {
+    const input = signingInput(payloadSize, 9);
+    const inputs = Array.from({ length: batchSize }, (_, i) => signingInput(payloadSize, i));
+
+    const sign = measure(1, () => {
+      TW.Ethereum.Proto.SigningOutput.decode(AnySigner.sign(input, CoinType.ethereum));
+    });
+
+    const buffer = new AnySignerBuffer(input.length);
+    const signBuffer = measure(1, () => {
+      buffer.input(input.length).set(input);
+      buffer.sign(CoinType.ethereum);
+      TW.Ethereum.Proto.SigningOutput.decode(buffer.output());
+    });
+    buffer.delete();
+
+    const signLoop = measure(batchSize, () => {
+      for (const item of inputs) {
+        TW.Ethereum.Proto.SigningOutput.decode(AnySigner.sign(item, CoinType.ethereum));
+      }
+    });
+    const signBatch = measure(batchSize, () => {
+      for (const output of AnySigner.signBatch(inputs, CoinType.ethereum)) {
+        TW.Ethereum.Proto.SigningOutput.decode(output);
+      }
+    });
+
+    console.log(`payload ${payloadSize} bytes, tx/s:`);
+    console.log(`  AnySigner.sign       ${sign.toFixed(1)}`);
+    console.log(`  AnySignerBuffer      ${signBuffer.toFixed(1)}`);
+    console.log(`  sign x${batchSize}          ${signLoop.toFixed(1)}`);
+    console.log(`  signBatch x${batchSize}     ${signBatch.toFixed(1)}`);
+  }
+}
+
+main().then(() => process.exit(0), (error) => {
+  console.error(error);
+  process.exit(1);
+});